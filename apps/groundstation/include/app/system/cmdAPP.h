@@ -14,6 +14,7 @@
 
 #include "suchai/repoCommand.h"
 #include "suchai/repoData.h"
+#include "app/system/sysMetrics.h"
 
 /**
  * Register on board computer related (OBC) commands
@@ -40,4 +41,15 @@ int obc_get_sensors(char *fmt, char *params, int nparams);
  */
 int obc_update_status(char *fmt, char *params, int nparams);
 
+/**
+ * Sample the Linux host metrics (CPU load, memory, disk, temperature and
+ * per-thread CPU usage) and save them in the host_sensors payload.
+ *
+ * @param fmt Str. Parameters format ""
+ * @param params Str. Parameters as string ""
+ * @param nparams Int. Number of parameters 0
+ * @return  CMD_OK if executed correctly, CMD_ERROR in case of failures, or CMD_ERROR_SYNTAX in case of parameters errors
+ */
+int obc_get_host(char *fmt, char *params, int nparams);
+
 #endif /* CMD_APP_H */
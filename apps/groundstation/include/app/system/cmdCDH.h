@@ -12,16 +12,28 @@
 
 #define TM_TYPE_STRING 104
 #define TM_TYPE_PAYLOAD_STA 13
+#define TM_TYPE_PAYLOAD_DELTA 105
+#define TM_TYPE_BEACON_PACKED 106
+#define TM_TYPE_MSG_PACKED 107
+#define TM_TYPE_SCHEMA 108
+#define TM_SCHEMA_VERSION 1        ///< TM_TYPE_SCHEMA frame version
+#define TM_SCHEMA_LEN 13           ///< TM_TYPE_SCHEMA frame length in bytes
 
 #define SCH_TRX_PORT_CDH (SCH_TRX_PORT_APP+0)
 #define SCH_TRX_PORT_BCN (SCH_TRX_PORT_APP+3)
 
+#include <stdlib.h>
+
 #include "app/system/config.h"
 #include "config.h"
 #include "suchai/globals.h"
 #include "suchai/log_utils.h"
 
 #include "suchai/repoCommand.h"
+#include "app/system/linkStats.h"
+#include "app/system/tmDelta.h"
+#include "app/system/beaconPack.h"
+#include "app/system/msgPack.h"
 
 /**
  * Register command and data handling (C&DH) commands
@@ -68,7 +80,32 @@ int tm_send_msg(char *fmt, char *params, int nparams);
 int tm_parse_msg(char *fmt, char *params, int nparams);
 
 /**
- * Sends a status basic struct
+ * Parses a frame of packed messages (TM_TYPE_MSG_PACKED, see msgPack.h) and
+ * stores each message with its satellite record id as index. The frame
+ * samples field is set by the communications hook to the ground messages
+ * payload of the sending app.
+ * @param fmt ""
+ * @param params <>
+ * @param nparams 0
+ * @return CMD_OK if executed correctly
+ */
+int tm_parse_msgs(char *fmt, char *params, int nparams);
+
+/**
+ * Parses a TM_TYPE_SCHEMA frame and checks that the satellite payloads
+ * layout matches the ground schema, see repoDataSchema.h. The first payload
+ * field is set by the communications hook to the first ground payload of the
+ * satellite.
+ * @param fmt ""
+ * @param params com_frame_t *frame
+ * @param nparams 0
+ * @return CMD_OK if the schemas are compatible, CMD_ERROR otherwise
+ */
+int tm_parse_schema(char *fmt, char *params, int nparams);
+
+/**
+ * Sends a status basic struct as a bit-packed beacon (TM_TYPE_BEACON_PACKED)
+ * @see beaconPack.h
  * @param fmt "%d"
  * @param params <node>
  * @param nparams 1
@@ -77,7 +114,8 @@ int tm_parse_msg(char *fmt, char *params, int nparams);
 int tm_send_beacon(char *fmt, char *params, int nparams);
 
 /**
- * Parses a status basic struct
+ * Parses a status basic struct, either bit-packed (TM_TYPE_BEACON_PACKED) or
+ * as a full struct (TM_TYPE_PAYLOAD_STA)
  * @param fmt ""
  * @param params <>
  * @param nparams 0
@@ -94,4 +132,37 @@ int tm_parse_beacon(char *fmt, char *params, int nparams);
  * @return CMD_OK if executed correctly, CMD_ERROR in case of failures, or CMD_ERROR_SYNTAX in case of parameters errors.
  */
 int tle_send_to_node(char *fmt, char *params, int nparams);
+
+/**
+ * Parse a delta compressed payload frame (TM_TYPE_PAYLOAD_DELTA) and save
+ * the decoded samples. The frame payload id must be already mapped to the
+ * ground payload id.
+ * @see tmDelta.h
+ * @param fmt ""
+ * @param params <com_frame_t>
+ * @param nparams 0
+ * @return CMD_OK if executed correctly, CMD_ERROR in case of failures, or CMD_SYNTAX_ERROR in case of parameters errors
+ */
+int tm_parse_pay_delta(char *fmt, char *params, int nparams);
+
+/**
+ * Print link quality statistics for each telemetry type received from <node>:
+ * received, lost, reordered and duplicated frames (from the nframe sequence),
+ * and the frames/s, bytes/s, loss percentage and inter-arrival jitter of the
+ * last rolling window.
+ * @param fmt "%d"
+ * @param params <node> Use -1 to print all nodes
+ * @param nparams 1
+ * @return CMD_OK if executed correctly, or CMD_SYNTAX_ERROR in case of parameters errors
+ */
+int tm_link_stats(char *fmt, char *params, int nparams);
+
+/**
+ * Clear link quality statistics of <node>
+ * @param fmt "%d"
+ * @param params <node> Use -1 to clear all nodes
+ * @param nparams 1
+ * @return CMD_OK if executed correctly, or CMD_SYNTAX_ERROR in case of parameters errors
+ */
+int tm_link_reset(char *fmt, char *params, int nparams);
 #endif //_CMDCDH_H
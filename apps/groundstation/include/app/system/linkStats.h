@@ -0,0 +1,94 @@
+/**
+ * @file  linkStats.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the ground station link quality tracker.
+ * Each received telemetry frame is accounted by (node, type) so frame
+ * sequence gaps (lost frames), late frames (reordered) and duplicates are
+ * detected from the com_frame_t.nframe field. Rolling frame and byte rates,
+ * loss percentage and inter-arrival jitter are also computed.
+ *
+ * @note nframe is the frame index inside a com_send_telemetry burst, so a
+ * frame with nframe = 0 always starts a new sequence, as does a non increasing
+ * nframe after LINK_STATS_BURST_GAP_MS of silence. Frames lost at the end of a
+ * burst can not be detected.
+ */
+
+#ifndef _LINK_STATS_H
+#define _LINK_STATS_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "suchai/config.h"
+#include "suchai/osSemaphore.h"
+#include "suchai/osThread.h"
+#include "suchai/log_utils.h"
+
+#define LINK_STATS_MAX_ENTRIES 32     ///< Max. number of (node, type) pairs tracked
+#define LINK_STATS_WINDOW_MS 10000    ///< Rolling statistics window in milliseconds
+#define LINK_STATS_SEQ_WINDOW 32      ///< Frames remembered to detect reordering and duplicates
+#define LINK_STATS_EWMA_SHIFT 4       ///< Jitter filter gain 1/16 (as RFC 3550)
+#define LINK_STATS_BURST_GAP_MS 5000  ///< Silence after which a non increasing nframe starts a new burst
+
+/**
+ * Link statistics of one (node, type) pair
+ */
+typedef struct link_stats {
+    uint8_t node;                 ///< Satellite CSP node
+    uint8_t type;                 ///< Telemetry type (as received)
+    uint8_t in_use;               ///< Entry is valid
+    uint16_t highest;             ///< Highest nframe received in current burst
+    uint32_t seen_mask;           ///< Bit i set if frame (highest - i) was received
+    uint32_t bursts;              ///< Number of sequences started (nframe = 0)
+    uint32_t received;            ///< Total frames received
+    uint32_t lost;                ///< Total frames missing (gaps not yet recovered)
+    uint32_t reordered;           ///< Total frames received late (out of order)
+    uint32_t duplicated;          ///< Total frames received twice
+    uint32_t bytes;               ///< Total bytes received
+    portTick first_tick;          ///< First frame arrival time
+    portTick last_tick;           ///< Last frame arrival time
+    int32_t mean_ia_ms;           ///< Mean inter-arrival time in ms (EWMA)
+    int32_t jitter_ms;            ///< Inter-arrival jitter in ms (EWMA of abs. deviation)
+    portTick win_start;           ///< Current rolling window start time
+    uint32_t win_frames;          ///< Frames in current rolling window
+    uint32_t win_bytes;           ///< Bytes in current rolling window
+    uint32_t win_lost;            ///< Lost frames in current rolling window
+    float frames_s;               ///< Frames per second in the last window
+    float bytes_s;                ///< Bytes per second in the last window
+    float loss_pct;               ///< Loss percentage in the last window
+} link_stats_t;
+
+/**
+ * Initialize the link statistics table and its mutex
+ * @return 0 if OK, -1 in case of errors
+ */
+int link_stats_init(void);
+
+/**
+ * Account a received telemetry frame. Call this function with nframe already
+ * in host byte order.
+ *
+ * @param node Satellite CSP node
+ * @param type Telemetry frame type
+ * @param nframe Frame number
+ * @param nbytes Number of bytes received
+ */
+void link_stats_update(uint8_t node, uint8_t type, uint16_t nframe, int nbytes);
+
+/**
+ * Print the link statistics of a given node
+ * @param node Satellite CSP node, or -1 to print all nodes
+ * @return Number of entries printed
+ */
+int link_stats_print(int node);
+
+/**
+ * Clear the link statistics of a given node
+ * @param node Satellite CSP node, or -1 to clear all nodes
+ */
+void link_stats_reset(int node);
+
+#endif //_LINK_STATS_H
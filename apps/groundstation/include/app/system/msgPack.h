@@ -0,0 +1,126 @@
+/**
+ * @file  msgPack.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the packed messages frame encoding
+ * (TM_TYPE_MSG_PACKED). A frame carries as many whole variable length
+ * messages as fit, each one with its record id and timestamp. Multi-byte
+ * values are big endian, so the frame is byte order independent.
+ *
+ * Frame layout:
+ * @code
+ * | version | count | id (4) | timestamp (4) | len | msg (len bytes) | id (4) | ...
+ * @endcode
+ *
+ * Version 2 frames have an extra header byte with the dictionary id and the
+ * messages are compressed with dictComp.h, using the previous messages of the
+ * same frame as history, so len is the compressed length:
+ * @code
+ * | version | count | dict id | id (4) | timestamp (4) | len | compressed msg (len bytes) | ...
+ * @endcode
+ */
+
+#ifndef _MSG_PACK_H
+#define _MSG_PACK_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "app/system/dictComp.h"
+
+#define MSG_PACK_VERSION 1          ///< Encoding version
+#define MSG_PACK_VERSION_DICT 2     ///< Dictionary compressed encoding version
+#define MSG_PACK_HEADER_LEN 2       ///< Frame header length in bytes
+#define MSG_PACK_HEADER_LEN_DICT 3  ///< Dictionary compressed frame header length in bytes
+#define MSG_PACK_RECORD_LEN 9       ///< Message header length in bytes
+#define MSG_PACK_MAX_MSG 255        ///< Max. message length in bytes
+
+/**
+ * Start a packed messages frame
+ * @param buff Frame buffer
+ * @param len Frame buffer length in bytes
+ * @return Used bytes, or -1 if the buffer is too small
+ */
+int msg_pack_init(uint8_t *buff, int len);
+
+/**
+ * Add a message to a frame if it fits
+ * @param buff Frame buffer, started with msg_pack_init
+ * @param len Frame buffer length in bytes
+ * @param used Used bytes, as returned by the previous call
+ * @param id Message record id
+ * @param timestamp Message timestamp
+ * @param msg Message bytes
+ * @param msg_len Message length in bytes [0, MSG_PACK_MAX_MSG]
+ * @return Used bytes, or -1 if the message does not fit
+ */
+int msg_pack_add(uint8_t *buff, int len, int used, uint32_t id, uint32_t timestamp, const uint8_t *msg, int msg_len);
+
+/**
+ * Start a dictionary compressed messages frame
+ * @param buff Frame buffer
+ * @param len Frame buffer length in bytes
+ * @return Used bytes, or -1 if the buffer is too small
+ */
+int msg_pack_init_dict(uint8_t *buff, int len);
+
+/**
+ * Compress and add a message to a dictionary compressed frame if it fits.
+ * The previous messages of the frame must be stored one after the other in
+ * text, followed by the new message.
+ * @param buff Frame buffer, started with msg_pack_init_dict
+ * @param len Frame buffer length in bytes
+ * @param used Used bytes, as returned by the previous call
+ * @param id Message record id
+ * @param timestamp Message timestamp
+ * @param text Frame messages buffer
+ * @param hist Length of the previous messages in text, the new message
+ * starts at text + hist
+ * @param msg_len Message length in bytes
+ * @return Used bytes, or -1 if the compressed message does not fit
+ */
+int msg_pack_add_dict(uint8_t *buff, int len, int used, uint32_t id, uint32_t timestamp, const uint8_t *text, int hist, int msg_len);
+
+/**
+ * Get the number of messages in a frame
+ * @param buff Frame buffer
+ * @param len Frame length in bytes
+ * @return Number of messages, or -1 if the frame is not valid
+ */
+int msg_unpack_count(uint8_t *buff, int len);
+
+/**
+ * Read the next message of a version 1 frame. Call it msg_unpack_count
+ * times, frames can be padded.
+ * @param buff Frame buffer
+ * @param len Frame length in bytes
+ * @param pos Read position, set to 0 to start. Updated to the next message.
+ * @param id Message record id
+ * @param timestamp Message timestamp
+ * @param msg Output buffer, the message is NULL terminated
+ * @param max Output buffer length in bytes
+ * @return Message length, or -1 if the frame is not valid
+ */
+int msg_unpack_next(uint8_t *buff, int len, int *pos, uint32_t *id, uint32_t *timestamp, uint8_t *msg, int max);
+
+/**
+ * Read the next message of a frame of any version. Call it msg_unpack_count
+ * times, frames can be padded. Messages are written one after the other in
+ * text, because compressed messages need the previous ones.
+ * @param buff Frame buffer
+ * @param len Frame length in bytes
+ * @param pos Read position, set to 0 to start. Updated to the next message.
+ * @param id Message record id
+ * @param timestamp Message timestamp
+ * @param text Output buffer for all the frame messages
+ * @param hist Length of the previous messages in text, set to 0 to start.
+ * Updated to the end of the message.
+ * @param max Output buffer length in bytes
+ * @return Message length, or -1 if the frame is not valid or the message does
+ * not fit in the output buffer
+ */
+int msg_unpack_next_text(uint8_t *buff, int len, int *pos, uint32_t *id, uint32_t *timestamp, uint8_t *text, int *hist, int max);
+
+#endif //_MSG_PACK_H
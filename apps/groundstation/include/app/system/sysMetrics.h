@@ -0,0 +1,66 @@
+/**
+ * @file  sysMetrics.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the Linux host metrics sampler. The sampler
+ * keeps the /sys and /proc files open and reads them with pread at offset 0,
+ * so each sample costs one syscall per file instead of open, read and close.
+ * It collects board temperature, CPU load, memory, disk and per-thread CPU
+ * usage of this process.
+ */
+
+#ifndef _SYS_METRICS_H
+#define _SYS_METRICS_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "suchai/config.h"
+#include "suchai/repoData.h"
+#include "suchai/log_utils.h"
+
+#ifdef LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/statvfs.h>
+#endif
+
+#define SYS_METRICS_THERMAL_FILE "/sys/class/thermal/thermal_zone0/temp"
+#define SYS_METRICS_DISK_PATH "."        ///< Partition to report (the one holding the database)
+#define SYS_METRICS_MAX_THREADS 32       ///< Max. number of threads tracked
+#define SYS_METRICS_TOP_THREADS 3        ///< Threads reported in host_data_t
+
+/**
+ * Open the metrics files. Called by the other functions if required.
+ * @return 0 if OK, -1 if a mandatory file could not be opened
+ */
+int sys_metrics_open(void);
+
+/**
+ * Close all the metrics files
+ */
+void sys_metrics_close(void);
+
+/**
+ * Read the board temperature
+ * @param temp Pointer to store the temperature in degrees Celsius
+ * @return 0 if OK, -1 in case of errors
+ */
+int sys_metrics_read_temp(float *temp);
+
+/**
+ * Take a host metrics sample. CPU usages are computed since the previous
+ * sample, so the first call reports them as zero. The index and timestamp
+ * fields are not modified.
+ * @param data Pointer to store the sample
+ * @return 0 if OK, -1 in case of errors
+ */
+int sys_metrics_sample(host_data_t *data);
+
+#endif //_SYS_METRICS_H
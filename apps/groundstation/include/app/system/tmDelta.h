@@ -0,0 +1,87 @@
+/**
+ * @file  tmDelta.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the delta compressed payload telemetry
+ * frame encoding. A frame stores a header and a list of samples of the same
+ * payload. The first sample is stored raw, each field with its own width in
+ * little endian. Each field of the next samples is stored as the difference
+ * with the previous sample, zig-zag encoded and written as a varint (7 bits
+ * per byte, little endian groups), so small differences use only one byte
+ * and the frame is byte order independent. The field layout is taken from
+ * the data_map types string (%u, %d, %f: 4 bytes, %h: 2 bytes). Floats are
+ * differentiated as their raw bits.
+ *
+ * Frame layout:
+ * @code
+ * | version | payload | nsamples | nfields | size (2 bytes) | len (2 bytes) | raw sample | varints ... |
+ * @endcode
+ * where size is the payload struct size and len the number of data bytes
+ * (raw sample and varints).
+ */
+
+#ifndef _TM_DELTA_H
+#define _TM_DELTA_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "suchai/config.h"
+#include "suchai/repoData.h"
+
+#define TM_DELTA_VERSION 2          ///< Encoding version
+#define TM_DELTA_HEADER_LEN 8       ///< Frame header length in bytes
+#define TM_DELTA_MAX_FIELDS 64      ///< Max. number of fields in a payload struct
+#define TM_DELTA_MAX_SAMPLES 255    ///< Max. number of samples in a frame
+
+/**
+ * Parse the field widths of a payload from its data_map types string.
+ *
+ * @param map Payload data map
+ * @param widths Array to store the width in bytes of each field
+ * @param max_fields Widths array length
+ * @return Number of fields, or -1 if the payload can not be delta encoded
+ * (string fields, unknown types or fields larger than the struct)
+ */
+int tm_delta_get_layout(data_map_t *map, uint8_t *widths, int max_fields);
+
+/**
+ * Encode as many samples as possible in a frame buffer.
+ *
+ * @param map Payload data map
+ * @param payload Payload id written in the frame header
+ * @param samples Array of nsamples packed payload structs
+ * @param nsamples Number of samples available
+ * @param frame Output frame buffer
+ * @param frame_len Output frame buffer length in bytes
+ * @param used Pointer to store the number of samples encoded
+ * @return Number of bytes written in frame, or -1 in case of errors
+ */
+int tm_delta_encode(data_map_t *map, int payload, uint8_t *samples, int nsamples,
+                    uint8_t *frame, int frame_len, int *used);
+
+/**
+ * Read the payload id and number of samples of an encoded frame
+ *
+ * @param frame Encoded frame
+ * @param payload Pointer to store the payload id
+ * @param nsamples Pointer to store the number of samples
+ * @return 0 if OK, -1 if the frame version is not supported
+ */
+int tm_delta_get_header(uint8_t *frame, int *payload, int *nsamples);
+
+/**
+ * Decode an encoded frame.
+ *
+ * @param map Payload data map
+ * @param frame Encoded frame
+ * @param frame_len Encoded frame length in bytes
+ * @param samples Output array of packed payload structs
+ * @param max_samples Output array length in number of samples
+ * @return Number of samples decoded, or -1 in case of errors
+ */
+int tm_delta_decode(data_map_t *map, uint8_t *frame, int frame_len, uint8_t *samples, int max_samples);
+
+#endif //_TM_DELTA_H
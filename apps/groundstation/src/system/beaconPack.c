@@ -0,0 +1,158 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/beaconPack.h"
+
+#define BCN_NFIELDS ((int)(sizeof(status_data_t)/sizeof(uint32_t)))
+
+/**
+ * Version 1 layout, in status_data_t field order. 428 bits, 55 bytes.
+ */
+static const bcn_field_t bcn_layout_v1[] = {
+        {16, BCN_FIELD_COUNTER},    // index
+        {32, BCN_FIELD_UNSIGNED},   // timestamp
+        {4, BCN_FIELD_UNSIGNED},    // dat_obc_opmode
+        {32, BCN_FIELD_UNSIGNED},   // dat_rtc_date_time
+        {8, BCN_FIELD_UNSIGNED},    // dat_obc_last_reset
+        {16, BCN_FIELD_COUNTER},    // dat_obc_hrs_alive
+        {16, BCN_FIELD_COUNTER},    // dat_obc_hrs_wo_reset
+        {16, BCN_FIELD_COUNTER},    // dat_obc_reset_counter
+        {16, BCN_FIELD_COUNTER},    // dat_obc_executed_cmds
+        {16, BCN_FIELD_COUNTER},    // dat_obc_failed_cmds
+        {16, BCN_FIELD_COUNTER},    // dat_com_count_tm
+        {16, BCN_FIELD_COUNTER},    // dat_com_count_tc
+        {32, BCN_FIELD_UNSIGNED},   // dat_com_last_tc
+        {32, BCN_FIELD_UNSIGNED},   // dat_fpl_last
+        {8, BCN_FIELD_UNSIGNED},    // dat_fpl_queue
+        {32, BCN_FIELD_UNSIGNED},   // dat_ads_tle_epoch
+        {16, BCN_FIELD_UNSIGNED},   // dat_eps_vbatt [mV]
+        {16, BCN_FIELD_UNSIGNED},   // dat_eps_cur_sun [mA]
+        {16, BCN_FIELD_UNSIGNED},   // dat_eps_cur_sys [mA]
+        {16, BCN_FIELD_SIGNED},     // dat_obc_temp_1
+        {16, BCN_FIELD_SIGNED},     // dat_eps_temp_bat0
+        {4, BCN_FIELD_UNSIGNED},    // dat_drp_mach_action
+        {4, BCN_FIELD_UNSIGNED},    // dat_drp_mach_state
+        {16, BCN_FIELD_UNSIGNED},   // dat_drp_mach_payloads
+        {16, BCN_FIELD_SIGNED},     // dat_drp_mach_step
+};
+
+/**
+ * Layouts by version, index 0 is version 1
+ */
+static const struct {
+    const bcn_field_t *fields;
+    int nfields;
+} bcn_layouts[] = {
+        {bcn_layout_v1, sizeof(bcn_layout_v1)/sizeof(bcn_layout_v1[0])},
+};
+
+#define BCN_NLAYOUTS ((int)(sizeof(bcn_layouts)/sizeof(bcn_layouts[0])))
+
+static uint32_t bcn_saturate(uint32_t value, const bcn_field_t *field)
+{
+    if(field->bits >= 32)
+        return value;
+
+    // Counters keep the low bits, so the ground can track them past the max
+    if(field->type == BCN_FIELD_COUNTER)
+        return value & ((1UL << field->bits) - 1);
+
+    if(field->type == BCN_FIELD_SIGNED)
+    {
+        int32_t v = (int32_t)value;
+        int32_t max = (int32_t)((1UL << (field->bits - 1)) - 1);
+        int32_t min = -max - 1;
+        v = v > max ? max : (v < min ? min : v);
+        return (uint32_t)v & ((1UL << field->bits) - 1);
+    }
+
+    uint32_t max = (uint32_t)((1UL << field->bits) - 1);
+    return value > max ? max : value;
+}
+
+static uint32_t bcn_extend(uint32_t value, const bcn_field_t *field)
+{
+    if(field->type == BCN_FIELD_SIGNED && field->bits < 32 && (value & (1UL << (field->bits - 1))))
+        value |= ~((uint32_t)((1UL << field->bits) - 1));
+    return value;
+}
+
+int bcn_pack_get_len(int version)
+{
+    if(version < 1 || version > BCN_NLAYOUTS)
+        return -1;
+
+    int i, bits = 0;
+    for(i = 0; i < bcn_layouts[version-1].nfields; i++)
+        bits += bcn_layouts[version-1].fields[i].bits;
+    return 1 + (bits + 7) / 8;
+}
+
+int bcn_pack(status_data_t *status, uint8_t *buff, int len)
+{
+    const bcn_field_t *fields = bcn_layouts[BCN_PACK_VERSION-1].fields;
+    int nfields = bcn_layouts[BCN_PACK_VERSION-1].nfields;
+    int size = bcn_pack_get_len(BCN_PACK_VERSION);
+    if(size > len || nfields > BCN_NFIELDS)
+        return -1;
+
+    uint32_t values[BCN_NFIELDS];
+    memcpy(values, status, sizeof(values));
+    memset(buff, 0, size);
+    buff[0] = BCN_PACK_VERSION;
+
+    int f, b;
+    int pos = 8;
+    for(f = 0; f < nfields; f++)
+    {
+        uint32_t v = bcn_saturate(values[f], &fields[f]);
+        for(b = fields[f].bits - 1; b >= 0; b--, pos++)
+        {
+            if((v >> b) & 1)
+                buff[pos >> 3] |= (uint8_t)(0x80 >> (pos & 7));
+        }
+    }
+    return size;
+}
+
+int bcn_unpack(uint8_t *buff, int len, status_data_t *status)
+{
+    int version = buff[0];
+    int size = bcn_pack_get_len(version);
+    if(size < 0 || size > len)
+        return -1;
+
+    const bcn_field_t *fields = bcn_layouts[version-1].fields;
+    int nfields = bcn_layouts[version-1].nfields;
+    uint32_t values[BCN_NFIELDS];
+    memset(values, 0, sizeof(values));
+
+    int f, b;
+    int pos = 8;
+    for(f = 0; f < nfields && f < BCN_NFIELDS; f++)
+    {
+        uint32_t v = 0;
+        for(b = 0; b < fields[f].bits; b++, pos++)
+            v = (v << 1) | ((buff[pos >> 3] >> (7 - (pos & 7))) & 1);
+        values[f] = bcn_extend(v, &fields[f]);
+    }
+
+    memcpy(status, values, sizeof(values));
+    return version;
+}
@@ -28,9 +28,14 @@ void cmd_cdh_init(void)
     cmd_add("obc_cancel_deploy", obc_cancel_deploy, "", 0);
     cmd_add("tm_send_msg", tm_send_msg, "%d %n",  2);
     cmd_add("tm_parse_msg", tm_parse_msg, "", 0);
+    cmd_add("tm_parse_msgs", tm_parse_msgs, "", 0);
+    cmd_add("tm_parse_schema", tm_parse_schema, "", 0);
     cmd_add("tm_send_beacon", tm_send_beacon, "%d", 1);
     cmd_add("tm_parse_beacon", tm_parse_beacon, "", 0);
     cmd_add("tle_send", tle_send_to_node, "%d %s", 2);
+    cmd_add("tm_parse_pay_delta", tm_parse_pay_delta, "", 0);
+    cmd_add("tm_link_stats", tm_link_stats, "%d", 1);
+    cmd_add("tm_link_reset", tm_link_reset, "%d", 1);
 
 }
 
@@ -119,6 +124,91 @@ int tm_parse_msg(char *fmt, char *params, int nparams) {
     return rc != -1 ? CMD_OK : CMD_ERROR;
 }
 
+int tm_parse_msgs(char *fmt, char *params, int nparams)
+{
+    if(params == NULL)
+        return CMD_SYNTAX_ERROR;
+
+    com_frame_t *frame = (com_frame_t *)params;
+    int len = sizeof(frame->data);
+    int n = msg_unpack_count(frame->data.data8, len);
+    if(n < 0)
+    {
+        LOGE(tag, "Invalid packed messages frame (version %d, dictionary %d)", frame->data.data8[0], frame->data.data8[2]);
+        return CMD_ERROR;
+    }
+
+    // Ground messages payload, set by the communications hook
+    int payload = (int)frame->ndata;
+    if(payload != msg_sensors_2 && payload != msg_sensors_3 && payload != msg_sensors_P)
+    {
+        LOGE(tag, "Invalid packed messages payload %d", payload);
+        return CMD_ERROR;
+    }
+
+    // Compressed messages reference the previous messages of the frame
+    uint8_t text[DICT_COMP_MAX_DIST];
+    int i, pos = 0, hist = 0, rc = 0;
+    for(i = 0; i < n; i++)
+    {
+        string_data_t message;
+        uint32_t id, timestamp;
+        int msg_len = msg_unpack_next_text(frame->data.data8, len, &pos, &id, &timestamp, text, &hist, sizeof(text));
+        if(msg_len < 0)
+        {
+            LOGE(tag, "Packed messages frame truncated at message %d of %d", i, n);
+            return CMD_ERROR;
+        }
+        memset(message.msg, 0, SCH_ST_STR_SIZE);
+        memcpy(message.msg, text + hist - msg_len, msg_len < SCH_ST_STR_SIZE ? msg_len : SCH_ST_STR_SIZE - 1);
+        // Index is the satellite record id
+        message.index = id;
+        message.timestamp = timestamp;
+        rc += dat_add_payload_sample(&message, payload);
+        LOGI(tag, "String message %u is %s", (unsigned int)message.index, message.msg);
+    }
+    return rc == 0 ? CMD_OK : CMD_ERROR;
+}
+
+int tm_parse_schema(char *fmt, char *params, int nparams)
+{
+    if(params == NULL)
+        return CMD_SYNTAX_ERROR;
+
+    com_frame_t *frame = (com_frame_t *)params;
+    uint8_t *data = frame->data.data8;
+    if(data[0] != TM_SCHEMA_VERSION)
+    {
+        LOGE(tag, "Invalid schema frame (version %d)", data[0]);
+        return CMD_ERROR;
+    }
+
+    int first = data[1];
+    int npayloads = data[2];
+    int nstatus = (data[3] << 8) | data[4];
+    uint32_t layout = ((uint32_t)data[5] << 24) | ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 8) | data[8];
+    uint32_t hash = ((uint32_t)data[9] << 24) | ((uint32_t)data[10] << 16) | ((uint32_t)data[11] << 8) | data[12];
+    LOGI(tag, "Node %d schema: %d payloads, %d status vars, layout 0x%08X, payloads 0x%08X", frame->node,
+         npayloads, nstatus, (unsigned int)layout, (unsigned int)hash);
+
+    if(npayloads != DAT_SCHEMA_NPAYLOADS || layout != dat_schema_layout_hash)
+    {
+        LOGE(tag, "Node %d schema layout mismatch. Ground: %d payloads, layout 0x%08X", frame->node,
+             DAT_SCHEMA_NPAYLOADS, (unsigned int)dat_schema_layout_hash);
+        return CMD_ERROR;
+    }
+    uint32_t ground_hash = dat_schema_hash(first, npayloads);
+    if(hash != ground_hash)
+    {
+        LOGE(tag, "Node %d payloads fields mismatch. Ground: 0x%08X (from payload %d)", frame->node,
+             (unsigned int)ground_hash, first);
+        return CMD_ERROR;
+    }
+
+    LOGI(tag, "Node %d schema OK", frame->node);
+    return CMD_OK;
+}
+
 int tm_send_beacon(char *fmt, char *params, int nparams)
 {
     int node;
@@ -128,9 +218,12 @@ int tm_send_beacon(char *fmt, char *params, int nparams)
     }
 
     status_data_t status;
+    uint8_t beacon[BCN_PACK_MAX_LEN];
     obc_read_status_basic(&status);
-    _hton32_buff((uint32_t *)&status, sizeof(status_data_t)/sizeof(uint32_t));
-    return com_send_telemetry(node, SCH_TRX_PORT_CDH, TM_TYPE_PAYLOAD_STA, &status, sizeof(status_data_t), 1, 0);
+    int len = bcn_pack(&status, beacon, sizeof(beacon));
+    if(len < 0)
+        return CMD_ERROR;
+    return com_send_telemetry(node, SCH_TRX_PORT_CDH, TM_TYPE_BEACON_PACKED, beacon, len, 1, 0);
 }
 
 int tm_parse_beacon(char *fmt, char *params, int nparams)
@@ -140,8 +233,21 @@ int tm_parse_beacon(char *fmt, char *params, int nparams)
 
     com_frame_t *frame = (com_frame_t *)params;
     status_data_t sta_data;
-    memcpy(&sta_data, frame->data.data8, sizeof(status_data_t));
-    _ntoh32_buff((uint32_t *)&sta_data, sizeof(status_data_t)/sizeof(uint32_t));
+    if(frame->type == TM_TYPE_BEACON_PACKED)
+    {
+        int version = bcn_unpack(frame->data.data8, sizeof(frame->data.data8), &sta_data);
+        if(version < 0)
+        {
+            LOGE(tag, "Beacon version %d not supported", frame->data.data8[0]);
+            return CMD_ERROR;
+        }
+        LOGI(tag, "Beacon version %d", version);
+    }
+    else
+    {
+        memcpy(&sta_data, frame->data.data8, sizeof(status_data_t));
+        _ntoh32_buff((uint32_t *)&sta_data, sizeof(status_data_t)/sizeof(uint32_t));
+    }
     dat_print_payload_struct(&sta_data, status_sensors_2); //TODO: Check payload id
 }
 
@@ -267,4 +373,62 @@ int tle_send_to_node(char *fmt, char *params, int nparams)
 
     LOGR(tag, "TLE sent ok!")
     return CMD_OK;
-}
\ No newline at end of file
+}
+
+int tm_parse_pay_delta(char *fmt, char *params, int nparams)
+{
+    if(params == NULL)
+        return CMD_SYNTAX_ERROR;
+
+    com_frame_t *frame = (com_frame_t *)params;
+    int payload, nsamples;
+    if(tm_delta_get_header(frame->data.data8, &payload, &nsamples) != 0 || payload >= last_sensor)
+    {
+        LOGE(tag, "Invalid delta frame (version %d, payload %d)", frame->data.data8[0], frame->data.data8[1]);
+        return CMD_ERROR;
+    }
+
+    data_map_t *map = &data_map[payload];
+    uint8_t *samples = (uint8_t *)malloc(nsamples * map->size);
+    if(samples == NULL)
+        return CMD_ERROR;
+
+    int n = tm_delta_decode(map, frame->data.data8, sizeof(frame->data), samples, nsamples);
+    if(n < 0)
+    {
+        LOGE(tag, "Delta frame does not match payload %d (%s) layout", payload, map->table);
+        free(samples);
+        return CMD_ERROR;
+    }
+
+    int i, rc = 0;
+    for(i = 0; i < n && rc != -1; i++)
+        rc = dat_add_payload_sample(samples + i * map->size, payload);
+    free(samples);
+
+    LOGI(tag, "Saved %d/%d delta samples of payload %d (%s)", i, nsamples, payload, map->table);
+    return rc != -1 && n == nsamples ? CMD_OK : CMD_ERROR;
+}
+
+int tm_link_stats(char *fmt, char *params, int nparams)
+{
+    int node;
+    if(params == NULL || sscanf(params, fmt, &node) != nparams)
+        return CMD_SYNTAX_ERROR;
+
+    int n = link_stats_print(node);
+    if(n == 0)
+        LOGW(tag, "No frames received from node %d", node);
+    return CMD_OK;
+}
+
+int tm_link_reset(char *fmt, char *params, int nparams)
+{
+    int node;
+    if(params == NULL || sscanf(params, fmt, &node) != nparams)
+        return CMD_SYNTAX_ERROR;
+
+    link_stats_reset(node);
+    LOGR(tag, "Link stats cleared for node %d", node);
+    return CMD_OK;
+}
@@ -0,0 +1,281 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/dictComp.h"
+
+/**
+ * Static dictionary (DICT_COMP_ID 1). Common substrings of recorded string
+ * messages, IoT frames, AIS (NMEA AIVDM) sentences and ADS-B (SBS and raw
+ * Mode S) messages, less frequent first. Must be shorter than
+ * DICT_COMP_MAX_DIST and identical in the flight and ground software, change
+ * DICT_COMP_ID if it is modified.
+ */
+static const char dict_comp_dict[] =
+        "0000000000000000" "FFFFFFFFFFFFFFFF" "0123456789ABCDEF" "0123456789abcdef"
+        "MSG,1,1,1," "MSG,4,1,1," "MSG,5,1,1," "MSG,8,1,1," "MSG,3,1,1,"
+        ",,,,,,,,,," ",0,0,0,0" ",-1,0,0,0" ",,,,0,0,0,0" ",,,,,,,,0,,0,0"
+        "*8D" "*8DA" "*8D4" "*8D7" "*8DC" "*5D" "*02" "*20" "*28" "*A0" "*A8" ";\n"
+        "!AIVDM,2,1," "!AIVDM,2,2," ",2*" ",4*" "!AIVDO,1,1,,A," "!AIVDM,1,1,,B," "!AIVDM,1,1,,A,"
+        ",0*" ",0*1" ",0*2" ",0*3" ",0*4" ",0*5" ",0*6" ",0*7"
+        "GPGGA," "GPRMC," ",A," ",V," ",N," ",S," ",E," ",W," ",M," ",K*"
+        "2021-" "2022-" "2023-" "-01-" "-02-" "-03-" "-04-" "-05-" "-06-"
+        "-07-" "-08-" "-09-" "-10-" "-11-" "-12-" "T00:" ":00:00" ":30:00" ".000Z"
+        "module=" "node=" "rssi=" "snr=" "id=" "rtc=" "temp=" "temp1=" "temp2=" "hum="
+        "press=" "batt=" "vbat=" "lat=" "lon=" "alt=" "time=" "date=" "data=" "freq="
+        "value=" "status=" "sensor=" "count=" "seq=" "err=" "ok" "; "
+        "{\"id\":" "{\"node\":" ",\"rssi\":" ",\"snr\":" ",\"temp\":" ",\"hum\":"
+        ",\"batt\":" ",\"lat\":" ",\"lon\":" ",\"ts\":" ",\"data\":\"" "\"}"
+        "IoT" "LoRa" "AIS" "ADS-B" "SUCHAI" "PlantSat" "FOD" "STT" "GPS" "MAG"
+        "ERROR" "Error" "error" "WARNING" "Warning" "OK" "Ok" "TEST" "Test" "test"
+        "Hello" "hello" "Message" "message" "from " "ground" "station" "satellite"
+        "Chile" "Santiago" "Universidad de Chile" " the " " and " " of " " to "
+        "obc_" "com_" "eps_" "tm_" "drp_" "fp_" "sen_" "adcs_" "rw_"
+        "send" "get" "set" "reset" "status" "beacon" "payload" "sensors"
+        " 0.000000" "0.0" " 0 " " 1 " ", " ": " " -" "\r\n" "\n"
+        "                ";
+
+int dict_comp_len(void)
+{
+    return (int)sizeof(dict_comp_dict) - 1;
+}
+
+/**
+ * Get a byte of the dictionary + output virtual buffer
+ */
+static uint8_t dict_get(const uint8_t *out, int pos)
+{
+    int dlen = dict_comp_len();
+    return pos < dlen ? (uint8_t)dict_comp_dict[pos] : out[pos - dlen];
+}
+
+/**
+ * Get the hex digit value of an uppercase hex character, or -1
+ */
+static int dict_hex_value(uint8_t c)
+{
+    if(c >= '0' && c <= '9')
+        return c - '0';
+    if(c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * Get the AIS 6-bit armoring value of a character, or -1
+ */
+static int dict_six_value(uint8_t c)
+{
+    if(c >= 48 && c <= 87)
+        return c - 48;
+    if(c >= 96 && c <= 119)
+        return c - 56;
+    return -1;
+}
+
+static uint8_t dict_six_char(int value)
+{
+    return (uint8_t)(value < 40 ? value + 48 : value + 56);
+}
+
+/**
+ * Count the characters of an alphabet at the beginning of a buffer
+ */
+static int dict_run(const uint8_t *buff, int len, int (*value)(uint8_t), int max)
+{
+    int n = 0;
+    while(n < len && n < max && value(buff[n]) >= 0)
+        n++;
+    return n;
+}
+
+/**
+ * Flush a literal run. Runs of hex digits and AIS 6-bit characters are bit
+ * packed, the rest is copied as is.
+ * @return Output length, or -1 if it does not fit
+ */
+static int dict_put_literals(const uint8_t *lit, int nlit, uint8_t *out, int used, int max)
+{
+    int i = 0;
+    while(i < nlit)
+    {
+        int nhex = dict_run(lit + i, nlit - i, dict_hex_value, DICT_COMP_MAX_PACKED);
+        int nsix = dict_run(lit + i, nlit - i, dict_six_value, DICT_COMP_MAX_PACKED);
+        int n, k;
+        if(nhex >= DICT_COMP_MIN_PACKED && nhex * 4 <= nsix * 3)
+            nhex = 0;   // Longer 6-bit run
+        if(nhex >= DICT_COMP_MIN_PACKED)
+        {
+            n = nhex;
+            if(used + 1 + (n + 1) / 2 > max)
+                return -1;
+            out[used++] = (uint8_t)(DICT_COMP_TOKEN_HEX | (n - 1));
+            for(k = 0; k < n; k += 2)
+                out[used++] = (uint8_t)((dict_hex_value(lit[i + k]) << 4) |
+                                        (k + 1 < n ? dict_hex_value(lit[i + k + 1]) : 0));
+        }
+        else if(nsix >= DICT_COMP_MIN_PACKED)
+        {
+            n = nsix;
+            if(used + 1 + (n * 6 + 7) / 8 > max)
+                return -1;
+            out[used++] = (uint8_t)(DICT_COMP_TOKEN_SIX | (n - 1));
+            uint32_t bits = 0;
+            int nbits = 0;
+            for(k = 0; k < n; k++)
+            {
+                bits = (bits << 6) | (uint32_t)dict_six_value(lit[i + k]);
+                nbits += 6;
+                if(nbits >= 8)
+                {
+                    nbits -= 8;
+                    out[used++] = (uint8_t)(bits >> nbits);
+                }
+            }
+            if(nbits > 0)
+                out[used++] = (uint8_t)(bits << (8 - nbits));
+        }
+        else
+        {
+            // Copy until the next packed run
+            n = 1;
+            while(i + n < nlit && n < DICT_COMP_MAX_LITERALS &&
+                  dict_run(lit + i + n, nlit - i - n, dict_six_value, DICT_COMP_MIN_PACKED) < DICT_COMP_MIN_PACKED)
+                n++;
+            if(used + 1 + n > max)
+                return -1;
+            out[used++] = (uint8_t)(n - 1);
+            memcpy(out + used, lit + i, n);
+            used += n;
+        }
+        i += n;
+    }
+    return used;
+}
+
+int dict_compress(const uint8_t *in, int hist, int len, uint8_t *out, int max)
+{
+    int dlen = dict_comp_len();
+    int used = 0;
+    if(hist < 0 || len < 0 || max < 0)
+        return -1;
+
+    // Indexes are absolute in the history + message buffer, so the virtual
+    // position of in[i] after the dictionary is dlen + i.
+    int i = hist, lit_start = hist, end = hist + len;
+    while(i < end)
+    {
+        // Greedy search of the longest match
+        int best_len = 0, best_dist = 0;
+        int cur = dlen + i;
+        int start = cur - DICT_COMP_MAX_DIST < 0 ? 0 : cur - DICT_COMP_MAX_DIST;
+        int limit = end - i < DICT_COMP_MAX_MATCH ? end - i : DICT_COMP_MAX_MATCH;
+        int j;
+        for(j = start; j < cur && limit >= DICT_COMP_MIN_MATCH; j++)
+        {
+            if(dict_get(in, j) != in[i])
+                continue;
+            int k = 1;
+            while(k < limit && dict_get(in, j + k) == in[i + k])
+                k++;
+            if(k > best_len)
+            {
+                best_len = k;
+                best_dist = cur - j;
+                if(k == limit)
+                    break;
+            }
+        }
+
+        if(best_len < DICT_COMP_MIN_MATCH)
+        {
+            i++;
+            continue;
+        }
+
+        used = dict_put_literals(in + lit_start, i - lit_start, out, used, max);
+        if(used < 0 || used + 2 > max)
+            return -1;
+        out[used++] = (uint8_t)(0x80 | ((best_len - DICT_COMP_MIN_MATCH) << 3) | (best_dist >> 8));
+        out[used++] = (uint8_t)(best_dist & 0xFF);
+        i += best_len;
+        lit_start = i;
+    }
+
+    return dict_put_literals(in + lit_start, end - lit_start, out, used, max);
+}
+
+int dict_decompress(const uint8_t *in, int len, uint8_t *out, int hist, int max)
+{
+    int dlen = dict_comp_len();
+    int i = 0, n = hist;
+    if(len < 0 || hist < 0 || max < hist)
+        return -1;
+
+    while(i < len)
+    {
+        uint8_t token = in[i++];
+        if(token & 0x80)
+        {
+            if(i >= len)
+                return -1;
+            int mlen = ((token >> 3) & 0x0F) + DICT_COMP_MIN_MATCH;
+            int dist = ((token & 0x07) << 8) | in[i++];
+            int src = dlen + n - dist;
+            if(dist == 0 || src < 0 || n + mlen > max)
+                return -1;
+            // Byte by byte, matches can overlap the bytes being written
+            int k;
+            for(k = 0; k < mlen; k++, n++)
+                out[n] = dict_get(out, src + k);
+        }
+        else if(token & DICT_COMP_TOKEN_HEX)
+        {
+            int k, nlit = (token & 0x1F) + 1;
+            int six = (token & DICT_COMP_TOKEN_SIX) == DICT_COMP_TOKEN_SIX;
+            int nbytes = six ? (nlit * 6 + 7) / 8 : (nlit + 1) / 2;
+            if(i + nbytes > len || n + nlit > max)
+                return -1;
+            for(k = 0; k < nlit; k++)
+            {
+                if(six)
+                {
+                    int bit = k * 6;
+                    int v = ((in[i + bit / 8] << 8) | (bit / 8 + 1 < nbytes ? in[i + bit / 8 + 1] : 0)) >> (10 - bit % 8);
+                    out[n++] = dict_six_char(v & 0x3F);
+                }
+                else
+                {
+                    int v = k % 2 ? in[i + k / 2] & 0x0F : in[i + k / 2] >> 4;
+                    out[n++] = (uint8_t)"0123456789ABCDEF"[v];
+                }
+            }
+            i += nbytes;
+        }
+        else
+        {
+            int nlit = token + 1;
+            if(i + nlit > len || n + nlit > max)
+                return -1;
+            memcpy(out + n, in + i, nlit);
+            i += nlit;
+            n += nlit;
+        }
+    }
+    return n - hist;
+}
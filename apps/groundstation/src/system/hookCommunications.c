@@ -4,6 +4,7 @@
 
 #include "suchai/taskCommunications.h"
 #include "app/system/cmdCDH.h"
+#include "app/system/linkStats.h"
 
 static char *tag = "Communications*";
 
@@ -82,6 +83,7 @@ void pay_parse_frame(csp_packet_t *packet, int app_id)
     frame->ndata = csp_ntoh32(frame->ndata);
     // Map sat payload id to ground payload id according to repoDataSchema
     uint8_t prev_type = frame->type;
+    link_stats_update(frame->node, prev_type, frame->nframe, packet->length);
     frame->type += PAYLOAD_ID_MAP[app_id];
 
     LOGI(tag, "Node    : %d", frame->node);
@@ -117,6 +119,7 @@ void com_receive_cmdh_tm(csp_packet_t *packet, int app_id) {
 
     frame->nframe = csp_ntoh16(frame->nframe);
     frame->ndata = csp_ntoh32(frame->ndata);
+    link_stats_update(frame->node, frame->type, frame->nframe, packet->length);
 
     LOGI(tag, "Received: %d bytes", packet->length);
     LOGI(tag, "Node    : %d", frame->node);
@@ -130,12 +133,37 @@ void com_receive_cmdh_tm(csp_packet_t *packet, int app_id) {
         cmd_add_params_raw(cmd_parse_tm, frame, sizeof(com_frame_t));
         cmd_send(cmd_parse_tm);
     }
-    else if(frame->type == TM_TYPE_PAYLOAD_STA)
+    else if(frame->type == TM_TYPE_MSG_PACKED)
+    {
+        // The frame has no payload id, pass the ground messages payload of
+        // this app in the samples field
+        frame->ndata = msg_sensors_2 + PAYLOAD_ID_MAP[app_id];
+        cmd_parse_tm = cmd_get_str("tm_parse_msgs");
+        cmd_add_params_raw(cmd_parse_tm, frame, sizeof(com_frame_t));
+        cmd_send(cmd_parse_tm);
+    }
+    else if(frame->type == TM_TYPE_PAYLOAD_STA || frame->type == TM_TYPE_BEACON_PACKED)
     {
         cmd_parse_tm = cmd_get_str("tm_parse_beacon");
         cmd_add_params_raw(cmd_parse_tm, frame, sizeof(com_frame_t));
         cmd_send(cmd_parse_tm);
     }
+    else if(frame->type == TM_TYPE_PAYLOAD_DELTA)
+    {
+        // Map sat payload id to ground payload id according to repoDataSchema
+        frame->data.data8[1] += PAYLOAD_ID_MAP[app_id];
+        cmd_parse_tm = cmd_get_str("tm_parse_pay_delta");
+        cmd_add_params_raw(cmd_parse_tm, frame, sizeof(com_frame_t));
+        cmd_send(cmd_parse_tm);
+    }
+    else if(frame->type == TM_TYPE_SCHEMA)
+    {
+        // Map sat first payload id to ground payload id according to repoDataSchema
+        frame->data.data8[1] += PAYLOAD_ID_MAP[app_id];
+        cmd_parse_tm = cmd_get_str("tm_parse_schema");
+        cmd_add_params_raw(cmd_parse_tm, frame, sizeof(com_frame_t));
+        cmd_send(cmd_parse_tm);
+    }
     else if(frame->type == TM_TYPE_STATUS)
     {
         cmd_parse_tm = cmd_get_str("tm_parse_status");
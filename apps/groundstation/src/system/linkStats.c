@@ -0,0 +1,208 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/linkStats.h"
+
+static const char *tag = "linkStats";
+
+static link_stats_t link_stats[LINK_STATS_MAX_ENTRIES];
+static osSemaphore link_stats_sem;
+
+/**
+ * Find the entry of a (node, type) pair, or allocate a new one.
+ * Requires link_stats_sem to be taken.
+ */
+static link_stats_t *link_stats_get_entry(uint8_t node, uint8_t type)
+{
+    int i;
+    link_stats_t *free_entry = NULL;
+    for(i = 0; i < LINK_STATS_MAX_ENTRIES; i++)
+    {
+        if(link_stats[i].in_use && link_stats[i].node == node && link_stats[i].type == type)
+            return &link_stats[i];
+        if(!link_stats[i].in_use && free_entry == NULL)
+            free_entry = &link_stats[i];
+    }
+
+    if(free_entry != NULL)
+    {
+        memset(free_entry, 0, sizeof(link_stats_t));
+        free_entry->node = node;
+        free_entry->type = type;
+        free_entry->in_use = 1;
+    }
+    return free_entry;
+}
+
+/**
+ * Close the rolling window if expired and compute rates.
+ * Requires link_stats_sem to be taken.
+ */
+static void link_stats_update_window(link_stats_t *s, portTick now)
+{
+    portTick elapsed = now - s->win_start;
+    if(elapsed < LINK_STATS_WINDOW_MS)
+        return;
+
+    uint32_t expected = s->win_frames + s->win_lost;
+    s->frames_s = (float)s->win_frames * 1000.0f / (float)elapsed;
+    s->bytes_s = (float)s->win_bytes * 1000.0f / (float)elapsed;
+    s->loss_pct = expected > 0 ? 100.0f * (float)s->win_lost / (float)expected : 0.0f;
+
+    s->win_start = now;
+    s->win_frames = 0;
+    s->win_bytes = 0;
+    s->win_lost = 0;
+}
+
+int link_stats_init(void)
+{
+    memset(link_stats, 0, sizeof(link_stats));
+    if(osSemaphoreCreate(&link_stats_sem) != OS_SEMAPHORE_OK)
+    {
+        LOGE(tag, "Unable to create link stats mutex");
+        return -1;
+    }
+    return 0;
+}
+
+void link_stats_update(uint8_t node, uint8_t type, uint16_t nframe, int nbytes)
+{
+    portTick now = osTaskGetTickCount();
+
+    osSemaphoreTake(&link_stats_sem, portMAX_DELAY);
+    link_stats_t *s = link_stats_get_entry(node, type);
+    if(s == NULL)
+    {
+        osSemaphoreGiven(&link_stats_sem);
+        LOGW(tag, "Link stats table full, frame (%d, %d) not accounted", node, type);
+        return;
+    }
+
+    /* Sequence tracking */
+    int diff = (int)(int16_t)(uint16_t)(nframe - s->highest);
+    int new_burst = diff <= 0 && (now - s->last_tick) > LINK_STATS_BURST_GAP_MS;
+    if(s->received == 0 || nframe == 0 || new_burst)
+    {
+        // First frame or new com_send_telemetry burst
+        s->highest = nframe;
+        s->seen_mask = 1;
+        s->bursts++;
+        if(nframe > 0)
+        {
+            // The burst started before we listened, or its first frames were lost
+            s->lost += nframe;
+            s->win_lost += nframe;
+        }
+    }
+    else if(diff > 0)
+    {
+        // In order (diff == 1) or a gap of diff-1 frames
+        s->lost += diff - 1;
+        s->win_lost += diff - 1;
+        s->seen_mask = diff < LINK_STATS_SEQ_WINDOW ? (s->seen_mask << diff) | 1 : 1;
+        s->highest = nframe;
+    }
+    else if(diff == 0)
+    {
+        s->duplicated++;
+    }
+    else
+    {
+        // Late frame, it was counted as lost when the gap was detected
+        int age = -diff;
+        if(age < LINK_STATS_SEQ_WINDOW && (s->seen_mask & ((uint32_t)1 << age)))
+        {
+            s->duplicated++;
+        }
+        else
+        {
+            if(age < LINK_STATS_SEQ_WINDOW)
+                s->seen_mask |= (uint32_t)1 << age;
+            s->reordered++;
+            if(s->lost > 0) s->lost--;
+            if(s->win_lost > 0) s->win_lost--;
+        }
+    }
+
+    /* Inter-arrival jitter */
+    if(s->received > 0)
+    {
+        int32_t ia = (int32_t)(now - s->last_tick);
+        if(s->received == 1)
+            s->mean_ia_ms = ia;
+        int32_t dev = ia - s->mean_ia_ms;
+        s->mean_ia_ms += dev >> LINK_STATS_EWMA_SHIFT;
+        dev = dev < 0 ? -dev : dev;
+        s->jitter_ms += (dev - s->jitter_ms) >> LINK_STATS_EWMA_SHIFT;
+    }
+    else
+    {
+        s->first_tick = now;
+        s->win_start = now;
+    }
+
+    s->received++;
+    s->bytes += nbytes;
+    s->win_frames++;
+    s->win_bytes += nbytes;
+    s->last_tick = now;
+    link_stats_update_window(s, now);
+
+    osSemaphoreGiven(&link_stats_sem);
+}
+
+int link_stats_print(int node)
+{
+    int i, n = 0;
+    portTick now = osTaskGetTickCount();
+
+    osSemaphoreTake(&link_stats_sem, portMAX_DELAY);
+    for(i = 0; i < LINK_STATS_MAX_ENTRIES; i++)
+    {
+        link_stats_t *s = &link_stats[i];
+        if(!s->in_use || (node >= 0 && s->node != node))
+            continue;
+
+        link_stats_update_window(s, now);
+        uint32_t expected = s->received + s->lost;
+        float loss_total = expected > 0 ? 100.0f * (float)s->lost / (float)expected : 0.0f;
+        LOGR(tag, "Node %d, type %d: rx %u, lost %u (%.1f%%), reord %u, dup %u, bursts %u, bytes %u, last %u ms ago",
+             s->node, s->type, s->received, s->lost, loss_total, s->reordered, s->duplicated, s->bursts,
+             s->bytes, (unsigned int)(now - s->last_tick));
+        LOGR(tag, "Node %d, type %d: %.2f frames/s, %.1f bytes/s, loss %.1f%%, inter-arrival %d ms, jitter %d ms",
+             s->node, s->type, s->frames_s, s->bytes_s, s->loss_pct, s->mean_ia_ms, s->jitter_ms);
+        n++;
+    }
+    osSemaphoreGiven(&link_stats_sem);
+
+    return n;
+}
+
+void link_stats_reset(int node)
+{
+    int i;
+    osSemaphoreTake(&link_stats_sem, portMAX_DELAY);
+    for(i = 0; i < LINK_STATS_MAX_ENTRIES; i++)
+    {
+        if(node < 0 || link_stats[i].node == node)
+            memset(&link_stats[i], 0, sizeof(link_stats_t));
+    }
+    osSemaphoreGiven(&link_stats_sem);
+}
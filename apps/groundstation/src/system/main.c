@@ -25,6 +25,8 @@
 #include "app/system/cmdAX100.h"
 #include "app/system/cmdEPS.h"
 #include "app/system/cmdCDH.h"
+#include "app/system/linkStats.h"
+#include "app/system/taskHousekeeping.h"
 
 #if SCH_GND_ADD_PAYLOADS
 #include "app/system/cmdMAG.h"
@@ -54,6 +56,7 @@ void initAppHook(void *params)
     cmd_ax100_init();
     cmd_eps_init();
     cmd_cdh_init();
+    link_stats_init();
 
 #if SCH_GND_ADD_PAYLOADS
     cmd_mag_init();
@@ -82,6 +85,8 @@ void initAppHook(void *params)
     csp_route_set(29, &csp_if_kiss, 255);
 
     /** Init app tasks */
+    int t_ok = osCreateTask(taskHousekeeping, "housekeeping", 1024, NULL, 2, NULL);
+    if(t_ok != 0) LOGE(tag, "Task housekeeping not created!");
 }
 
 int main(void)
@@ -0,0 +1,47 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2021, Carlos Gonzalez Cortes, carlgonz@uchile.cl
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/taskHousekeeping.h"
+
+static const char *tag = "Housekeeping";
+
+void taskHousekeeping(void *param)
+{
+    LOGI(tag, "Started");
+
+    portTick delay_ms    = 1000;            //Task period in [ms]
+    unsigned int elapsed_sec = 1;           // Seconds counter
+
+    portTick xLastWakeTime = osTaskGetTickCount();
+
+    while(1)
+    {
+        osTaskDelayUntil(&xLastWakeTime, delay_ms); //Suspend task
+        elapsed_sec += delay_ms / 1000; //Update seconds counts
+
+        /* Host metrics, period set by dat_obc_host_period */
+        int host_period = dat_get_system_var(dat_obc_host_period);
+        if(host_period > 0 && (elapsed_sec % host_period) == 0)
+        {
+            cmd_t *cmd_host = cmd_get_str("obc_get_host");
+            cmd_send(cmd_host);
+        }
+    }
+}
@@ -5,11 +5,15 @@
 #ifndef TRIAD_H
 #define TRIAD_H
 
+#include <string.h>
+
 #include "suchai/config.h"
 
 #include "suchai/repoCommand.h"
 #include "suchai/repoData.h"
 #include "suchai/math_utils.h"
+#include "app/system/ekfMatrix.h"
+#include "app/system/adcsTiming.h"
 
 /**
  * Calculate the quaternion from 2 vectors measured
@@ -31,6 +35,17 @@ quaternion_t calc_with_triad(vector3_t unit_sun_vector_b, vector3_t unit_mag_vec
 matrix3_t skewsymmetricmatrix(vector3_t vector_3x3);
 void estimate_omega_quat_with_triadekf(quaternion_t current_q_det, vector3_t current_omega_b, portTick delay_ms,
                                        quaternion_t * current_q_est_i2c, vector3_t * current_omega_b_est);
+/**
+ * Same as estimate_omega_quat_with_triadekf, but the measurements are applied
+ * one scalar at a time (R is diagonal), so the 7x7 innovation covariance is
+ * not factored. The gyro measurement is applied every call and the quaternion
+ * measurement only if new_q_det is set, so the gyro rate is independent of the
+ * sun and magnetometer rate.
+ * @param new_q_det 1 if current_q_det was determined since the last call
+ */
+void estimate_omega_quat_with_triadekf_seq(quaternion_t current_q_det, vector3_t current_omega_b, int new_q_det,
+                                           portTick delay_ms, quaternion_t * current_q_est_i2c,
+                                           vector3_t * current_omega_b_est);
 matrix3_t skewsymmetricmatrix(vector3_t vector_3x3);
 void estimate_omega_with_triadekf(quaternion_t current_q_det, vector3_t current_omega_b, portTick delay_ms,
                                        quaternion_t * current_q_est_i2c, vector3_t * current_omega_b_est);
@@ -0,0 +1,155 @@
+/**
+ * @file  adcsDriver.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the ADCS devices driver API: gyroscope,
+ * magnetometer, sun sensors (FSS and CSS), magnetorquers (MTQ), reaction
+ * wheels (RW) and the attitude telemetry sent to the ADCS subsystem.
+ *
+ * The functions take and return typed values, so the ADCS loop calls them
+ * directly instead of building string commands and waiting for the command
+ * executer. Each device is protected by its own mutex, so a function can be
+ * called from the ADCS tasks and from the commands at the same time. The
+ * ADCS commands are thin wrappers of these functions for ground use.
+ */
+
+#ifndef _ADCS_DRIVER_H
+#define _ADCS_DRIVER_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "drivers.h"
+#include "suchai/config.h"
+#include "app/system/config.h"
+#include "suchai/repoData.h"
+#include "suchai/osSemaphore.h"
+#include "suchai/osDelay.h"
+#include "suchai/math_utils.h"
+#include "suchai/log_utils.h"
+#include "suchai/cmdCOM.h"
+#include "app/drivers/rwdrv10987.h"
+
+#define ADCS_PORT 7                 ///< ADCS subsystem CSP port
+
+#define ADCS_DRV_OK 0               ///< Device read or write OK
+#define ADCS_DRV_ERROR (-1)         ///< Device error or not available
+
+#define ADCS_DRV_MTQ_MAX_DUTY 100   ///< Magnetorquer max. PWM duty [%]
+#define ADCS_DRV_RW_MAX_SPEED 511   ///< Reaction wheel max. speed command
+#define ADCS_DRV_RW_MIN_SPEED 100   ///< Reaction wheel min. speed command, except 0
+
+/**
+ * ADCS devices, one mutex per device
+ */
+typedef enum adcs_drv_dev {
+    ADCS_DRV_GYRO = 0,              ///< MPU3300 gyroscope
+    ADCS_DRV_MAG,                   ///< HMC5843 magnetometer
+    ADCS_DRV_SUN,                   ///< GSSB fine and coarse sun sensors
+    ADCS_DRV_MTQ,                   ///< Magnetorquers PWM
+    ADCS_DRV_RW,                    ///< DRV10987 reaction wheels
+    ADCS_DRV_ADCS,                  ///< ADCS subsystem (CSP)
+    ADCS_DRV_LAST
+} adcs_drv_dev_t;
+
+/**
+ * Initialize the devices mutexes and the sun sensors calibration
+ * @return ADCS_DRV_OK, or ADCS_DRV_ERROR in case of errors
+ */
+int adcs_drv_init(void);
+
+/**
+ * Read the gyroscope, the sensor bias (dat_ads_bias_x) is added
+ * @param omega Angular velocity, body frame
+ * @return ADCS_DRV_OK, or ADCS_DRV_ERROR if not read
+ */
+int adcs_drv_read_gyro(vector3_t *omega);
+
+/**
+ * Read the magnetometer
+ * @param mag Magnetic field, body frame [nT]
+ * @return ADCS_DRV_OK, or ADCS_DRV_ERROR if not read
+ */
+int adcs_drv_read_mag(vector3_t *mag);
+
+/**
+ * Read the sun sensors and calculate the sun direction. It takes about 1.5 s
+ * to sample the five FSS.
+ * @param sun_dir Unit sun direction, body frame
+ * @return ADCS_DRV_OK, or ADCS_DRV_ERROR if a FSS can not be sampled
+ */
+int adcs_drv_read_sun(vector3_t *sun_dir);
+
+/**
+ * Set the camera to body frame quaternion of a FSS
+ * @param fss FSS number [1-5]
+ * @param q_c2b Camera to body frame quaternion
+ * @return ADCS_DRV_OK, or ADCS_DRV_ERROR if fss is not valid
+ */
+int adcs_drv_set_fss_quat(int fss, const quaternion_t *q_c2b);
+
+/**
+ * Turn on/off the magnetorquers power switch
+ * @param enable 1 on, 0 off
+ * @return ADCS_DRV_OK, or ADCS_DRV_ERROR if not available
+ */
+int adcs_drv_set_mtq_pwr(int enable);
+
+/**
+ * Set the PWM duty cycle of a magnetorquer
+ * @param channel 0:X, 1:Y, 2:Z
+ * @param duty Duty cycle [-100, 100] %
+ * @return ADCS_DRV_OK, or ADCS_DRV_ERROR if the parameters are not valid
+ */
+int adcs_drv_set_mtq_duty(int channel, int duty);
+
+/**
+ * Set the PWM frequency of a magnetorquer
+ * @param channel 0:X, 1:Y, 2:Z
+ * @param freq Frequency [0.1, 433.0] Hz
+ * @param actual_freq Frequency set, can be NULL
+ * @return ADCS_DRV_OK, or ADCS_DRV_ERROR if the parameters are not valid
+ */
+int adcs_drv_set_mtq_freq(int channel, float freq, float *actual_freq);
+
+/**
+ * Power on the magnetorquers and set the duty cycle of the three axes
+ * @param duty Duty cycle of the X, Y and Z axes [-100, 100] %
+ * @return ADCS_DRV_OK, or ADCS_DRV_ERROR in case of errors
+ */
+int adcs_drv_set_mtq(const int8_t duty[3]);
+
+/**
+ * Read the speed of a reaction wheel
+ * @param motor_id RW_MOTOR1_ID, RW_MOTOR2_ID or RW_MOTOR3_ID
+ * @return Speed
+ */
+uint16_t adcs_drv_get_rw_speed(int motor_id);
+
+/**
+ * Read the current of a reaction wheel
+ * @param motor_id RW_MOTOR1_ID, RW_MOTOR2_ID or RW_MOTOR3_ID
+ * @return Current [mA]
+ */
+float adcs_drv_get_rw_current(int motor_id);
+
+/**
+ * Set the speed of a reaction wheel
+ * @param motor_id RW_MOTOR1_ID, RW_MOTOR2_ID or RW_MOTOR3_ID
+ * @param speed Speed [-511, -100], [100, 511] or 0, the sign is the direction
+ * @return ADCS_DRV_OK, or ADCS_DRV_ERROR in case of errors
+ */
+int adcs_drv_set_rw_speed(int motor_id, int speed);
+
+/**
+ * Send the estimated and target attitude to the ADCS subsystem
+ * @param q_est Estimated quaternion, inertial to body frame
+ * @param q_tgt Target quaternion, inertial to body frame
+ * @return ADCS_DRV_OK, or ADCS_DRV_ERROR in case of errors
+ */
+int adcs_drv_send_attitude(const quaternion_t *q_est, const quaternion_t *q_tgt);
+
+#endif //_ADCS_DRIVER_H
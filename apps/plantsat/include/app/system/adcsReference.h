@@ -0,0 +1,99 @@
+/**
+ * @file  adcsReference.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the orbit-ahead ADCS reference table. The
+ * orbit position and velocity (SGP4), geodetic coordinates, magnetic field
+ * (IGRF), sun position and shadow are calculated by taskADCSReference every
+ * ADCS_REF_STEP seconds over the next orbit and stored in a RAM table.
+ *
+ * The ADCS loop reads the references of any time inside the table with a
+ * four points (cubic) Lagrange interpolation, so the models are not evaluated
+ * in the loop. The shadow is interpolated as the angular margin of the
+ * calc_shadow_zone test, so the eclipse entry and exit are not rounded to a
+ * node. The table is double buffered, a new table is filled while the current
+ * one is being read and then they are swapped.
+ *
+ * With 60 s steps in LEO the interpolation error is about 3 m in position and
+ * 3 nT in the magnetic field. The longitude changes fast near the poles, so
+ * there it is less accurate (1e-3 rad below 80 deg of latitude).
+ */
+
+#ifndef _ADCS_REFERENCE_H
+#define _ADCS_REFERENCE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "suchai/config.h"
+#include "suchai/repoData.h"
+#include "suchai/osSemaphore.h"
+#include "suchai/osDelay.h"
+#include "suchai/math_utils.h"
+#include "suchai/log_utils.h"
+
+#define ADCS_REF_STEP 60            ///< Time between nodes [s]
+#define ADCS_REF_NODES 104          ///< Table nodes, 103 min. covers one orbit and the interpolation margins
+#define ADCS_REF_MARGIN 600         ///< Fill a new table when less than this time is left [s]
+#define ADCS_REF_BLOCK 8            ///< Nodes propagated and converted to geodetic at once
+
+/**
+ * References of the ADCS loop at a given time, inertial frame
+ */
+typedef struct adcs_ref {
+    double t;                       ///< Unix time [s]
+    vector3_t pos_i;                ///< Satellite position [km]
+    vector3_t vel_i;                ///< Satellite velocity [km/s]
+    vector3_t geod;                 ///< Geodetic latitude [rad], longitude [rad] and altitude [km]
+    vector3_t mag_i;                ///< Magnetic field [nT]
+    vector3_t sun_pos_i;            ///< Sun position [m]
+    vector3_t nadir_i;              ///< Unit nadir direction
+    vector3_t omega_nadir_i;        ///< Nadir frame angular velocity, r x v / |r|^2 [rad/s]
+    int isdark;                     ///< 1 if in the Earth shadow
+} adcs_ref_t;
+
+/**
+ * Initialize the reference tables
+ * @return 0 if OK, -1 in case of errors
+ */
+int adcs_ref_init(void);
+
+/**
+ * Calculate the references of the ADCS loop with the orbit and environment
+ * models, it is the slow path used to fill the table.
+ * @param t Unix time [s]
+ * @param ref References at t
+ * @return 0 if OK, -1 if the orbit can not be propagated
+ */
+int adcs_ref_calc(double t, adcs_ref_t *ref);
+
+/**
+ * Fill the inactive table from time t0 and make it the active one. Only one
+ * task should fill the table.
+ * @param t0 Time of the first node [s]
+ * @param yield_ms Delay between nodes to release the CPU [ms], 0 to not wait
+ * @return Number of nodes, or -1 in case of errors
+ */
+int adcs_ref_fill(double t0, int yield_ms);
+
+/**
+ * Get the interpolated references at time t from the active table
+ * @param t Unix time [s]
+ * @param ref References at t
+ * @return 0 if OK, -1 if t is not covered by the table
+ */
+int adcs_ref_get(double t, adcs_ref_t *ref);
+
+/**
+ * Check if a new table should be filled, because it is empty, it will end in
+ * less than ADCS_REF_MARGIN seconds or it was calculated with another TLE
+ * @param t Current unix time [s]
+ * @param tle_epoch Current TLE epoch (dat_ads_tle_epoch)
+ * @return 1 if a new table is required, 0 otherwise
+ */
+int adcs_ref_expired(double t, int tle_epoch);
+
+#endif //_ADCS_REFERENCE_H
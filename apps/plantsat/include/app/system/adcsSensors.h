@@ -0,0 +1,81 @@
+/**
+ * @file  adcsSensors.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the ADCS sensors acquisition pipeline. The
+ * gyroscope, magnetometer and sun sensors are read by taskADCSSensors, at the
+ * periods of the ADCS loop, and each completed read is published to the
+ * sample slot of the sensor with its timestamp and a sequence number.
+ *
+ * The ADCS loop consumes the freshest sample of each slot without sleeping
+ * or waiting for a command to finish. A new sequence number notifies that a
+ * read was completed since the last sample, and the age tells how old the
+ * measurement is. Failed reads do not modify the slot, they are counted as
+ * errors.
+ */
+
+#ifndef _ADCS_SENSORS_H
+#define _ADCS_SENSORS_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "suchai/config.h"
+#include "suchai/repoData.h"
+#include "suchai/osSemaphore.h"
+#include "suchai/osDelay.h"
+#include "suchai/math_utils.h"
+#include "suchai/log_utils.h"
+
+/**
+ * ADCS sensors with a sample slot
+ */
+typedef enum adcs_sen_id {
+    ADCS_SEN_GYRO = 0,              ///< Angular velocity, body frame
+    ADCS_SEN_MAG,                   ///< Magnetic field, body frame
+    ADCS_SEN_SUN,                   ///< Sun direction, body frame
+    ADCS_SEN_LAST
+} adcs_sen_id_t;
+
+/**
+ * Sample slot of a sensor, holds the last completed read
+ */
+typedef struct adcs_sen_sample {
+    vector3_t value;                ///< Measurement, body frame
+    uint32_t seq;                   ///< Completed reads, 0 if no sample yet
+    uint32_t errors;                ///< Failed reads
+    int timestamp;                  ///< System time of the read [s]
+    portTick tick;                  ///< Task ticks of the read [ms]
+} adcs_sen_sample_t;
+
+/**
+ * Initialize the sample slots
+ * @return 0 if OK, -1 in case of errors
+ */
+int adcs_sen_init(void);
+
+/**
+ * Publish a completed read to the sensor slot and increase its sequence number
+ * @param sensor Sensor, adcs_sen_id_t
+ * @param value Measurement
+ */
+void adcs_sen_put(int sensor, const vector3_t *value);
+
+/**
+ * Count a failed read of a sensor, the slot keeps the last sample
+ * @param sensor Sensor, adcs_sen_id_t
+ */
+void adcs_sen_error(int sensor);
+
+/**
+ * Get the freshest sample of a sensor, does not block waiting for a read.
+ * Compare the sample seq with a previous one to know if it is a new read.
+ * @param sensor Sensor, adcs_sen_id_t
+ * @param sample Copy of the sample slot
+ * @return Sample age in ms, or -1 if there is no sample yet
+ */
+int adcs_sen_get(int sensor, adcs_sen_sample_t *sample);
+
+#endif //_ADCS_SENSORS_H
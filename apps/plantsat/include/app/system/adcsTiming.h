@@ -0,0 +1,104 @@
+/**
+ * @file  adcsTiming.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the ADCS loop timing instrumentation. Each
+ * stage of the ADCS loop (sensors, models, determination, EKF and control) is
+ * measured with the CPU cycle counter (the AVR32 COUNT register in the A3200,
+ * a monotonic clock in Linux) and added to a histogram of the stage. The
+ * histograms keep the count, min, max and mean durations and two bins per
+ * power of two of microseconds to estimate the 99th percentile.
+ *
+ * adcs_tim_flush saves the statistics of each stage as a tim_data_t sample
+ * (tim_sensors payload) and resets the histograms.
+ *
+ * The instrumentation is only compiled if SCH_ADCS_TIMING_ENABLED is set,
+ * otherwise ADCS_TIM_START and ADCS_TIM_STOP are no-ops.
+ */
+
+#ifndef _ADCS_TIMING_H
+#define _ADCS_TIMING_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "suchai/config.h"
+#include "suchai/repoData.h"
+#include "suchai/osSemaphore.h"
+#include "suchai/log_utils.h"
+#include "app/system/payloadRetention.h"
+
+#define ADCS_TIM_NBINS 48           ///< Histogram bins, up to 2^24 us
+#ifndef ADCS_TIM_CPU_MHZ
+#define ADCS_TIM_CPU_MHZ 64         ///< A3200 CPU clock, COUNT increments once per cycle
+#endif
+
+/**
+ * ADCS loop stages
+ */
+typedef enum adcs_tim_stage {
+    ADCS_TIM_GYRO = 0,              ///< Gyroscope acquisition
+    ADCS_TIM_MAG_SUN,               ///< Magnetometer and sun sensors acquisition
+    ADCS_TIM_MODEL,                 ///< calc_adcs_model_parameters (SGP4, IGRF, sun)
+    ADCS_TIM_DETERMINATION,         ///< TRIAD or magnetometer determination
+    ADCS_TIM_EKF_PREDICT,           ///< EKF state and covariance propagation
+    ADCS_TIM_EKF_UPDATE,            ///< EKF measurement update
+    ADCS_TIM_CONTROL,               ///< Control law
+    ADCS_TIM_LAST
+} adcs_tim_stage_t;
+
+#if SCH_ADCS_TIMING_ENABLED
+/** Start measuring, declares the cycle counter variable t */
+#define ADCS_TIM_START(t) uint32_t t = adcs_tim_now()
+/** Stop measuring and add the duration since ADCS_TIM_START(t) to a stage */
+#define ADCS_TIM_STOP(stage, t) adcs_tim_add((stage), adcs_tim_now() - (t))
+#else
+#define ADCS_TIM_START(t) do {} while(0)
+#define ADCS_TIM_STOP(stage, t) do {} while(0)
+#endif
+
+/**
+ * Duration histogram of a stage
+ */
+typedef struct adcs_tim_hist {
+    uint32_t count;                 ///< Samples since the last flush
+    uint32_t min;                   ///< Min. duration [us]
+    uint32_t max;                   ///< Max. duration [us]
+    uint64_t sum;                   ///< Sum of durations [us]
+    uint16_t bins[ADCS_TIM_NBINS];  ///< Samples per bin, saturated
+} adcs_tim_hist_t;
+
+/**
+ * Initialize the histograms
+ * @return 0 if OK, -1 in case of errors
+ */
+int adcs_tim_init(void);
+
+/**
+ * Read the cycle counter
+ * @return Counter value in ticks, wraps around
+ */
+uint32_t adcs_tim_now(void);
+
+/**
+ * Add a duration to a stage histogram
+ * @param stage Stage, adcs_tim_stage_t
+ * @param ticks Duration in cycle counter ticks
+ */
+void adcs_tim_add(int stage, uint32_t ticks);
+
+/**
+ * Save the statistics of the stages with samples as tim_data_t samples and
+ * reset the histograms
+ * @return Number of samples saved
+ */
+int adcs_tim_flush(void);
+
+/**
+ * Print the statistics of all stages
+ */
+void adcs_tim_print(void);
+
+#endif //_ADCS_TIMING_H
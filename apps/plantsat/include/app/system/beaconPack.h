@@ -0,0 +1,70 @@
+/**
+ * @file  beaconPack.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the bit-packed beacon encoding. The beacon
+ * carries the status_data_t fields, each one packed with the number of bits
+ * defined in a versioned field width table. Values out of range are saturated,
+ * except monotonic counters, that wrap around (only their low bits are sent).
+ * The first byte is the layout version, so the ground can decode beacons from
+ * satellites running older layouts. Bits are written MSB first.
+ *
+ * Beacon layout:
+ * @code
+ * | version | field 0 (bits[0]) | field 1 (bits[1]) | ... | padding |
+ * @endcode
+ */
+
+#ifndef _BEACON_PACK_H
+#define _BEACON_PACK_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "suchai/config.h"
+#include "suchai/repoData.h"
+
+#define BCN_PACK_VERSION 1          ///< Current layout version
+#define BCN_PACK_MAX_LEN 64         ///< Max. packed beacon length in bytes
+
+#define BCN_FIELD_UNSIGNED 0        ///< Unsigned value, saturated
+#define BCN_FIELD_SIGNED 1          ///< Two's complement signed value, saturated
+#define BCN_FIELD_COUNTER 2         ///< Unsigned monotonic counter, wraps around
+
+/**
+ * Field width table entry
+ */
+typedef struct bcn_field {
+    uint8_t bits;                   ///< Width in bits [1, 32]
+    uint8_t type;                   ///< BCN_FIELD_UNSIGNED, BCN_FIELD_SIGNED or BCN_FIELD_COUNTER
+} bcn_field_t;
+
+/**
+ * Get the packed beacon length of a layout version
+ * @param version Layout version
+ * @return Length in bytes, or -1 if the version is not supported
+ */
+int bcn_pack_get_len(int version);
+
+/**
+ * Pack a status struct with the current layout version
+ * @param status Status struct to pack
+ * @param buff Output buffer
+ * @param len Output buffer length in bytes
+ * @return Number of bytes written, or -1 if the buffer is too small
+ */
+int bcn_pack(status_data_t *status, uint8_t *buff, int len);
+
+/**
+ * Unpack a beacon. Fields not present in the beacon layout are set to 0.
+ * @param buff Packed beacon
+ * @param len Packed beacon length in bytes
+ * @param status Status struct to fill
+ * @return Beacon layout version, or -1 if the version is not supported or
+ * the beacon is too short
+ */
+int bcn_unpack(uint8_t *buff, int len, status_data_t *status);
+
+#endif //_BEACON_PACK_H
@@ -23,6 +23,13 @@
 
 #include "suchai/repoData.h"
 #include "suchai/repoCommand.h"
+#include "app/system/eventRules.h"
+#include "app/system/statusSnapshot.h"
+#include "app/system/adcsTiming.h"
+#include "app/system/adcsDriver.h"
+#include "app/system/igrfCache.h"
+#include "igrf/igrf13.h"
+#include "app/system/orbitProp.h"
 #include "suchai/cmdCOM.h"
 //#include "suchai/math_utils.h"
 #include "suchai/log_utils.h"
@@ -111,7 +118,9 @@ int tle_update(char *fmt, char *params, int nparams);
 
 /**
  * Propagate the TLE to the given datetime to update satellite position in ECI
- * reference. The result is stored in the system variables. The command receives
+ * reference. The result is stored in the system variables. The position is
+ * obtained from the shared orbit propagator (see orbitProp.h), code should
+ * call orbit_prop_get directly instead of reading the system variables. The command receives
  * the datetime to propagate in unix timestamp format. If the parameter is 0
  * then uses the current date and time.
  * @warning This command do not receive the TLE lines, nor update the TLE.
@@ -230,6 +239,14 @@ int adcs_get_mag(char* fmt, char* params, int nparams);
  */
 int adcs_control_torque(char* fmt, char* params, int nparams);
 
+/**
+ * Calculate the control torque to reach the target attitude (dat_tgt_q0 and
+ * dat_tgt_omega_x) and send it to the ADCS subsystem
+ * @param ctrl_cycle Control cycle
+ * @return 0 if OK, -1 in case of errors
+ */
+int adcs_do_control(double ctrl_cycle);
+
 /**
  *
  * @param fmt ""
@@ -248,9 +265,18 @@ int adcs_mag_moment(char* fmt, char* params, int nparams);
  */
 int adcs_set_target(char* fmt, char* params, int nparams);
 
+/**
+ * Set the target attitude pointing the Z+ face to a vector, updates
+ * dat_tgt_q0 and dat_tgt_omega_x
+ * @param i_tar Target vector, inertial frame
+ * @param omega_tar Target angular velocity, body frame [rad/s]
+ * @return 0 if OK, -1 in case of errors
+ */
+int adcs_point_to(vector3_t i_tar, vector3_t omega_tar);
+
 /**
  * Set ADCS target to Nadir based on current quaternion and position
- * Uses sim_adcs_set_target
+ * Uses adcs_point_to
  * @param fmt ""
  * @param params ""
  * @param nparams 0
@@ -276,6 +302,16 @@ int adcs_detumbling_mag(char* fmt, char* params, int nparams);
  */
 int adcs_send_attitude(char* fmt, char* params, int nparams);
 int calc_shadow_zone(vector3_t sun_pos_i, vector3_t sc_pos_i);
+
+/**
+ * Angular margin of the shadow test of calc_shadow_zone, the satellite is in
+ * the Earth shadow if it is positive. It is continuous along the orbit, so it
+ * can be interpolated.
+ * @param sun_pos_i Sun position, inertial frame
+ * @param sc_pos_i Satellite position, inertial frame [km]
+ * @return Shadow margin [rad]
+ */
+double calc_shadow_margin(vector3_t sun_pos_i, vector3_t sc_pos_i);
 int get_obc_sun_vec(char* fmt, char* params, int nparams);
 int start_attitude(char *fmt, char *params, int nparams);
 int set_sc_inertia_matrix(char *fmt, char *params, int nparams);
@@ -285,4 +321,43 @@ int set_time_delay_quat(char *fmt, char *params, int nparams);
 int set_mtq_axis(char *fmt, char *params, int nparams);
 int set_quat_fss(char *fmt, char *params, int nparams);
 int set_bias_omega(char *fmt, char *params, int nparams);
+
+/**
+ * Print the ADCS loop stages timing statistics
+ * @param fmt ""
+ * @param params ""
+ * @param nparams 0
+ * @return CMD_OK
+ */
+int adcs_tim_print_stats(char* fmt, char* params, int nparams);
+
+/**
+ * Save the ADCS loop stages timing statistics as tim_sensors samples and
+ * reset them
+ * @param fmt ""
+ * @param params ""
+ * @param nparams 0
+ * @return CMD_OK
+ */
+int adcs_tim_flush_stats(char* fmt, char* params, int nparams);
+
+/**
+ * Set the max. RMS truncation error of the cached IGRF model, it selects the
+ * lowest degree with an error below it
+ * @param fmt "%lf"
+ * @param params Max. error in nT, 0 to use the full degree
+ * @param nparams 1
+ * @return CMD_OK, or CMD_SYNTAX_ERROR
+ */
+int adcs_igrf_set_error(char* fmt, char* params, int nparams);
+
+/**
+ * Compare the cached IGRF model with IgrfCalc at a position and the current
+ * time, the Earth fixed field of both models and the difference are printed
+ * @param fmt "%lf %lf %lf"
+ * @param params Geodetic latitude [deg], longitude [deg] and altitude [km]
+ * @param nparams 3
+ * @return CMD_OK, or CMD_SYNTAX_ERROR
+ */
+int adcs_igrf_check(char* fmt, char* params, int nparams);
 #endif //_CMDADCS_H
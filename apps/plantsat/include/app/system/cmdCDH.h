@@ -12,16 +12,32 @@
 
 #define TM_TYPE_STRING 104
 #define TM_TYPE_PAYLOAD_STA 13
+#define TM_TYPE_PAYLOAD_DELTA 105
+#define TM_TYPE_BEACON_PACKED 106
+#define TM_TYPE_MSG_PACKED 107
+#define TM_TYPE_SCHEMA 108
+#define TM_SCHEMA_VERSION 1        ///< TM_TYPE_SCHEMA frame version
+#define TM_SCHEMA_LEN 13           ///< TM_TYPE_SCHEMA frame length in bytes
+
+#define TM_MSGS_TEXT_LEN DICT_COMP_MAX_DIST  ///< Max. raw messages bytes per packed messages frame
 
 #define SCH_TRX_PORT_CDH (SCH_TRX_PORT_APP+0)
 #define SCH_TRX_PORT_BCN (SCH_TRX_PORT_APP+3) //VERIFY VALUES IN ALL THE APPS INVOLVED BEFORE MODIFYING THIS NUMBER
 
+#include <stdlib.h>
+
 #include "app/system/config.h"
 #include "config.h"
 #include "suchai/globals.h"
 #include "suchai/log_utils.h"
 
 #include "suchai/repoCommand.h"
+#include "app/system/tmDelta.h"
+#include "app/system/beaconPack.h"
+#include "app/system/downlinkSched.h"
+#include "app/system/statusSnapshot.h"
+#include "app/system/recordStore.h"
+#include "app/system/msgPack.h"
 
 /**
  * Register command and data handling (C&DH) commands
@@ -56,6 +72,35 @@ int obc_cancel_deploy(char *fmt, char *params, int nparams);
  */
 int obc_update_status(char *fmt, char *params, int nparams);
 
+/**
+ * Write the dirty cached status variables to the storage
+ * @see statusSnapshot.h
+ * @param fmt ""
+ * @param params ""
+ * @param nparams 0
+ * @return CMD_OK, CMD_ERROR
+ */
+int obc_sts_flush(char *fmt, char *params, int nparams);
+
+/**
+ * Enable or disable the write-back cache of a status variable. Only the
+ * variables in the write-back list can be cached (see statusSnapshot.c).
+ * @param fmt "%d %d"
+ * @param params <address> <enable>
+ * @param nparams 2
+ * @return CMD_OK, CMD_SYNTAX_ERROR
+ */
+int obc_sts_cache(char *fmt, char *params, int nparams);
+
+/**
+ * Print the cached status variables and cache statistics
+ * @param fmt ""
+ * @param params ""
+ * @param nparams 0
+ * @return CMD_OK
+ */
+int obc_sts_print(char *fmt, char *params, int nparams);
+
 /**
  * Helper function to read the basic status variables (E.g. to send as a beacon)
  * @param status_data Structure to fill with data.
@@ -73,7 +118,7 @@ int obc_read_status_basic(status_data_t *status_data);
 int tm_send_msg(char *fmt, char *params, int nparams);
 
 /**
- * Parses a string message
+ * Parses a string message and stores it in the records store
  * @param fmt ""
  * @param params <>
  * @param nparams 0
@@ -82,7 +127,33 @@ int tm_send_msg(char *fmt, char *params, int nparams);
 int tm_parse_msg(char *fmt, char *params, int nparams);
 
 /**
- * Sends a status basic struct
+ * Sends stored messages packed in TM_TYPE_MSG_PACKED frames, as many whole
+ * dictionary compressed messages per frame as fit (see msgPack.h). A message
+ * that does not fit compressed is sent alone in an uncompressed frame.
+ * @param fmt "%d %d %d"
+ * @param params <node> <first> <max_frames>
+ * first: First message id, -1 for the oldest retained message
+ * max_frames: Max. number of frames to send, 0 for all messages
+ * @param nparams 3
+ * @return CMD_OK if executed correctly
+ */
+int tm_send_msgs(char *fmt, char *params, int nparams);
+
+/**
+ * Sends the schema hashes in a TM_TYPE_SCHEMA frame, so the ground station
+ * can check that it parses this satellite telemetry with the same payloads
+ * layout (see repoDataSchema.h). Frame layout, big endian:
+ * | version | first payload (0) | payloads | status vars (2) | layout hash (4) | payloads hash (4) |
+ * @param fmt "%d"
+ * @param params <node>
+ * @param nparams 1
+ * @return CMD_OK if executed correctly
+ */
+int tm_send_schema(char *fmt, char *params, int nparams);
+
+/**
+ * Sends a status basic struct as a bit-packed beacon (TM_TYPE_BEACON_PACKED)
+ * @see beaconPack.h
  * @param fmt "%d"
  * @param params <node>
  * @param nparams 1
@@ -91,11 +162,67 @@ int tm_parse_msg(char *fmt, char *params, int nparams);
 int tm_send_beacon(char *fmt, char *params, int nparams);
 
 /**
- * Parses a status basic struct
+ * Parses a status basic struct, either bit-packed (TM_TYPE_BEACON_PACKED) or
+ * as a full struct (TM_TYPE_PAYLOAD_STA)
  * @param fmt ""
  * @param params <>
  * @param nparams 0
  * @return CMD_OK if executed correctly
  */
 int tm_parse_beacon(char *fmt, char *params, int nparams);
+
+/**
+ * Send payload samples as delta compressed frames (TM_TYPE_PAYLOAD_DELTA).
+ * Sends up to <n_samples> samples of <payload> starting from the last
+ * acknowledged sample. Payloads with string fields are not supported.
+ * @see tmDelta.h
+ * @param fmt "%d %d %d"
+ * @param params <node> <payload> <n_samples>
+ * @param nparams 3
+ * @return CMD_OK if executed correctly, CMD_ERROR in case of failures, or CMD_SYNTAX_ERROR in case of parameters errors
+ */
+int tm_send_pay_delta(char *fmt, char *params, int nparams);
+
+/**
+ * Run a downlink pass with the priority classed scheduler. Sends pending
+ * (not acknowledged) samples of all payloads, highest priority class first,
+ * until the class budgets or <max_bytes> are used.
+ * @see downlinkSched.h
+ * @param fmt "%d %d"
+ * @param params <node> <max_bytes>
+ * max_bytes: Max. bytes to send in this pass, 0 for no limit
+ * @param nparams 2
+ * @return CMD_OK if executed correctly, CMD_ERROR in case of failures, or CMD_SYNTAX_ERROR in case of parameters errors
+ */
+int tm_send_pass(char *fmt, char *params, int nparams);
+
+/**
+ * Configure a downlink priority class
+ * @param fmt "%d %d %d"
+ * @param params <class> <priority> <budget>
+ * priority: Base priority, higher is served first
+ * budget: Max. bytes per pass, 0 for no limit
+ * @param nparams 3
+ * @return CMD_OK if executed correctly, or CMD_SYNTAX_ERROR in case of parameters errors
+ */
+int tm_set_dl_class(char *fmt, char *params, int nparams);
+
+/**
+ * Assign a payload to a downlink priority class
+ * @param fmt "%d %d"
+ * @param params <payload> <class>
+ * class: Class id, or -1 to not send this payload in passes
+ * @param nparams 2
+ * @return CMD_OK if executed correctly, or CMD_SYNTAX_ERROR in case of parameters errors
+ */
+int tm_set_dl_payload(char *fmt, char *params, int nparams);
+
+/**
+ * Print the downlink classes and the last pass results
+ * @param fmt ""
+ * @param params ""
+ * @param nparams 0
+ * @return CMD_OK
+ */
+int tm_print_dl(char *fmt, char *params, int nparams);
 #endif //_CMDCDH_H
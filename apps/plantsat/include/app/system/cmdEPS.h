@@ -16,6 +16,9 @@
 
 #include "suchai/repoCommand.h"
 #include "suchai/repoData.h"
+#include "app/system/recordStore.h"
+#include "app/system/sampleBuffer.h"
+#include "app/system/statusSnapshot.h"
 
 /**
  * Register EPS commands
@@ -17,6 +17,7 @@
 #include "suchai/globals.h"
 #include "suchai/log_utils.h"
 #include "app/drivers/rwdrv10987.h"
+#include "app/system/adcsDriver.h"
 
 //#include "config.h"
 //#include "osDelay.h"
@@ -31,6 +32,7 @@
 #endif
 
 #include "suchai/repoCommand.h"
+#include "app/system/eventRules.h"
 #include "os/os.h"
 
 typedef enum upper_istage_cmd_enum
@@ -23,6 +23,9 @@
 
 #include "suchai/repoCommand.h"
 #include "app/system/cmdCDH.h"
+#include "app/system/eventRules.h"
+#include "app/system/recordStore.h"
+#include "app/system/sampleBuffer.h"
 
 void cmd_sensors_init(void);
 
@@ -86,5 +89,114 @@ int sensors_get_eps(char *fmt, char *params, int nparams);
 int sensors_get_temperatures(char *fmt, char *params, int nparams);
 int sensors_get_status_basic(char *fmt, char *params, int nparams);
 
+/**
+ * Add, update or remove an on board aggregator. Computes min, max, mean and
+ * standard deviation of a payload field over a window of seconds and saves
+ * the summary as an agg_sensors payload sample.
+ * @param fmt "%d %d %d %d"
+ * @param params <payload> <field> <window> <keep_raw>
+ * window: Window length in seconds (max. 65535), use 0 to remove the
+ * aggregator and save its open window summary
+ * keep_raw: 1 to keep saving raw samples, 0 to save only the summaries
+ * @param nparams 4
+ * @code
+ * // Mean of ekf gyro_x (field 2) every 60 seconds, do not save raw samples
+ * sen_agg_set 7 2 60 0
+ * @endcode
+ * @return CMD_OK, CMD_ERROR if the field or window is not valid or the table is full
+ */
+int sensors_agg_set(char *fmt, char *params, int nparams);
+
+/**
+ * Close all aggregator windows and save the summaries
+ * @param fmt ""
+ * @param params ""
+ * @param nparams 0
+ * @return CMD_OK
+ */
+int sensors_agg_flush(char *fmt, char *params, int nparams);
+
+/**
+ * Print the active aggregators
+ * @param fmt ""
+ * @param params ""
+ * @param nparams 0
+ * @return CMD_OK
+ */
+int sensors_agg_list(char *fmt, char *params, int nparams);
+
+/**
+ * Write the open records block and the open payload pages to the storage
+ * (see recordStore.h and sampleBuffer.h)
+ * @param fmt "%d"
+ * @param params <max_age>
+ * max_age: Write the block or page only if it is older than max_age seconds.
+ *          Use 0 to write them anyway (e.g. before a reset).
+ * @param nparams 1
+ * @return CMD_OK, CMD_ERROR if a block or page could not be written
+ */
+int sensors_buff_flush(char *fmt, char *params, int nparams);
+
+/**
+ * Set the retention policy of a payload table (see payloadRetention.h)
+ * @param fmt "%d %d"
+ * @param params <payload> <policy>
+ * policy: 0 ring (overwrite oldest), 1 keep first, 2 decimate older data.
+ *         Ring and decimate need a storage that overwrites slots (RAM)
+ * @param nparams 2
+ * @return CMD_OK, CMD_SYNTAX_ERROR, CMD_ERROR if the policy is not available or
+ * the table is more than half full
+ */
+int sensors_set_retention(char *fmt, char *params, int nparams);
+
+/**
+ * Print the payload tables retention policies and usage
+ * @param fmt ""
+ * @param params ""
+ * @param nparams 0
+ * @return CMD_OK
+ */
+int sensors_print_retention(char *fmt, char *params, int nparams);
+
+/**
+ * Add or update a payload field event rule (see eventRules.h)
+ * @param fmt "%d %d %d %f %d %d"
+ * @param params <payload> <field> <type> <threshold> <boost_step> <boost_time>
+ * type: 0 above, 1 below, 2 rate of change, 3 deadband
+ * boost_step: Sampling step while boosted [s], 0 for no boost
+ * boost_time: Boost duration [s]
+ * @param nparams 6
+ * @return CMD_OK, CMD_SYNTAX_ERROR, CMD_ERROR if the field is not valid or the table is full
+ */
+int sensors_evt_set(char *fmt, char *params, int nparams);
+
+/**
+ * Remove a payload field event rule
+ * @param fmt "%d %d %d"
+ * @param params <payload> <field> <type>
+ * @param nparams 3
+ * @return CMD_OK, CMD_SYNTAX_ERROR, CMD_ERROR if the rule does not exist
+ */
+int sensors_evt_del(char *fmt, char *params, int nparams);
+
+/**
+ * Save raw samples of a payload only while an event rule fires or a boost is
+ * active
+ * @param fmt "%d %d"
+ * @param params <payload> <gate>
+ * @param nparams 2
+ * @return CMD_OK, CMD_SYNTAX_ERROR
+ */
+int sensors_evt_gate(char *fmt, char *params, int nparams);
+
+/**
+ * Print the event rules
+ * @param fmt ""
+ * @param params ""
+ * @param nparams 0
+ * @return CMD_OK
+ */
+int sensors_evt_list(char *fmt, char *params, int nparams);
+
 
 #endif /* _CMD_SENS_H */
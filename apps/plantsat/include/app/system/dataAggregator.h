@@ -0,0 +1,107 @@
+/**
+ * @file  dataAggregator.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the on board payload aggregators. An
+ * aggregator computes the min, max, mean and standard deviation of one field
+ * of a payload over a window of N seconds and stores the result as an
+ * agg_data_t sample (agg_sensors payload). Summaries can be downloaded first
+ * and the raw samples only on demand, or not stored at all.
+ *
+ * Payload samples must be saved with agg_add_payload_sample (or
+ * evt_add_payload_sample, see eventRules.h) instead of dat_add_payload_sample
+ * to feed the aggregators. Samples are stored with the payload retention
+ * policy (payloadRetention.h).
+ */
+
+#ifndef _DATA_AGGREGATOR_H
+#define _DATA_AGGREGATOR_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "suchai/config.h"
+#include "suchai/repoData.h"
+#include "suchai/osSemaphore.h"
+#include "suchai/log_utils.h"
+#include "app/system/payloadRetention.h"
+
+#define AGG_MAX_AGGREGATORS 16      ///< Max. number of active aggregators
+
+/**
+ * An aggregator configuration and its current window
+ */
+typedef struct agg_state {
+    int16_t payload;        ///< Source payload id, -1 if the slot is free
+    uint8_t field;          ///< Field index in the payload data_map
+    uint8_t keep_raw;       ///< Also save raw samples (1) or only the summary (0)
+    uint16_t window;        ///< Window length in seconds
+    uint32_t start;         ///< Current window start time
+    uint32_t count;         ///< Samples in the current window
+    float min;
+    float max;
+    double mean;            ///< Running mean (Welford)
+    double m2;              ///< Running sum of squared differences (Welford)
+} agg_state_t;
+
+/**
+ * Initialize the aggregators table with the default aggregators
+ * @return 0 if OK, -1 in case of errors
+ */
+int agg_init(void);
+
+/**
+ * Add, update or remove an aggregator
+ * @param payload Source payload id
+ * @param field Field index, as in the payload data_map types string
+ * @param window Window length in seconds, up to UINT16_MAX. Use 0 to remove
+ * the aggregator, its open window summary is saved first
+ * @param keep_raw 1 to also save the raw samples, 0 to save only summaries
+ * @return 0 if OK, -1 in case of errors (invalid field or window, or table full)
+ */
+int agg_set(int payload, int field, int window, int keep_raw);
+
+/**
+ * Read a numeric field of a payload sample
+ * @param data Pointer to payload struct, or NULL to only check the field
+ * @param payload Payload id
+ * @param field Field index, as in the payload data_map types string
+ * @param value Field value, can be NULL
+ * @return 0 if OK, -1 if the field does not exist or is not numeric
+ */
+int agg_get_field(void *data, int payload, int field, float *value);
+
+/**
+ * Feed the aggregators of a payload with a sample, without saving it
+ * @param data Pointer to payload struct
+ * @param payload Payload id
+ * @return 1 if the raw sample should be saved (no aggregators or some
+ * aggregator with keep_raw = 1), 0 otherwise
+ */
+int agg_feed_payload_sample(void *data, int payload);
+
+/**
+ * Save a payload sample. The sample feeds the aggregators of the payload and
+ * is saved in the repository unless all the payload aggregators have
+ * keep_raw = 0. Closed windows are saved as agg_sensors samples.
+ * @param data Pointer to payload struct
+ * @param payload Payload id
+ * @return 0 if OK, -1 in case of errors
+ */
+int agg_add_payload_sample(void *data, int payload);
+
+/**
+ * Close all open windows and save the summaries
+ * @return Number of summaries saved
+ */
+int agg_flush(void);
+
+/**
+ * Print the aggregators table
+ */
+void agg_print(void);
+
+#endif //_DATA_AGGREGATOR_H
@@ -0,0 +1,79 @@
+/**
+ * @file  dictComp.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the static dictionary compressor used for
+ * short ASCII and binary messages (string messages, IoT, AIS and ADS-B
+ * records). Messages are too short to compress well on their own, so the
+ * encoder also matches against a fixed dictionary of common substrings that
+ * is compiled in both the flight and the ground software. Both sides must
+ * use the same dictionary, identified by DICT_COMP_ID.
+ *
+ * The compressed stream is a list of byte oriented tokens that reference the
+ * dictionary followed by the already decoded bytes:
+ * @code
+ * | 00LLLLLL | literal (L+1 bytes) |                  literal run, 1 to 64 bytes
+ * | 010LLLLL | digits ((L+2)/2 bytes) |               hex run, 1 to 32 uppercase hex digits
+ * | 011LLLLL | 6-bit chars ((6L+13)/8 bytes) |        AIS 6-bit run, 1 to 32 armored characters
+ * | 1MMMMDDD | DDDDDDDD |                              match, M+3 bytes at distance D
+ * @endcode
+ * Hex runs store two digits per byte and 6-bit runs four AIS payload
+ * characters ('0'-'W', '`'-'w') in three bytes, high bits first, because the
+ * Mode S and AIS payloads are random but use a reduced alphabet.
+ * Matches are 3 to 18 bytes long and their distance [1, 2047] is counted
+ * back from the current position in the dictionary + history + output
+ * buffer. The encoder does not use extra memory and the decoder only needs
+ * the output buffer.
+ */
+
+#ifndef _DICT_COMP_H
+#define _DICT_COMP_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define DICT_COMP_ID 1              ///< Dictionary version, change when the dictionary changes
+#define DICT_COMP_MIN_MATCH 3       ///< Min. match length in bytes
+#define DICT_COMP_MAX_MATCH 18      ///< Max. match length in bytes
+#define DICT_COMP_MAX_LITERALS 64   ///< Max. literal run length in bytes
+#define DICT_COMP_MIN_PACKED 4      ///< Min. hex or 6-bit run length in characters
+#define DICT_COMP_MAX_PACKED 32     ///< Max. hex or 6-bit run length in characters
+#define DICT_COMP_TOKEN_HEX 0x40    ///< Hex run token
+#define DICT_COMP_TOKEN_SIX 0x60    ///< AIS 6-bit run token
+#define DICT_COMP_MAX_DIST 2047     ///< Max. match distance in bytes
+
+/**
+ * Get the dictionary length
+ * @return Dictionary length in bytes
+ */
+int dict_comp_len(void);
+
+/**
+ * Compress a message. Previous messages stored just before it in the same
+ * buffer (history) are also used as dictionary, so related messages
+ * compressed one after the other compress better.
+ * @param in History and message buffer
+ * @param hist History length in bytes, the message starts at in + hist
+ * @param len Message length in bytes
+ * @param out Output buffer
+ * @param max Output buffer length in bytes
+ * @return Compressed length, or -1 if it does not fit in the output buffer
+ */
+int dict_compress(const uint8_t *in, int hist, int len, uint8_t *out, int max);
+
+/**
+ * Decompress a message
+ * @param in Compressed bytes
+ * @param len Compressed length in bytes
+ * @param out History and message buffer, must have the same history used to
+ * compress the message
+ * @param hist History length in bytes, the message is written at out + hist
+ * @param max Output buffer length in bytes, including the history
+ * @return Message length, or -1 if the stream is not valid or does not fit in
+ * the output buffer
+ */
+int dict_decompress(const uint8_t *in, int len, uint8_t *out, int hist, int max);
+
+#endif //_DICT_COMP_H
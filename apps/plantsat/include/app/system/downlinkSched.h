@@ -0,0 +1,86 @@
+/**
+ * @file  downlinkSched.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the payload downlink scheduler. Each payload
+ * belongs to a priority class and each class has a byte budget per pass.
+ * During a pass, frames are filled from the highest priority class with
+ * pending samples (not acknowledged) and remaining budget. Classes waiting
+ * with pending data age one point per frame sent by other class, so lower
+ * classes are not starved by a large backlog of a higher class.
+ *
+ * Numeric payloads are sent as delta compressed frames (TM_TYPE_PAYLOAD_DELTA,
+ * see tmDelta.h), other payloads as raw TM_TYPE_PAYLOAD frames.
+ */
+
+#ifndef _DOWNLINK_SCHED_H
+#define _DOWNLINK_SCHED_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "suchai/config.h"
+#include "suchai/repoData.h"
+#include "suchai/log_utils.h"
+#include "suchai/cmdCOM.h"
+#include "app/system/tmDelta.h"
+#include "app/system/payloadRetention.h"
+
+#define DL_SCHED_NCLASSES 4         ///< Number of priority classes
+#define DL_SCHED_CLASS_CRITICAL 0   ///< Health data: status, eps, temperatures
+#define DL_SCHED_CLASS_SUMMARY 1    ///< Aggregated data and low rate sensors
+#define DL_SCHED_CLASS_ADCS 2       ///< ADCS high rate data
+#define DL_SCHED_CLASS_BULK 3       ///< Everything else
+
+/**
+ * Priority class configuration and pass state
+ */
+typedef struct dl_class {
+    uint16_t priority;      ///< Base priority, higher is served first
+    uint16_t budget;        ///< Max. bytes per pass, 0 for unlimited
+    uint32_t sent;          ///< Bytes sent in the current pass
+    uint32_t age;           ///< Frames sent by other classes while this one was pending
+    int last_payload;       ///< Last payload served, for round robin inside the class
+} dl_class_t;
+
+/**
+ * Set the default classes and payload to class mapping
+ */
+void dl_sched_init(void);
+
+/**
+ * Configure a priority class
+ * @param class Class id [0, DL_SCHED_NCLASSES)
+ * @param priority Base priority, higher is served first
+ * @param budget Max. bytes per pass, 0 for unlimited
+ * @return 0 if OK, -1 if the class is not valid
+ */
+int dl_sched_set_class(int class, int priority, int budget);
+
+/**
+ * Assign a payload to a priority class. Use class -1 to never send it.
+ * @param payload Payload id
+ * @param class Class id, or -1 to disable
+ * @return 0 if OK, -1 if the payload or class are not valid
+ */
+int dl_sched_set_payload(int payload, int class);
+
+/**
+ * Run a downlink pass. Sends pending samples of all payloads from the last
+ * acknowledged index until all budgets are used or no data is pending.
+ * @param node Destination node
+ * @param port Destination port
+ * @param max_bytes Max. bytes to send in the pass, 0 for unlimited
+ * @return Number of bytes sent, or -1 in case of errors
+ */
+int dl_sched_pass(int node, int port, int max_bytes);
+
+/**
+ * Print the classes configuration and the last pass results
+ */
+void dl_sched_print(void);
+
+#endif //_DOWNLINK_SCHED_H
@@ -0,0 +1,129 @@
+/**
+ * @file  ekfMatrix.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of fixed size matrix kernels for the TRIAD
+ * EKF (10 states, 9 process noises and 7 measurements). The dimensions are
+ * compile time constants and the inner products are unrolled, so the
+ * compiler keeps the accumulators in registers and there is no index math,
+ * unlike the generic _mat_mat_mult from math_utils.
+ *
+ * The fused A·B·Aᵀ kernels assume B is symmetric (a covariance). They only
+ * compute the upper triangle of the result and mirror it, so the result is
+ * exactly symmetric.
+ *
+ * The innovation covariance S (7x7) is not inverted, it is factored as
+ * L·D·Lᵀ (L unit lower triangular, D diagonal) and the Kalman gain is found
+ * solving with the factors.
+ */
+
+#ifndef _EKF_MATRIX_H
+#define _EKF_MATRIX_H
+
+#include "suchai/math_utils.h"
+
+#define EKF_LDLT_OK 0                ///< Matrix is positive definite
+#define EKF_LDLT_NEAR_SINGULAR 1     ///< Matrix is positive definite but ill conditioned
+#define EKF_LDLT_NOT_PD (-1)         ///< Matrix is not positive definite, factors are not valid
+#define EKF_LDLT_MIN_RATIO 1e-12     ///< Min. ratio between the smallest and largest pivot
+
+/**
+ * 3x3 product, res = a·b. res can not be a or b.
+ */
+void ekf_mat3_mult(const matrix3_t *a, const matrix3_t *b, matrix3_t *res);
+
+/**
+ * 10x10 fused product, res = a·b·aᵀ, b symmetric. res can not be a or b.
+ */
+void ekf_mat10_abat(const matrix10_t *a, const matrix10_t *b, matrix10_t *res);
+
+/**
+ * 10x7 fused product, res = a·b·aᵀ (10x10), b symmetric (7x7)
+ */
+void ekf_mat10_7_abat(const matrix10_7_t *a, const matrix7_t *b, matrix10_t *res);
+
+/**
+ * 7x10 fused product, res = a·b·aᵀ (7x7), b symmetric (10x10)
+ */
+void ekf_mat7_10_abat(const matrix7_10_t *a, const matrix10_t *b, matrix7_t *res);
+
+/**
+ * 10x10 by 10x7 transposed product, res = a·bᵀ (10x7), b is 7x10
+ */
+void ekf_mat10_mult_7_10_t(const matrix10_t *a, const matrix7_10_t *b, matrix10_7_t *res);
+
+/**
+ * 10x7 by 7x10 product, res = a·b (10x10)
+ */
+void ekf_mat10_7_mult_7_10(const matrix10_7_t *a, const matrix7_10_t *b, matrix10_t *res);
+
+/**
+ * 10x7 matrix by vector product, res = a·v (10)
+ */
+void ekf_mat10_7_vec_mult(const matrix10_7_t *a, const double *v, double *res);
+
+/**
+ * Covariance propagation with the sparsity of the TRIAD EKF jacobians,
+ * res = f·p·fᵀ + l·q·lᵀ. The state is omega (0-2), quaternion (3-6) and gyro
+ * bias (7-9), so f is lower block triangular with the bias block equal to the
+ * identity, and l is block diagonal with a diagonal omega and bias blocks:
+ * @code
+ *     | Fw  0  0 |        | Lw  0  0 |
+ * f = | Fqw Fq 0 |    l = | 0  Lq  0 |
+ *     | 0   0  I |        | 0   0 Lb |
+ * @endcode
+ * Only the non zero elements of f and l are read, and only the upper triangle
+ * of res is computed and mirrored, so it takes about 860 multiply-adds
+ * instead of the 2850 of the dense fused products.
+ * @param f State transition jacobian (10x10)
+ * @param l Process noise jacobian (10x9)
+ * @param p Symmetric covariance (10x10), can not be res
+ * @param q Symmetric process noise covariance (9x9)
+ * @param res Propagated covariance (10x10)
+ */
+void ekf_mat10_propagate(const matrix10_t *f, const matrix10_9_t *l, const matrix10_t *p,
+                         const matrix9_t *q, matrix10_t *res);
+
+/**
+ * Scalar measurement update of a 10 state filter, for sequential updates with
+ * a diagonal measurement noise. Needs no matrix inverse, only a division by
+ * the innovation variance s = h·p·hᵀ + r:
+ * @code
+ * k = p·hᵀ / s,  x = x + k·(z - h·x),  p = p - (p·hᵀ)·(p·hᵀ)ᵀ / s
+ * @endcode
+ * Only the upper triangle of p is computed and mirrored.
+ * @param p Symmetric covariance (10x10), updated in place
+ * @param x State (10), updated in place
+ * @param h Measurement row (10)
+ * @param r Measurement noise variance
+ * @param z Measurement
+ * @return EKF_LDLT_OK, or EKF_LDLT_NOT_PD if s is not positive and p and x
+ * were not modified
+ */
+int ekf_mat10_scalar_update(matrix10_t *p, double *x, const double *h, double r, double z);
+
+/**
+ * LDLᵀ factorization of a 7x7 symmetric matrix, s = l·diag(d)·lᵀ. Only the
+ * lower triangle of s is used.
+ * @param s Symmetric matrix
+ * @param l Unit lower triangular factor, the upper triangle is set to zero
+ * @param d Diagonal factor (7)
+ * @return EKF_LDLT_OK, EKF_LDLT_NEAR_SINGULAR if the smallest pivot is lower
+ * than EKF_LDLT_MIN_RATIO times the largest one, or EKF_LDLT_NOT_PD if a
+ * pivot is not positive
+ */
+int ekf_mat7_ldlt(const matrix7_t *s, matrix7_t *l, double *d);
+
+/**
+ * Solve res·s = b (10x7) using the LDLᵀ factors of s, so res = b·s⁻¹ without
+ * computing the inverse.
+ * @param l Unit lower triangular factor from ekf_mat7_ldlt
+ * @param d Diagonal factor from ekf_mat7_ldlt
+ * @param b Right hand side
+ * @param res Solution, can be b
+ */
+void ekf_mat7_ldlt_solve_10(const matrix7_t *l, const double *d, const matrix10_7_t *b, matrix10_7_t *res);
+
+#endif //_EKF_MATRIX_H
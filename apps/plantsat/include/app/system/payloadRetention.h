@@ -0,0 +1,123 @@
+/**
+ * @file  payloadRetention.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the payload tables retention policies. Each
+ * payload table holds sbuf_get_capacity samples (see sampleBuffer.h), and
+ * samples are stored and read through the sample buffer. Database storage
+ * does not bound the tables, there samples are always appended and the
+ * policies have no effect. The payload index
+ * (data_map[payload].sys_index) counts the samples added, and the policy
+ * selects the storage slot of each sample:
+ *
+ *  - RET_POLICY_RING: sample i is stored at slot i % capacity, so the oldest
+ *    sample is overwritten. The acknowledge index is moved forward to the
+ *    oldest retained sample.
+ *  - RET_POLICY_KEEP_FIRST: sample i is stored at slot i, new samples are
+ *    dropped when the table is full.
+ *  - RET_POLICY_DECIMATE: the first half of the table is a ring with the
+ *    recent samples. When a sample leaves it, it is copied to a ring with one
+ *    of each two samples in the second half of the table. Older data ends up
+ *    with a lower sample rate than recent data, and the odd samples not in the
+ *    recent half are not retained (see ret_get_next).
+ *
+ * Each sample costs one slot write (two when decimating), slots are never
+ * rewritten in place except when a ring wraps around. RET_POLICY_RING and
+ * RET_POLICY_DECIMATE are only available if the storage overwrites a slot in
+ * place (SBUF_OVERWRITE, RAM storage). Flash storage can not write a slot
+ * again without erasing its whole section, so there all payloads use
+ * RET_POLICY_KEEP_FIRST.
+ *
+ * Payload samples must be read with ret_get_payload_sample to translate the
+ * indexes to storage slots. Framework commands reading the storage directly
+ * see storage slots, or pages with paged flash storage.
+ */
+
+#ifndef _PAYLOAD_RETENTION_H
+#define _PAYLOAD_RETENTION_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "suchai/config.h"
+#include "app/system/config.h"
+#include "suchai/repoData.h"
+#include "suchai/osSemaphore.h"
+#include "suchai/log_utils.h"
+#include "app/system/sampleBuffer.h"
+
+#define RET_POLICY_RING 0           ///< Overwrite the oldest sample
+#define RET_POLICY_KEEP_FIRST 1     ///< Drop new samples
+#define RET_POLICY_DECIMATE 2       ///< Halve the stored samples rate
+#define RET_POLICY_LAST 3           ///< Dummy element, the amount of policies
+
+/**
+ * Set the default payloads retention policies
+ * @return 0 if OK, -1 in case of errors
+ */
+int ret_init(void);
+
+/**
+ * Set the retention policy of a payload. The policy can only be changed
+ * while the table is at most half full, as all policies store the samples at
+ * the same slots until then.
+ * @param payload Payload id
+ * @param policy RET_POLICY_RING, RET_POLICY_KEEP_FIRST or RET_POLICY_DECIMATE
+ * @return 0 if OK, -1 if the payload or policy are not valid, the storage
+ * can not overwrite slots or the table is more than half full
+ */
+int ret_set_policy(int payload, int policy);
+
+/**
+ * Get the number of samples that fit in a payload table
+ * @param payload Payload id
+ * @return Table capacity in samples, 0 if the table is not bounded, or -1 if
+ * the payload is not valid
+ */
+int ret_get_capacity(int payload);
+
+/**
+ * Store a payload sample applying the payload retention policy. The sample
+ * index field (all payload structs start with it) is set to the payload index
+ * the sample is stored at.
+ * @param data Pointer to the payload struct
+ * @param payload Payload id
+ * @return 0 if OK or if the sample was dropped by the policy, -1 in case of errors
+ */
+int ret_add_payload_sample(void *data, int payload);
+
+/**
+ * Read a stored payload sample
+ * @param data Pointer to the payload struct to fill
+ * @param payload Payload id
+ * @param index Sample index
+ * @return 0 if OK, -1 in case of errors or if the sample is not retained
+ */
+int ret_get_payload_sample(void *data, int payload, int index);
+
+/**
+ * Get the first retained sample index from a given index, to skip the samples
+ * dropped by RET_POLICY_DECIMATE
+ * @param payload Payload id
+ * @param index Sample index
+ * @return First retained index not lower than index (index itself if it is
+ * not lower than the payload index), or -1 if the payload is not valid
+ */
+int ret_get_next(int payload, int index);
+
+/**
+ * Get the index of the oldest retained sample
+ * @param payload Payload id
+ * @return Oldest sample index, or -1 if the payload is not valid
+ */
+int ret_get_first(int payload);
+
+/**
+ * Print the payloads retention policies and tables usage
+ */
+void ret_print(void);
+
+#endif //_PAYLOAD_RETENTION_H
@@ -0,0 +1,91 @@
+/**
+ * @file  recordStore.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the variable length records store, used
+ * for store and forward messages. Records are appended to a RAM block
+ * (rec_block_t) and the block is stored in the rec_blocks payload table when
+ * the next record does not fit, so records only use their own length plus a
+ * 5 bytes header instead of a fixed SCH_ST_STR_SIZE slot.
+ *
+ * Each record has a sequential id. Blocks store the id of their first record
+ * and the number of records, so a record is found with a binary search over
+ * the stored blocks and a walk inside one block, without a per-record index.
+ *
+ * Record layout inside a block:
+ * @code
+ * | timestamp (4) | len | data (len bytes) |
+ * @endcode
+ */
+
+#ifndef _RECORD_STORE_H
+#define _RECORD_STORE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "suchai/config.h"
+#include "app/system/config.h"
+#include "suchai/repoData.h"
+#include "suchai/osSemaphore.h"
+#include "suchai/log_utils.h"
+#include "app/system/payloadRetention.h"
+
+#define REC_HEADER_LEN 5            ///< Record header length in bytes
+#define REC_MAX_LEN (REC_BLOCK_DATA_LEN - REC_HEADER_LEN)  ///< Max. record length in bytes, a record fits in one block
+
+/**
+ * Initialize the store, recovering the next record id from the last stored
+ * block
+ * @return 0 if OK, -1 in case of errors
+ */
+int rec_init(void);
+
+/**
+ * Append a record
+ * @param data Record bytes
+ * @param len Record length in bytes [1, REC_MAX_LEN]
+ * @param timestamp Record timestamp
+ * @return Record id, or -1 in case of errors
+ */
+int rec_add(const uint8_t *data, int len, uint32_t timestamp);
+
+/**
+ * Read a record. Reading the records in order reads each stored block once.
+ * @param id Record id
+ * @param data Output buffer
+ * @param max Output buffer length in bytes
+ * @param timestamp Record timestamp
+ * @return Record length (truncated to max), or -1 if the record does not
+ * exist or was not retained
+ */
+int rec_get(uint32_t id, uint8_t *data, int max, uint32_t *timestamp);
+
+/**
+ * Get the id of the next record, i.e. the number of records added
+ * @return Next record id
+ */
+uint32_t rec_get_next_id(void);
+
+/**
+ * Get the id of the oldest retained record
+ * @return Oldest record id
+ */
+uint32_t rec_get_first_id(void);
+
+/**
+ * Store the open block if it has records. Use it before a reset.
+ * @return 0 if OK, -1 in case of errors
+ */
+int rec_flush(void);
+
+/**
+ * Store the open block if its oldest record is older than max_age
+ * @param max_age Max. age in seconds
+ * @return 0 if OK, -1 in case of errors
+ */
+int rec_flush_old(int max_age);
+
+#endif //_RECORD_STORE_H
@@ -177,6 +177,26 @@ typedef enum dat_status_address_enum {
     dat_drp_ack_ctrl,             ///< ADS CTRL data index
     dat_drp_ack_str,              ///< String data acknowledge
 
+    /// Memory: Aggregated payload data
+    dat_drp_idx_agg,              ///< Aggregated data index
+    dat_drp_ack_agg,              ///< Aggregated data acknowledge
+
+    /// Memory: Variable length records blocks
+    dat_drp_idx_rec,              ///< Records blocks index
+    dat_drp_ack_rec,              ///< Records blocks acknowledge
+
+    /// Memory: Event telemetry
+    dat_drp_idx_evt,              ///< Events data index
+    dat_drp_ack_evt,              ///< Events data acknowledge
+
+    /// Memory: ADCS timing
+    dat_drp_idx_tim,              ///< ADCS timing data index
+    dat_drp_ack_tim,              ///< ADCS timing data acknowledge
+
+    /// ADS: EKF health
+    dat_ads_ekf_s_near_sing,      ///< EKF steps with a near singular innovation covariance
+    dat_ads_ekf_s_not_pd,         ///< EKF steps skipped, innovation covariance not positive definite
+
     /// Add a new status variables address here
     //dat_custom,                 ///< Variable description
 
@@ -221,133 +241,12 @@ typedef struct __attribute__((packed)) dat_sys_var_short {
 
 /**
  * List of status variables with address, name, type and default values
- * This list is useful to decide how to store and send the status variables
+ * This list is useful to decide how to store and send the status variables.
+ * Defined once in repoDataSchema.c.
  */
-static const dat_sys_var_t dat_status_list[] = {
-        {dat_rtc_date_time,     "rtc_date_time",     'd', DAT_IS_CONFIG, 0},          ///< RTC current unix time
-        {dat_obc_last_reset,    "obc_last_reset",    'u', DAT_IS_STATUS, 0},          ///< Last reset source
-        {dat_obc_opmode,        "obc_opmode",        'd', DAT_IS_CONFIG, DAT_OBC_OPMODE_NORMAL}, ///< General operation mode
-        {dat_obc_hrs_alive,     "obc_hrs_alive",     'u', DAT_IS_STATUS, 0},          ///< Hours since first boot
-        {dat_obc_hrs_wo_reset,  "obc_hrs_wo_reset",  'u', DAT_IS_STATUS, 0},          ///< Hours since last reset
-        {dat_obc_reset_counter, "obc_reset_counter", 'u', DAT_IS_STATUS, 0},          ///< Number of reset since first boot
-        {dat_obc_sw_wdt,        "obc_sw_wdt",        'u', DAT_IS_STATUS, 0},          ///< Software watchdog timer counter
-        {dat_obc_temp_1,        "obc_temp_1",        'f', DAT_IS_STATUS, -1},         ///< Temperature value of the first sensor
-        {dat_obc_executed_cmds, "obc_executed_cmds", 'u', DAT_IS_STATUS, 0},          ///< Execute commands counter
-        {dat_obc_failed_cmds,   "obc_failed_cmds",   'u', DAT_IS_STATUS, 0},          ///< Commands execute with errors counter
-        {dat_dep_deployed,      "dep_deployed",      'u', DAT_IS_STATUS, 0},          ///< Was the satellite deployed?
-        {dat_dep_ant_deployed,  "dep_ant_deployed",  'u', DAT_IS_STATUS, 1},          ///< Was the antenna deployed?
-        {dat_dep_date_time,     "dep_date_time",     'u', DAT_IS_STATUS, 0},          ///< Antenna deployment unix time
-        {dat_com_count_tm,      "com_count_tm",      'u', DAT_IS_STATUS, 0},          ///< Number of Telemetries sent
-        {dat_com_count_tc,      "com_count_tc",      'u', DAT_IS_STATUS, 0},          ///< Number of received Telecommands
-        {dat_com_last_tc,       "com_last_tc",       'd', DAT_IS_STATUS, 0},          ///< Unix time of the last received Telecommand
-        {dat_com_freq,          "com_freq",          'u', DAT_IS_CONFIG, SCH_TX_FREQ},       ///< Communications frequency [Hz]
-        {dat_com_tx_pwr,        "com_tx_pwr",        'u', DAT_IS_CONFIG, SCH_TX_PWR},        ///< TX power (0: 25dBm, 1: 27dBm, 2: 28dBm, 3: 30dBm)
-        {dat_com_baud,          "com_baud",          'u', DAT_IS_CONFIG, SCH_TX_BAUD},       ///< Baudrate [bps]
-        {dat_com_mode,          "com_mode",          'u', DAT_IS_CONFIG, 0},          ///< Framing mode (1: RAW, 2: ASM, 3: HDLC, 4: Viterbi, 5: GOLAY, 6: AX25)
-        {dat_com_bcn_period,    "com_bcn_period",    'u', DAT_IS_CONFIG, SCH_TX_BCN_PERIOD},  ///< Number of seconds between trx beacon packets
-        {dat_obc_bcn_offset,    "obc_bcn_offset",    'u', DAT_IS_CONFIG, SCH_OBC_BCN_OFFSET}, ///< Number of seconds between obc beacon packets
-        {dat_fpl_last,          "fpl_last",          'd', DAT_IS_STATUS, 0},          ///< Last executed flight plan (unix time)
-        {dat_fpl_queue,         "fpl_queue",         'u', DAT_IS_STATUS, 0},          ///< Flight plan queue length
-        {dat_ads_omega_x,       "ads_omega_x",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the x axis
-        {dat_ads_omega_y,       "ads_omega_y",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the y axis
-        {dat_ads_omega_z,       "ads_omega_z",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the z axis
-        {dat_ads_bias_x,       "ads_bias_x",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope bias value along the x axis
-        {dat_ads_bias_y,       "ads_bias_y",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope bias value along the y axis
-        {dat_ads_bias_z,       "ads_bias_z",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope bias value along the z axis
-        {dat_ads_mag_x,         "ads_mag_x",         'f', DAT_IS_STATUS, 0.0},         ///< Magnetometer value along the x axis
-        {dat_ads_mag_y,         "ads_mag_y",         'f', DAT_IS_STATUS, 0.0},         ///< Magnetometer value along the y axis
-        {dat_ads_mag_z,         "ads_mag_z",         'f', DAT_IS_STATUS, 0.0},         ///< Magnetometer value along the z axis
-        {dat_ads_pos_x,         "ads_pos_x",         'f', DAT_IS_STATUS, 0.0},         ///< Satellite orbit position x (ECI)
-        {dat_ads_pos_y,         "ads_pos_y",         'f', DAT_IS_STATUS, 0.0},         ///< Satellite orbit position y (ECI)
-        {dat_ads_pos_z,         "ads_pos_z",         'f', DAT_IS_STATUS, 0.0},         ///< Satellite orbit position z (ECI)
-        {dat_ads_vel_x,         "ads_pos_x",         'f', DAT_IS_STATUS, 0.0},         ///< Satellite orbit Velocity x (ECI)
-        {dat_ads_vel_y,         "ads_pos_y",         'f', DAT_IS_STATUS, 0.0},         ///< Satellite orbit Velocity y (ECI)
-        {dat_ads_vel_z,         "ads_pos_z",         'f', DAT_IS_STATUS, 0.0},         ///< Satellite orbit Velocity z (ECI)
-        {dat_ads_tle_epoch,     "ads_tle_epoch",     'd', DAT_IS_STATUS, 0},          ///< Current TLE epoch, 0 if TLE is invalid
-        {dat_ads_tle_last,      "ads_tle_last",      'u', DAT_IS_STATUS, 0},          ///< Last time position was propagated
-        {dat_ads_q0,            "ads_q0",            'f', DAT_IS_STATUS, 0.0},          ///< Attitude quaternion (Inertial to body)
-        {dat_ads_q1,            "ads_q1",            'f', DAT_IS_STATUS, 0.0},          ///< Attitude quaternion (Inertial to body)
-        {dat_ads_q2,            "ads_q2",            'f', DAT_IS_STATUS, 0.0},          ///< Attitude quaternion (Inertial to body)
-        {dat_ads_q3,            "ads_q3",            'f', DAT_IS_STATUS, 1.0},          ///< Attitude quaternion (Inertial to body)
-        {dat_tgt_omega_x,       "tgt_omega_x",       'f', DAT_IS_CONFIG, 0.0},          ///< Target acceleration value along the x axis
-        {dat_tgt_omega_y,       "tgt_omega_y",       'f', DAT_IS_CONFIG, 0.0},          ///< Target acceleration value along the y axis
-        {dat_tgt_omega_z,       "tgt_omega_z",       'f', DAT_IS_CONFIG, 0.0},          ///< Target acceleration value along the z axis
-        {dat_tgt_q0,            "tgt_q0",            'f', DAT_IS_CONFIG, 0.0},          ///< Target quaternion (Inertial to body)
-        {dat_tgt_q1,            "tgt_q1",            'f', DAT_IS_CONFIG, 0.0},          ///< Target quaternion (Inertial to body)
-        {dat_tgt_q2,            "tgt_q2",            'f', DAT_IS_CONFIG, 0.0},          ///< Target quaternion (Inertial to body)
-        {dat_tgt_q3,            "tgt_q3",            'f', DAT_IS_CONFIG, 1.0},          ///< Target quaternion (Inertial to body)
-        {dat_eps_vbatt,       "eps_vbatt",       'u', DAT_IS_STATUS, 0},          ///< Voltage of the battery [mV]
-        {dat_eps_cur_sun,     "eps_cur_sun",     'u', DAT_IS_STATUS, 0},          ///< Current from boost converters [mA]
-        {dat_eps_cur_sys,     "eps_cur_sys",     'u', DAT_IS_STATUS, 0},          ///< Current from the battery [mA]
-        {dat_eps_temp_bat0,   "eps_temp_bat0",   'd', DAT_IS_STATUS, 0},          ///< Battery temperature sensor
-        {dat_drp_idx_temp,    "drp_idx_temp",    'u', DAT_IS_STATUS, 0},          ///< Temperature data index
-        {dat_drp_idx_ads,     "drp_idx_ads",     'u', DAT_IS_STATUS, 0},          ///< ADS data index
-        {dat_drp_idx_eps,     "drp_idx_eps",     'u', DAT_IS_STATUS, 0},          ///< EPS data index
-        {dat_drp_idx_sta,     "drp_idx_sta",     'u', DAT_IS_STATUS, 0},          ///< Status data index
-        {dat_drp_idx_stt,       "drp_idx_stt",       'u', DAT_IS_STATUS, 0},          ///< STT data index
-        {dat_drp_idx_rw,        "drp_idx_rw",        'u', DAT_IS_STATUS, 0},          ///< RW data index
-        {dat_drp_idx_fss,       "drp_idx_fss",       'u', DAT_IS_STATUS, 0},          ///< ADS fss data index
-        {dat_drp_idx_ekf,       "drp_idx_ekf",       'u', DAT_IS_STATUS, 0},          ///< ADS ekf data index
-        {dat_drp_idx_ctrl, "drp_idx_ctrl", 'u', DAT_IS_STATUS, 0},
-        {dat_drp_ack_temp,      "drp_ack_temp",      'u', DAT_IS_CONFIG, 0},          ///< Temperature data acknowledge
-        {dat_drp_ack_ads,       "drp_ack_ads",       'u', DAT_IS_CONFIG, 0},          ///< ADS data index acknowledge
-        {dat_drp_ack_eps,       "drp_ack_eps",       'u', DAT_IS_CONFIG, 0},          ///< EPS data index acknowledge
-        {dat_drp_ack_sta,       "drp_ack_sta",       'u', DAT_IS_CONFIG, 0},          ///< Status data index acknowledge
-        {dat_drp_ack_stt,       "drp_ack_stt",       'u', DAT_IS_CONFIG, 0},          ///< Stt data index acknowledge
-        {dat_drp_ack_rw,        "drp_ack_rw",        'u', DAT_IS_CONFIG, 0},          ///< RW data acknowledge
-        {dat_drp_ack_fss,       "drp_ack_fss",   'u', DAT_IS_CONFIG, 0},          ///< ADS FSS data index acknowledge
-        {dat_drp_ack_ekf,       "drp_ack_ekf",   'u', DAT_IS_CONFIG, 0},          ///< ADS EKF data index acknowledge
-        {dat_drp_ack_ctrl, "drp_ack_ctrl", 'u', DAT_IS_CONFIG, 0},
-        {dat_drp_mach_action,   "drp_mach_action",   'u', DAT_IS_STATUS, 0},          ///<
-        {dat_drp_mach_state,    "drp_mach_state",    'u', DAT_IS_STATUS, 0},          ///<
-        {dat_drp_mach_left,     "drp_mach_left",     'u', DAT_IS_STATUS, 0},          ///<
-        {dat_drp_mach_step,     "drp_mach_step",     'd', DAT_IS_CONFIG, 0},          ///<
-        {dat_drp_mach_payloads, "drp_mach_payloads", 'u', DAT_IS_CONFIG, 0},           ///<
-        {dat_drp_idx_str,       "drp_idx_str",       'u', DAT_IS_STATUS, 0},          ///< String data index
-        {dat_drp_ack_str,       "drp_ack_str",       'u', DAT_IS_CONFIG, 0},          ///< String data acknowledge
-        {dat_calc_attitude,     "calc_attitude",     'd', DAT_IS_STATUS, 0},
-        {dat_activate_ekf, "activate_ekf", 'u', DAT_IS_STATUS, 0},
-        {dat_activate_ctrl, "activate_ctrl", 'u', DAT_IS_STATUS, 0},
-        {dat_time_to_attitude,  "time_to_attitude",  'u', DAT_IS_STATUS, 10},
-        {dat_inertia_xx,        "inertia_xx",        'f', DAT_IS_STATUS, 0.0},
-        {dat_inertia_yy,        "inertia_yy",        'f', DAT_IS_STATUS, 0.0},
-        {dat_inertia_zz,        "inertia_zz",        'f', DAT_IS_STATUS, 0.0},
-        {dat_inertia_xy,        "inertia_xy",        'f', DAT_IS_STATUS, 0.0},
-        {dat_inertia_xz,        "inertia_xz",        'f', DAT_IS_STATUS, 0.0},
-        {dat_inertia_yz,        "inertia_yz",        'f', DAT_IS_STATUS, 0.0},
-        {dat_inv_inertia_xx,        "inertia_xx",        'f', DAT_IS_STATUS, 0.0},
-        {dat_inv_inertia_yy,        "inertia_yy",        'f', DAT_IS_STATUS, 0.0},
-        {dat_inv_inertia_zz,        "inertia_zz",        'f', DAT_IS_STATUS, 0.0},
-        {dat_inv_inertia_xy,        "inertia_xy",        'f', DAT_IS_STATUS, 0.0},
-        {dat_inv_inertia_xz,        "inertia_xz",        'f', DAT_IS_STATUS, 0.0},
-        {dat_inv_inertia_yz,        "inertia_yz",        'f', DAT_IS_STATUS, 0.0},
-        {dat_inertia_rw,            "inertia_rw", 'f', DAT_IS_STATUS, 0.0},
-        {dat_ads_ekf_q0,            "ads_ekf_q0",            'f', DAT_IS_STATUS, 0.0},          ///< Attitude quaternion (Inertial to body)
-        {dat_ads_ekf_q1,            "ads_ekf_q1",            'f', DAT_IS_STATUS, 0.0},          ///< Attitude quaternion (Inertial to body)
-        {dat_ads_ekf_q2,            "ads_ekf_q2",            'f', DAT_IS_STATUS, 0.0},          ///< Attitude quaternion (Inertial to body)
-        {dat_ads_ekf_q3,            "ads_ekf_q3",            'f', DAT_IS_STATUS, 1.0},          ///< Attitude quaternion (Inertial to body)
-        {dat_ads_ekf_omega_x,       "ads_ekf_omega_x",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the x axis
-        {dat_ads_ekf_omega_y,       "ads_ekf_omega_y",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the y axis
-        {dat_ads_ekf_omega_z,       "ads_ekf_omega_z",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the z axis
-        {dat_ads_ekf_bias_x,       "ads_ekf_bias_x",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the x axis
-        {dat_ads_ekf_bias_y,       "ads_ekf_bias_y",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the y axis
-        {dat_ads_ekf_bias_z,       "ads_ekf_bias_z",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the z axis
-        //{dat_css_1,             "css_1",             'u', DAT_IS_STATUS, 0},                     ///< Coarse sun sensor value
-        {dat_css_2,             "css_2",             'u', DAT_IS_STATUS, 0},                       ///< Coarse sun sensor value
-        {dat_css_3,             "css_3",             'u', DAT_IS_STATUS, 0},                       ///< Coarse sun sensor value
-        {dat_css_4,             "css_4",             'u', DAT_IS_STATUS, 0},                       ///< Coarse sun sensor value
-        //{dat_css_5,             "css_5",             'u', DAT_IS_STATUS, 0},                       ///< Coarse sun sensor value
-        {dat_sun_vec_b_x,       "sun_vec_b_x",       'f', DAT_IS_STATUS, 0.0},                       ///< Coarse sun sensor value
-        {dat_sun_vec_b_y,       "sun_vec_b_y",       'f', DAT_IS_STATUS, 0.0},                       ///< Coarse sun sensor value
-        {dat_sun_vec_b_z,       "sun_vec_b_z",       'f', DAT_IS_STATUS, 0.0},                   ///< Coarse sun sensor value
-        {dat_time_delay_gyro, "ads_time_delay_gyro", 'u', DAT_IS_STATUS, 100},
-        {dat_time_delay_quat, "ads_time_delay_quat", 'u', DAT_IS_STATUS, 3000},
-        {dat_mtq_x_axis, "mtq_x_axis", 'f', DAT_IS_STATUS, 0.0},
-        {dat_mtq_y_axis, "mtq_y_axis", 'f', DAT_IS_STATUS, 0.0},
-        {dat_mtq_z_axis, "mtq_z_axis", 'f', DAT_IS_STATUS, 0.0}
-};
+extern const dat_sys_var_t dat_status_list[];
 ///< The dat_status_last_var constant serves for looping through all status variables
-static const int dat_status_last_var = sizeof(dat_status_list) / sizeof(dat_status_list[0]);
+extern const int dat_status_last_var;
 
 /**
  * Enum constants for dynamically identifying payload fields at execution time.
@@ -376,6 +275,10 @@ typedef enum payload_id {
     ekf_sensors,            ///< 7: Ads quat, omega
     ctrl_data,
     msg_sensors,          ///< 9: Store and forward msg
+    agg_sensors,            ///< 10: Aggregated payload fields (min, max, mean, stddev)
+    rec_blocks,             ///< 11: Variable length records (messages) blocks
+    evt_sensors,            ///< 12: Payload fields events (thresholds, rate of change, deadband)
+    tim_sensors,            ///< 13: ADCS loop stages timing (min, max, mean, p99)
     last_sensor             ///< Dummy element, the amount of payload variables
 } payload_id_t;
 
@@ -413,12 +316,6 @@ typedef struct __attribute__((__packed__)) temp_data {
     int16_t dummy;
 } temp_data_t; //2*4+26*2 bytes = 60
 
-static char temp_var_string[] = "sat_index timestamp obc_temp_1 obc_temp_2 obc_temp_3 eps_temp1 eps_temp2 eps_temp3 "
-                                  "eps_temp4 bat_temp1 bat_temp2 istage_temp1 istage_temp2 istage_temp3 istage_temp4 "
-                                  "spanel_temp1 spanel_temp2 spanel_temp3 spanel_temp4 dummy";
-
-static char temp_var_types[] = "%u %u %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h";
-
 /**
  * Struct for storing data collected by ads sensors.
  */
@@ -559,14 +456,6 @@ typedef struct __attribute__((__packed__)) sta_data {
     uint32_t dat_drp_mach_step;
 } status_data_t;
 
-static char status_var_string[] = "sat_index timestamp dat_obc_opmode rtc_date_time obc_last_reset obc_hrs_alive "
-                                  "obc_hrs_wo_reset obc_reset_counter obc_executed_cmds obc_failed_cmds com_count_tm "
-                                  "com_count_tc com_last_tc fpl_last fpl_queue ads_tle_epoch eps_vbatt eps_cur_sun "
-                                  "eps_cur_sys obc_temp_1 eps_temp_bat0 drp_mach_action drp_mach_state drp_mach_payloads "
-                                  "drp_mach_step";
-
-static char status_var_types[] = "%u %u %u %d %u %u %u %u %u %u %u %u %d %d %u %d %d %u %u %f %d %u %u %u %u";
-
 /**
  * Struct for storing rw data.
  */
@@ -590,23 +479,120 @@ typedef struct __attribute__((__packed__)) string_data {
     char msg[SCH_ST_STR_SIZE];
 } string_data_t;
 
-static data_map_t data_map[last_sensor] = {
-        {"dat_temp_data",    (uint16_t) (sizeof(temp_data_t)),    dat_drp_idx_temp, dat_drp_ack_temp, temp_var_types,                     temp_var_string},
-        {"dat_ads_data",     (uint16_t) (sizeof(ads_data_t)),     dat_drp_idx_ads,  dat_drp_ack_ads,  "%u %u %f %f %f %f %f %f %d %d %d", "sat_index timestamp acc_x acc_y acc_z mag_x mag_y mag_z sun2 sun3 sun4"},
-        {"dat_eps_data",     (uint16_t) (sizeof(eps_data_t)),     dat_drp_idx_eps,  dat_drp_ack_eps,  "%u %u %u %u %u %d %d",             "sat_index timestamp cursun cursys vbatt temp_eps temp_bat"},
-        {"dat_sta_data",     (uint16_t) (sizeof(status_data_t)),  dat_drp_idx_sta,  dat_drp_ack_sta,  status_var_types,                   status_var_string},
-        {"dat_stt_data",     (uint16_t) (sizeof(stt_data_t)),     dat_drp_idx_stt,  dat_drp_ack_stt,  "%u %u %f %f %f %d %f",             "sat_index timestamp ra dec roll time exec_time"},
-        {"dat_rw_data",      (uint16_t) (sizeof(temp_data_t)),    dat_drp_idx_rw,   dat_drp_ack_rw,   "%u %u %f %f %f %d %d %d",          "sat_index timestamp current1 current2 current3 speed1 speed2 speed3"},
-        {"dat_fss_data", (uint16_t) (sizeof(fss_data_t)), dat_drp_idx_fss, dat_drp_ack_fss,
-         "%u %u %f %f %f %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h",
-         "sat_index timestamp acc_x acc_y acc_z fss1_a fss1_b fss1_c fss1_d fss2_a fss2_b fss2_c fss2_d fss3_a fss3_b fss3_c fss3_d fss4_a fss4_b fss4_c fss4_d fss5_a fss5_b fss5_c fss5_d"},
-        {"dat_ekf_data",     (uint16_t) (sizeof(ekf_data_t)),     dat_drp_idx_ekf,  dat_drp_ack_ekf,
-         "%u %u %f %f %f %f %f %f %f %f %f %f",
-         "sat_index timestamp gyro_x gyro_y gyro_z mag_x mag_y mag_z q0 q1 q2 q3"},
-        {"dat_ctrl_data", (uint16_t) (sizeof(ctrl_data_t)), dat_drp_idx_ctrl, dat_drp_ack_ctrl, "%u %u %f %f %f %f %f %f",
-         "sat_index timestamp ctrl_x ctrl_y ctrl_z ctrl_hw_x, ctrl_hw_y, ctrl_hw_z"},
-         {"dat_msg_data",      (uint16_t) (sizeof(string_data_t)), dat_drp_idx_str,  dat_drp_ack_str,  "%u %u %s",                         "sat_index timestamp string_data"}
-};
+/**
+ * Struct for storing aggregated data. Summary of one payload field over a
+ * window of samples, see dataAggregator.h
+ */
+typedef struct __attribute__((__packed__)) agg_data {
+    uint32_t index;
+    uint32_t timestamp;             ///< Window end time
+    uint32_t payload;               ///< Source payload id
+    uint32_t field;                 ///< Source field index
+    uint32_t window;                ///< Window length [s]
+    uint32_t count;                 ///< Number of samples in the window
+    float min;
+    float max;
+    float mean;
+    float stddev;
+} agg_data_t;
+
+#define REC_BLOCK_DATA_LEN 240      ///< Records bytes per block
+
+/**
+ * Struct for storing variable length records (e.g. store and forward
+ * messages), packed in fixed size blocks, see recordStore.h
+ */
+typedef struct __attribute__((__packed__)) rec_block {
+    uint32_t index;
+    uint32_t timestamp;             ///< Block creation time
+    uint32_t first;                 ///< Id of the first record in the block
+    uint16_t count;                 ///< Number of records in the block
+    uint16_t used;                  ///< Used bytes of data
+    uint8_t data[REC_BLOCK_DATA_LEN];
+} rec_block_t;
+
+/**
+ * rec_block_t data_order and var_names. The records bytes are declared as
+ * REC_BLOCK_DATA_LEN / 4 raw 32 bits words, so they are stored as they are.
+ */
+#define REC_BLOCK_DATA_ORDER "%u %u %u %h %h " \
+        "%u %u %u %u %u %u %u %u %u %u %u %u %u %u %u " \
+        "%u %u %u %u %u %u %u %u %u %u %u %u %u %u %u " \
+        "%u %u %u %u %u %u %u %u %u %u %u %u %u %u %u " \
+        "%u %u %u %u %u %u %u %u %u %u %u %u %u %u %u"
+#define REC_BLOCK_VAR_NAMES "sat_index timestamp first count used " \
+        "data0 data1 data2 data3 data4 data5 data6 data7 data8 data9 " \
+        "data10 data11 data12 data13 data14 data15 data16 data17 data18 data19 " \
+        "data20 data21 data22 data23 data24 data25 data26 data27 data28 data29 " \
+        "data30 data31 data32 data33 data34 data35 data36 data37 data38 data39 " \
+        "data40 data41 data42 data43 data44 data45 data46 data47 data48 data49 " \
+        "data50 data51 data52 data53 data54 data55 data56 data57 data58 data59"
+
+/**
+ * Struct for storing payload field events, see eventRules.h
+ */
+typedef struct __attribute__((__packed__)) evt_data {
+    uint32_t index;
+    uint32_t timestamp;
+    uint32_t payload;               ///< Source payload id
+    uint32_t field;                 ///< Source field index
+    uint32_t type;                  ///< Rule type, EVT_FLAG_CLEAR if the condition ended
+    float value;                    ///< Field value
+    float ref;                      ///< Threshold, previous or last reported value
+} evt_data_t;
+
+/**
+ * Struct for storing ADCS loop stages timing, see adcsTiming.h
+ */
+typedef struct __attribute__((__packed__)) tim_data {
+    uint32_t index;
+    uint32_t timestamp;
+    uint32_t stage;                 ///< ADCS stage, adcs_tim_stage_t
+    uint32_t count;                 ///< Samples in the period
+    uint32_t min;                   ///< Min. duration [us]
+    uint32_t max;                   ///< Max. duration [us]
+    uint32_t mean;                  ///< Mean duration [us]
+    uint32_t p99;                   ///< 99th percentile duration [us], histogram bin limit
+} tim_data_t;
+
+/**
+ * Payloads storage map. Defined once in repoDataSchema.c, so runtime updates
+ * are seen by all modules.
+ */
+extern data_map_t data_map[last_sensor];
+
+/**
+ * Schema compatibility check. The flight and the ground software must agree
+ * on the payloads layout to store and parse telemetry. DAT_SCHEMA_LAYOUT_HASH
+ * is a compile time FNV-1a hash of the number of payloads and the size of
+ * each payload struct, in flight order and as used in data_map. It is linked
+ * in as dat_schema_layout_hash. dat_schema_hash also hashes the data_map
+ * field types at runtime. Both values are exchanged at the start of a
+ * session with TM_TYPE_SCHEMA frames (tm_send_schema, tm_parse_schema).
+ */
+#define DAT_SCHEMA_NPAYLOADS last_sensor  ///< Number of payloads of the flight schema
+#define DAT_SCHEMA_LAYOUT_NSIZES 14  ///< Sizes in DAT_SCHEMA_LAYOUT_HASH, add new payloads at the end
+#define DAT_SCHEMA_HASH_INIT 2166136261u
+#define DAT_SCHEMA_HASH_ADD(h, v) ((uint32_t)(((uint32_t)(h) ^ (uint32_t)(v)) * 16777619u))
+#define DAT_SCHEMA_LAYOUT_HASH \
+    DAT_SCHEMA_HASH_ADD(DAT_SCHEMA_HASH_ADD(DAT_SCHEMA_HASH_ADD(DAT_SCHEMA_HASH_ADD( \
+    DAT_SCHEMA_HASH_ADD(DAT_SCHEMA_HASH_ADD(DAT_SCHEMA_HASH_ADD(DAT_SCHEMA_HASH_ADD( \
+    DAT_SCHEMA_HASH_ADD(DAT_SCHEMA_HASH_ADD(DAT_SCHEMA_HASH_ADD(DAT_SCHEMA_HASH_ADD( \
+    DAT_SCHEMA_HASH_ADD(DAT_SCHEMA_HASH_ADD(DAT_SCHEMA_HASH_ADD(DAT_SCHEMA_HASH_INIT, DAT_SCHEMA_NPAYLOADS), \
+    sizeof(temp_data_t)), sizeof(ads_data_t)), sizeof(eps_data_t)), sizeof(status_data_t)), \
+    sizeof(stt_data_t)), sizeof(temp_data_t) /* rw, as in data_map */), sizeof(fss_data_t)), \
+    sizeof(ekf_data_t)), sizeof(ctrl_data_t)), sizeof(string_data_t)), sizeof(agg_data_t)), \
+    sizeof(rec_block_t)), sizeof(evt_data_t)), sizeof(tim_data_t))
+
+extern const uint32_t dat_schema_layout_hash;   ///< DAT_SCHEMA_LAYOUT_HASH of this build
+
+/**
+ * Hash the size and field types of a range of payloads of data_map
+ * @param first First payload (first = 0 in the flight software)
+ * @param n Number of payloads, usually DAT_SCHEMA_NPAYLOADS
+ * @return FNV-1a hash, or 0 if the range is not valid
+ */
+uint32_t dat_schema_hash(int first, int n);
 
 /** The repository's name */
 #define DAT_TABLE_STATUS "dat_status"      ///< Status variables table name
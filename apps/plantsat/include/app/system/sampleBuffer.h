@@ -0,0 +1,104 @@
+/**
+ * @file  sampleBuffer.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the payload samples write-combining buffer.
+ * With flash storage (SCH_STORAGE_MODE == SCH_ST_FLASH) the payload tables are
+ * stored as pages of SCH_ST_BUFF_SIZE bytes, each holding
+ * SCH_ST_BUFF_SIZE / data_map[payload].size samples. Samples are packed in a
+ * RAM page per payload and the page is written with one
+ * storage_payload_set_data call when it is full, when its oldest unwritten
+ * sample is older than SCH_ST_BUFF_MAX_AGE seconds (see sen_buff_flush) or
+ * before a reset (sbuf_flush). Samples of the open page are read from RAM and
+ * the last page read from the storage is kept, so sequential reads load each
+ * page once.
+ *
+ * The unused tail of a page is written as 0xFF (erased flash). A page written
+ * before it is full is written again later with the same bytes plus the new
+ * samples, which only programs erased bytes.
+ *
+ * With other storage modes, or if less than two samples of a payload fit in a
+ * page, each sample is written directly at its slot.
+ *
+ * Samples are addressed by storage slot, see payloadRetention.h for the
+ * mapping of sample indexes to slots.
+ */
+
+#ifndef _SAMPLE_BUFFER_H
+#define _SAMPLE_BUFFER_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "suchai/config.h"
+#include "app/system/config.h"
+#include "suchai/repoData.h"
+#include "suchai/osSemaphore.h"
+#include "suchai/log_utils.h"
+
+#if defined(SCH_ST_FLASH) && SCH_STORAGE_MODE == SCH_ST_FLASH
+#define SBUF_BOUNDED 1              ///< Tables hold SCH_SIZE_PER_SECTION * SCH_SECTIONS_PER_PAYLOAD bytes
+#define SBUF_OVERWRITE 0            ///< Written slots can not be written again without an erase
+#elif defined(SCH_ST_RAM) && SCH_STORAGE_MODE == SCH_ST_RAM
+#define SBUF_BOUNDED 1
+#define SBUF_OVERWRITE 1
+#else
+#define SBUF_BOUNDED 0              ///< Database tables grow with each sample
+#define SBUF_OVERWRITE 0            ///< Writing a slot again adds a row
+#endif
+
+#if defined(SCH_ST_FLASH) && SCH_STORAGE_MODE == SCH_ST_FLASH && SCH_ST_BUFF_SIZE > 0
+#define SBUF_PAGED 1                ///< Payload tables are stored as pages
+#else
+#define SBUF_PAGED 0
+#endif
+
+/**
+ * Initialize the payloads open pages
+ * @return 0 if OK, -1 in case of errors
+ */
+int sbuf_init(void);
+
+/**
+ * Get the number of samples that fit in a payload table
+ * @param payload Payload id
+ * @return Table capacity in samples, 0 if the storage does not bound the
+ * table (SBUF_BOUNDED is 0), or -1 if the payload is not valid
+ */
+int sbuf_get_capacity(int payload);
+
+/**
+ * Store a payload sample. With paged storage the sample is copied to the
+ * payload open page, and the page is written if it is full.
+ * @param payload Payload id
+ * @param slot Storage slot
+ * @param data Pointer to the payload struct
+ * @return 0 if OK, -1 in case of errors
+ */
+int sbuf_set_sample(int payload, int slot, void *data);
+
+/**
+ * Read a payload sample, from the open page if it is there
+ * @param payload Payload id
+ * @param slot Storage slot
+ * @param data Pointer to the payload struct to fill
+ * @return 0 if OK, -1 in case of errors
+ */
+int sbuf_get_sample(int payload, int slot, void *data);
+
+/**
+ * Write the open pages with unwritten samples. Use it before a reset.
+ * @return Number of pages written, or -1 in case of errors
+ */
+int sbuf_flush(void);
+
+/**
+ * Write the open pages whose oldest unwritten sample is older than max_age
+ * @param max_age Max. age in seconds
+ * @return Number of pages written, or -1 in case of errors
+ */
+int sbuf_flush_old(int max_age);
+
+#endif //_SAMPLE_BUFFER_H
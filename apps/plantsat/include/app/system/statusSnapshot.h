@@ -0,0 +1,128 @@
+/**
+ * @file  statusSnapshot.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This header have definitions of the status variables snapshot API. A
+ * snapshot copies a set of status variables (or the whole dat_status_list)
+ * into a caller buffer. Write-back variables (see below) are copied from the
+ * cache taking the snapshot lock once, so they are consistent with each
+ * other. The other variables are then read in one pass over the status table
+ * with the storage functions, without the snapshot lock and without taking
+ * the framework repository lock for each variable. They are not consistent
+ * with writes done meanwhile.
+ *
+ * Status variables can also be set as write-back. Only high rate variables
+ * written by this app can be cached (see sts_write_back_list), they must be
+ * written and read with the sts_* functions. Writes only update a RAM cache
+ * and set a dirty flag, and reads are served from the cache. Dirty variables
+ * are written to the storage by sts_flush, that is called every
+ * SCH_STS_FLUSH_PERIOD seconds and before a reset. Writing a write-through
+ * (critical) variable with sts_set_* requests a flush, housekeeping does it
+ * in the next second. Dirty values are copied before being written, so
+ * writers are not blocked by the storage and a failed write is retried in the
+ * next flush. Framework code reading the storage directly see write-back
+ * variables up to one flush period old. Set SCH_STS_FLUSH_PERIOD to 0 to
+ * disable the cache.
+ *
+ * The cache is double buffered. Each change is written to the inactive
+ * buffer with a sequence number and a hash and then it becomes the active
+ * one, so there is always a valid buffer. In the NANOMIND the buffers are in
+ * a .noinit section, so the dirty values survive a software or watchdog
+ * reset and are written after it.
+ */
+
+#ifndef _STATUS_SNAPSHOT_H
+#define _STATUS_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "suchai/config.h"
+#include "app/system/config.h"
+#include "suchai/repoData.h"
+#include "suchai/osSemaphore.h"
+#include "suchai/log_utils.h"
+
+#ifdef NANOMIND
+#define STS_RETAINED __attribute__((section(".noinit")))  ///< RAM not cleared at boot
+#else
+#define STS_RETAINED
+#endif
+
+/**
+ * Initialize the snapshot lock and the default write-back variables
+ * @return 0 if OK, -1 in case of errors
+ */
+int sts_init(void);
+
+/**
+ * Set a status variable, in the cache if it is a write-back variable
+ * @param address Status variable address
+ * @param value Value
+ * @return Same as dat_set_status_var, 0 for write-back variables
+ */
+int sts_set_status_var(dat_status_address_t address, value32_t value);
+
+/**
+ * Set an integer status variable, in the cache if it is a write-back variable
+ * @param address Status variable address
+ * @param value Value
+ * @return Same as dat_set_system_var, 0 for write-back variables
+ */
+int sts_set_system_var(dat_status_address_t address, int value);
+
+/**
+ * Get a status variable, from the cache if it is a write-back variable
+ * @param address Status variable address
+ * @return Variable value
+ */
+value32_t sts_get_status_var(dat_status_address_t address);
+
+/**
+ * Get an integer status variable, from the cache if it is a write-back variable
+ * @param address Status variable address
+ * @return Variable value
+ */
+int sts_get_system_var(dat_status_address_t address);
+
+/**
+ * Enable or disable the write-back mode of a status variable. When disabled,
+ * the pending value is written to the storage first.
+ * @param address Status variable address
+ * @param enable 1 to enable, 0 to disable
+ * @return 0 if OK, -1 if the address is not valid or can not be cached
+ */
+int sts_set_write_back(dat_status_address_t address, int enable);
+
+/**
+ * Write dirty write-back variables to the storage
+ * @return Number of variables written, or -1 in case of errors
+ */
+int sts_flush(void);
+
+/**
+ * Check if a critical variable was written and there are dirty variables
+ * @return 1 if sts_flush should be called, 0 otherwise
+ */
+int sts_flush_requested(void);
+
+/**
+ * Print the write-back variables and cache statistics
+ */
+void sts_print(void);
+
+/**
+ * Copy a set of status variables, taking the snapshot lock once and reading
+ * the storage once
+ * @param vars Array of status variables addresses, or NULL for all the
+ * variables in dat_status_list (values are stored in dat_status_list order)
+ * @param n Number of variables in vars, ignored if vars is NULL
+ * @param values Output array of at least n (or dat_status_last_var) values
+ * @return Number of variables copied, -1 in case of errors
+ */
+int sts_snapshot(const dat_status_address_t *vars, int n, value32_t *values);
+
+#endif //_STATUS_SNAPSHOT_H
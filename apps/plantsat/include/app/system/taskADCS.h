@@ -18,6 +18,12 @@
 #include "suchai/log_utils.h"
 
 #include "suchai/repoCommand.h"
+#include "app/system/eventRules.h"
+#include "app/system/statusSnapshot.h"
+#include "app/system/adcsTiming.h"
+#include "app/system/adcsSensors.h"
+#include "app/system/igrfCache.h"
+#include "app/system/adcsReference.h"
 #include "igrf/igrf13.h"
 #include "SGP4.h"
 
@@ -33,7 +39,29 @@ void calc_magnetic_model(double decyear, double latrad, double lonrad, double al
 
 double jd_to_dec(double jd);
 
+double fmod2p(double x);
+
+/**
+ * Convert a position to geodetic coordinates (WGS84) with the closed form of
+ * Vermeille (2004), without iterations. The measured error is below 1e-15 rad
+ * in latitude and 1e-8 m in altitude for altitudes from 0 to 2000 km.
+ * @param sat_pos Position, inertial frame [km]
+ * @param current_side Greenwich sidereal time [rad], 0 if sat_pos is Earth fixed
+ * @param lat_lon_alt Geodetic latitude [rad], longitude [rad] and altitude [km]
+ * @return 0
+ */
 int eci_to_geodetic(vector3_t sat_pos, double current_side, vector3_t * lat_lon_alt);
+
+/**
+ * Convert an array of positions to geodetic coordinates, see eci_to_geodetic
+ * @param sat_pos Positions, inertial frame [km]
+ * @param current_side Greenwich sidereal time of each position [rad], NULL if
+ * the positions are Earth fixed
+ * @param lat_lon_alt Geodetic latitude [rad], longitude [rad] and altitude [km]
+ * @param n Number of positions
+ * @return Number of positions converted
+ */
+int eci_to_geodetic_batch(const vector3_t * sat_pos, const double * current_side, vector3_t * lat_lon_alt, int n);
 void calc_adcs_model_parameters(unsigned int elapsed_msec, vector3_t * sat_pos_i, vector3_t * geod_vect,
                                 vector3_t * current_mag_i, int * isdark, vector3_t  * sun_pos_i);
 
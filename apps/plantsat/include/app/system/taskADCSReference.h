@@ -0,0 +1,34 @@
+/**
+ * @file  taskADCSReference.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This task fills the orbit-ahead ADCS reference table (see adcsReference.h)
+ * in the background, when the table is empty, is about to end or the TLE was
+ * updated. The table is only kept while the attitude is calculated
+ * (dat_calc_attitude) and a valid TLE is loaded (dat_ads_tle_epoch).
+ */
+
+#ifndef T_ADCS_REFERENCE_H
+#define T_ADCS_REFERENCE_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "suchai/config.h"
+#include "app/system/config.h"
+#include "suchai/globals.h"
+
+#include "suchai/osDelay.h"
+
+#include "suchai/repoCommand.h"
+#include "app/system/adcsReference.h"
+
+#define ADCS_REF_CHECK_MS 10000     ///< Period to check the table [ms]
+#define ADCS_REF_YIELD_MS 10        ///< Delay between nodes while filling a table [ms]
+
+void taskADCSReference(void *param);
+
+#endif //T_ADCS_REFERENCE_H
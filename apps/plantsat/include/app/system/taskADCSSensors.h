@@ -0,0 +1,44 @@
+/**
+ * @file  taskADCSSensors.h
+ * @author agent - agent@local
+ * @date 2026
+ * @copyright GNU GPL v3
+ *
+ * This task reads the ADCS sensors of a group at the periods of the ADCS
+ * loop (dat_time_delay_gyro and dat_time_delay_quat) and publishes each read
+ * to the sensor sample slot (see adcsSensors.h). The slow sun sensors read
+ * runs in its own task, so it does not delay the gyroscope reads. The sensors
+ * are only read while the attitude is calculated (dat_calc_attitude).
+ */
+
+#ifndef T_ADCS_SENSORS_H
+#define T_ADCS_SENSORS_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "suchai/config.h"
+#include "app/system/config.h"
+#include "suchai/globals.h"
+
+#include "suchai/osDelay.h"
+
+#include "suchai/repoCommand.h"
+#include "suchai/repoData.h"
+#include "app/system/adcsSensors.h"
+#include "app/system/adcsTiming.h"
+#include "app/system/adcsDriver.h"
+
+#define ADCS_SEN_TICK_MS 50         ///< Task period, reads are scheduled in multiples of it [ms]
+
+/**
+ * Sensor groups, one task per group. Use as the task param.
+ */
+typedef enum adcs_sen_group {
+    ADCS_SEN_GROUP_FAST = 0,        ///< Gyroscope and magnetometer
+    ADCS_SEN_GROUP_SUN,             ///< Coarse and fine sun sensors
+} adcs_sen_group_t;
+
+void taskADCSSensors(void *param);
+
+#endif //T_ADCS_SENSORS_H
@@ -15,12 +15,14 @@
 #include <stdint.h>
 
 #include "suchai/config.h"
+#include "app/system/config.h"
 #include "suchai/globals.h"
 
 #include "suchai/osQueue.h"
 #include "suchai/osDelay.h"
 
 #include "suchai/repoCommand.h"
+#include "app/system/statusSnapshot.h"
 
 void taskHousekeeping(void *param);
 
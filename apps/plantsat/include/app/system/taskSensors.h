@@ -17,6 +17,8 @@
 #include "suchai/osDelay.h"
 
 #include "suchai/repoCommand.h"
+#include "app/system/statusSnapshot.h"
+#include "app/system/eventRules.h"
 
 
 void taskSensors(void *param);
@@ -243,13 +243,16 @@ void estimate_omega_quat_with_triadekf(quaternion_t current_q_det, vector3_t cur
     printf("TRIAD: Omega pred\n");
     _get_sat_quaterion(&last_pred_q_i2b, dat_ads_ekf_q0);
     printf("Init STATE:ok\n");
+    ADCS_TIM_START(t_predict);
     // Propagate model
     attitude_discrete_model(last_pred_q_i2b, last_pred_omega_b, torque_b, dt, &pred_q_i2b,
                             &pred_omega_b, &Omega4x, &sk_omega_matrix);
     printf("Propagate model :ok\n");
     // Propagate P
     propagate_P_matrix(last_pred_q_i2b, last_pred_omega_b, Omega4x, sk_omega_matrix, dt, &F_j, &L_j, &P_j);
+    ADCS_TIM_STOP(ADCS_TIM_EKF_PREDICT, t_predict);
 
+    ADCS_TIM_START(t_update);
     // GET observer and measure
     z_observer = get_observer_model(pred_omega_b, pred_q_i2b, pred_bias_b);
     vector7_t measure_vector;
@@ -271,7 +274,7 @@ void estimate_omega_quat_with_triadekf(quaternion_t current_q_det, vector3_t cur
     quaternion_t q_ekf;
     vector3_t bias_ekf;
     double temp_kf[10];
-    _mat_vec_mult((double *) K_j.m, error_state.v, temp_kf, 10, 7);
+    ekf_mat10_7_vec_mult(&K_j, error_state.v, temp_kf);
     printf("NEW VECTOR STATE :ok\n");
     omega_ekf.v[0] = temp_kf[0]; omega_ekf.v[1] = temp_kf[1]; omega_ekf.v[2] = temp_kf[2];
     q_ekf.q[0] = temp_kf[3]; q_ekf.q[1] = temp_kf[4]; q_ekf.q[2] = temp_kf[5]; q_ekf.q[3] = temp_kf[6];
@@ -299,43 +302,97 @@ void estimate_omega_quat_with_triadekf(quaternion_t current_q_det, vector3_t cur
 
     // Update P
     update_covariance_P_matrix(K_j, P_j);
+    ADCS_TIM_STOP(ADCS_TIM_EKF_UPDATE, t_update);
 }
+
+void estimate_omega_quat_with_triadekf_seq(quaternion_t current_q_det, vector3_t current_omega_b, int new_q_det,
+                                           portTick delay_ms, quaternion_t * current_q_est_i2c,
+                                           vector3_t * current_omega_b_est){
+    vector3_t torque_b = {0 ,0, 0};
+    double dt = (double) delay_ms * 0.001;
+    quaternion_t pred_q_i2b = {0,0,0,1};
+    vector3_t pred_omega_b = {0,0,0};
+    quaternion_t last_pred_q_i2b = {0,0,0,1};
+    vector3_t last_pred_omega_b = {0,0,0};
+    vector3_t pred_bias_b = {0,0,0};
+    matrix3_t sk_omega_matrix;
+    matrix4_t Omega4x;
+    matrix10_t F_j;
+    matrix10_9_t L_j;
+
+    _get_sat_vector(&pred_bias_b, dat_ads_ekf_bias_x);
+    _mat_set_diag((double *) F_j.m, 0, 10, 10);
+    _mat_set_diag((double *) L_j.m, 0, 10, 9);
+    // init state
+    _get_sat_vector(&last_pred_omega_b, dat_ads_ekf_omega_x);
+    _get_sat_quaterion(&last_pred_q_i2b, dat_ads_ekf_q0);
+    ADCS_TIM_START(t_predict);
+    // Propagate model
+    attitude_discrete_model(last_pred_q_i2b, last_pred_omega_b, torque_b, dt, &pred_q_i2b,
+                            &pred_omega_b, &Omega4x, &sk_omega_matrix);
+    // Propagate P, the updates work over P_ in place
+    matrix10_t P_j;
+    propagate_P_matrix(last_pred_q_i2b, last_pred_omega_b, Omega4x, sk_omega_matrix, dt, &F_j, &L_j, &P_j);
+    P_ = P_j;
+    ADCS_TIM_STOP(ADCS_TIM_EKF_PREDICT, t_predict);
+    ADCS_TIM_START(t_update);
+
+    double x[10] = {pred_omega_b.v[0], pred_omega_b.v[1], pred_omega_b.v[2],
+                    pred_q_i2b.q[0], pred_q_i2b.q[1], pred_q_i2b.q[2], pred_q_i2b.q[3],
+                    pred_bias_b.v[0], pred_bias_b.v[1], pred_bias_b.v[2]};
+    vector7_t measure_vector = get_measure_as_vector(current_omega_b, current_q_det);
+
+    // One scalar update per measurement, R_ is diagonal. The gyro (0-2) is
+    // used every step and the TRIAD quaternion (3-6) only when it is new.
+    int n_meas = new_q_det ? 7 : 3;
+    for (int i = 0; i < n_meas; i++){
+        if(ekf_mat10_scalar_update(&P_, x, H_.m[i], R_.m[i][i], measure_vector.v[i]) == EKF_LDLT_NOT_PD){
+            dat_set_system_var(dat_ads_ekf_s_not_pd, dat_get_system_var(dat_ads_ekf_s_not_pd) + 1);
+            LOGW(tag, "Innovation variance %d is not positive, skipping", i);
+        }
+    }
+
+    ADCS_TIM_STOP(ADCS_TIM_EKF_UPDATE, t_update);
+
+    // save ESTIMATION
+    current_omega_b_est->v[0] = x[0];
+    current_omega_b_est->v[1] = x[1];
+    current_omega_b_est->v[2] = x[2];
+
+    current_q_est_i2c->q[0] = x[3];
+    current_q_est_i2c->q[1] = x[4];
+    current_q_est_i2c->q[2] = x[5];
+    current_q_est_i2c->q[3] = x[6];
+
+    vector3_t next_bias_est = {x[7], x[8], x[9]};
+    _set_sat_vector(&next_bias_est, dat_ads_ekf_bias_x);
+}
+
 void propagate_P_matrix(quaternion_t last_pred_q_i2b, vector3_t last_pred_omega_b, matrix4_t Omega4x, matrix3_t sk_omega_matrix,
                         double dt, matrix10_t * F_j, matrix10_9_t * L_j, matrix10_t * P_j){
-    matrix10_t P_j_1;
-    matrix10_t P_j_2;
     get_attitude_jacobian_model(last_pred_q_i2b, last_pred_omega_b, Omega4x, sk_omega_matrix, dt, F_j, L_j);
     printf("Propagate P:ok\n");
-    matrix10_t tempP;
-    _mat_mat_mult((double *) F_j->m, (double *) P_.m, (double *) &tempP.m, 10, 10, 10);
-    matrix10_t F_j_T;
-    printf("Transpose FJ:ok\n");
-    _mat_transpose((double *) F_j->m, (double *) &F_j_T.m, 10, 10);
-    _mat_mat_mult((double *) tempP.m, (double *) F_j_T.m, (double *) &P_j_1.m, 10, 10, 10);
-
-    matrix10_9_t tempL;
-    matrix9_10_t L_j_T;
-    printf("Transpose LJ:ok\n");
-    _mat_transpose((double *) L_j->m, (double *) &L_j_T.m, 10, 9);
-    _mat_mat_mult((double *) L_j->m, (double *) Q_.m, (double *) &tempL.m, 10, 9, 9);
-    _mat_mat_mult((double *) tempL.m, (double *) L_j_T.m, (double *) &P_j_2.m, 10, 9, 10);
-
-    _mat_mat_sum((double *) P_j_1.m, (double *) P_j_2.m, (double *) P_j->m, 10, 10);
+    // P_j = F·P·Fᵀ + L·Q·Lᵀ, only the non zero blocks of F and L
+    ekf_mat10_propagate(F_j, L_j, &P_, &Q_, P_j);
 }
 
 void update_covariance_P_matrix(matrix10_7_t K_j_, matrix10_t P_j_){
-    double temp_kH[10][10];
-    matrix10_t next_P;
-    _mat_mat_mult((double *) K_j_.m, (double *) H_.m, (double *) temp_kH, 10, 7, 10);
-    // mult by -1
+    matrix10_t temp_kH;
+    ekf_mat10_7_mult_7_10(&K_j_, &H_, &temp_kH);
+    // I - K·H
+    matrix10_t temp1;
     for (int i=0; i<10; i++){
         for (int j=0; j<10; j++){
-            temp_kH[i][j] = -1 * temp_kH[i][j];
+            temp1.m[i][j] = I_x10.m[i][j] - temp_kH.m[i][j];
         }
     }
-    double temp1[10][10];
-    _mat_mat_sum((double *) I_x10.m, (double *) temp_kH, (double *) temp1, 10, 10);
-    _mat_mat_mult((double *) temp1, (double *) P_j_.m, (double *) P_.m, 10, 10, 10);
+    // Joseph form, P = (I - K·H)·P_j·(I - K·H)ᵀ + K·R·Kᵀ, keeps P symmetric
+    // and positive semi-definite even if K is not the optimal gain
+    matrix10_t temp_ikh_p;
+    matrix10_t temp_krk;
+    ekf_mat10_abat(&temp1, &P_j_, &temp_ikh_p);
+    ekf_mat10_7_abat(&K_j_, &R_, &temp_krk);
+    _mat_mat_sum((double *) temp_ikh_p.m, (double *) temp_krk.m, (double *) P_.m, 10, 10);
 }
 
 vector7_t get_measure_as_vector(vector3_t current_omega_b_, quaternion_t current_q_det_){
@@ -359,30 +416,30 @@ void vec_sum_v7(vector7_t measure_vector, vector7_t z_observer, vector7_t * erro
 
 matrix10_7_t calc_kalman_gain(matrix10_t P_j, matrix7_t S_j){
     matrix10_7_t k_j;
-    double H_T[10][7];
-    printf("HT\n");
-    _mat_transpose((double *) H_.m, (double *) H_T, 7, 10);
-    double temp1[10][7];
-    printf("HT: ok\n");
-    _mat_mat_mult((double *) P_j.m, (double *) H_T, (double *) temp1, 10, 10, 7);
-    matrix7_t S_j_i;
-    printf("inverse S_j ....\n");
-    calc_inverse_matrix(S_j, &S_j_i);
-    printf("S_j_i: ok\n");
-    _mat_mat_mult((double *) temp1, (double *) S_j_i.m, (double *) &k_j.m, 10, 7, 7);
+    matrix10_7_t temp1;
+    ekf_mat10_mult_7_10_t(&P_j, &H_, &temp1);
+    // K = P·Hᵀ·S⁻¹, solved with the LDLᵀ factors of S instead of inverting S
+    matrix7_t S_l;
+    double S_d[7];
+    int rc = ekf_mat7_ldlt(&S_j, &S_l, S_d);
+    if(rc == EKF_LDLT_NOT_PD){
+        // Skip the measurement update, the covariance update keeps P_j
+        dat_set_system_var(dat_ads_ekf_s_not_pd, dat_get_system_var(dat_ads_ekf_s_not_pd) + 1);
+        LOGW(tag, "Innovation covariance is not positive definite, skipping update");
+        memset(&k_j, 0, sizeof(k_j));
+        return k_j;
+    }
+    if(rc == EKF_LDLT_NEAR_SINGULAR)
+        dat_set_system_var(dat_ads_ekf_s_near_sing, dat_get_system_var(dat_ads_ekf_s_near_sing) + 1);
+    ekf_mat7_ldlt_solve_10(&S_l, S_d, &temp1, &k_j);
     return k_j;
 }
 
 matrix7_t update_covariance_matrix(matrix10_t p_j){
     matrix7_t s_temp;
-    double H_T[10][7];
-    _mat_transpose((double *) H_.m, (double *) H_T, 7, 10);
-
-    double temp1[7][10];
-    _mat_mat_mult((double *) H_.m, (double *) p_j.m, (double *) temp1, 7, 10, 10);
-    double temp2[7][7];
-    _mat_mat_mult((double *) temp1, (double *) H_T, (double *) temp2, 7, 10, 7);
-    _mat_mat_sum((double *) temp2, (double *) R_.m, (double *) &s_temp.m, 7, 7);
+    matrix7_t temp2;
+    ekf_mat7_10_abat(&H_, &p_j, &temp2);
+    _mat_mat_sum((double *) temp2.m, (double *) R_.m, (double *) &s_temp.m, 7, 7);
     return s_temp;
 }
 
@@ -419,12 +476,12 @@ void get_attitude_jacobian_model(quaternion_t q_i2c, vector3_t omega_b, matrix4_
     mat_set_diag(&identity3x, 1.0, 1.0, 1.0);
     mat_set_diag4x(&identity4x, 1.0, 1.0, 1.0, 1.0);
 
-    mat_mat_mult(sk_omega_matrix, Inertia_ekf, &aux_m);
+    ekf_mat3_mult(&sk_omega_matrix, &Inertia_ekf, &aux_m);
     mat_vec_mult(Inertia_ekf, omega_b, &temp1);
     matrix3_t sk_h_moment = skewsymmetricmatrix(temp1);
     mat_cons_mult(-1.0, &sk_h_moment, NULL);
     mat_mat_sum(aux_m, sk_h_moment, &temp2);
-    mat_mat_mult(inv_Inertia_ekf, temp2, &temp3);
+    ekf_mat3_mult(&inv_Inertia_ekf, &temp2, &temp3);
     mat_cons_mult(-1 * dt, &temp3, NULL);
     mat_mat_sum(identity3x, temp3, &f_j_1);
 
@@ -531,8 +588,6 @@ void estimate_omega_with_triadekf(quaternion_t current_q_det, vector3_t current_
     matrix4_t Omega4x;
     matrix10_t F_j;
     matrix10_9_t L_j;
-    matrix10_t P_j_1;
-    matrix10_t P_j_2;
     matrix10_t P_j;
     matrix7_t S_j;
     matrix10_7_t K_j;
@@ -544,10 +599,6 @@ void estimate_omega_with_triadekf(quaternion_t current_q_det, vector3_t current_
     printf("Init F\n");
     _mat_set_diag((double *) L_j.m, 0, 10, 9);
     printf("Init L\n");
-    _mat_set_diag((double *) P_j_1.m, 0, 10, 10);
-    printf("Init P1 \n");
-    _mat_set_diag((double *) P_j_2.m, 0, 10, 10);
-    printf("Init P2\n");
     _mat_set_diag((double *) P_j.m, 0, 10, 10);
     printf("Init P total\n");
     // init state
@@ -555,6 +606,7 @@ void estimate_omega_with_triadekf(quaternion_t current_q_det, vector3_t current_
     printf("TRIAD: Omega pred\n");
     _get_sat_quaterion(&last_pred_q_i2b, dat_ads_ekf_q0);
     printf("Init STATE:ok\n");
+    ADCS_TIM_START(t_predict);
     // Propagate model
     attitude_discrete_model(last_pred_q_i2b, last_pred_omega_b, torque_b, dt, &pred_q_i2b,
                             &pred_omega_b, &Omega4x, &sk_omega_matrix);
@@ -562,21 +614,11 @@ void estimate_omega_with_triadekf(quaternion_t current_q_det, vector3_t current_
     // Propagate P
     get_attitude_jacobian_model(last_pred_q_i2b, last_pred_omega_b, Omega4x, sk_omega_matrix, dt, &F_j, &L_j);
     printf("Propagate P:ok\n");
-    matrix10_t tempP;
-    _mat_mat_mult((double *) F_j.m, (double *) P_.m, (double *) &tempP.m, 10, 10, 10);
-    matrix10_t F_j_T;
-    _mat_transpose((double *) F_j.m, (double *) &F_j_T.m, 10, 10);
-    _mat_mat_mult((double *) tempP.m, (double *) F_j_T.m, (double *) &P_j_1.m, 10, 10, 10);
-
-    matrix10_9_t tempL;
-    matrix9_10_t L_j_T;
-
-    _mat_transpose((double *) L_j.m, (double *) &L_j_T.m, 10, 9);
-    _mat_mat_mult((double *) L_j.m, (double *) Q_.m, (double *) &tempL.m, 10, 9, 9);
-    _mat_mat_mult((double *) tempL.m, (double *) L_j_T.m, (double *) &P_j_2.m, 10, 9, 10);
-
-    _mat_mat_sum((double *) P_j_1.m, (double *) P_j_2.m, (double *) &P_j.m, 10, 10);
+    // P_j = F·P·Fᵀ + L·Q·Lᵀ, only the non zero blocks of F and L
+    ekf_mat10_propagate(&F_j, &L_j, &P_, &Q_, &P_j);
+    ADCS_TIM_STOP(ADCS_TIM_EKF_PREDICT, t_predict);
 
+    ADCS_TIM_START(t_update);
     // GET observer and measure
     z_observer = get_observer_model(pred_omega_b, pred_q_i2b, pred_bias_b);
     vector7_t measure_vector;
@@ -594,7 +636,7 @@ void estimate_omega_with_triadekf(quaternion_t current_q_det, vector3_t current_
     quaternion_t q_ekf;
     vector3_t bias_ekf;
     double temp_kf[10];
-    _mat_vec_mult((double *) K_j.m, error_state.v, temp_kf, 10, 7);
+    ekf_mat10_7_vec_mult(&K_j, error_state.v, temp_kf);
 
     omega_ekf.v[0] = temp_kf[0]; omega_ekf.v[1] = temp_kf[1]; omega_ekf.v[2] = temp_kf[2];
     q_ekf.q[0] = temp_kf[3]; q_ekf.q[1] = temp_kf[4]; q_ekf.q[2] = temp_kf[5]; q_ekf.q[3] = temp_kf[6];
@@ -622,6 +664,7 @@ void estimate_omega_with_triadekf(quaternion_t current_q_det, vector3_t current_
 
     // Update P
     update_covariance_P_matrix(K_j, P_j);
+    ADCS_TIM_STOP(ADCS_TIM_EKF_UPDATE, t_update);
 }
 
 quaternion_t calc_with_wahbas_problem(vector3_t unit_sun_vector_b, vector3_t unit_mag_vector_b,
@@ -0,0 +1,454 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2022, Carlos Gonzalez Cortes, carlgonz@ug.uchile.cl
+ *      Copyright 2022, Elias Obreque Sepulveda, elias.obreque@uchile.cl
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/adcsDriver.h"
+
+static const char *tag = "adcsDrv";
+
+static osSemaphore drv_sem[ADCS_DRV_LAST];
+
+#define DRV_LOCK(dev) osSemaphoreTake(&drv_sem[(dev)], portMAX_DELAY)
+#define DRV_UNLOCK(dev) osSemaphoreGiven(&drv_sem[(dev)])
+
+// Parametric calibration parameters [h x0 y0 rho]
+static double cal1[4] = {0.52544,-0.033188,0.022875,-0.0038183}; // uid : 1523358639 - B23 - 0x20
+static double cal2[4] = {0.53262,0.0053791,-0.015919,-0.0055018}; // uid : 1523289023 - A28 - 0x21
+static double cal3[4] = {0.52578,-0.020189,-0.0097265,-0.0098635}; // uid : 1523358910 - B24 - 0x22
+static double cal4[4] = {0.51447,-0.028293,0.0060877,0.0028711}; // uid : 1523359548 - A29 - 0x23
+static double cal5[4] = {0.52768,0.031435,-0.023118,-0.0060699}; // uid : 1523357329 - C17 - 0x24
+
+static double T1[4][4];
+static double T2[4][4];
+static double T3[4][4];
+static double T4[4][4];
+static double T5[4][4];
+
+// position and orientation of FSS (0x20: +X, 0x21: -Y, 0x22: -X, 0x23: +Y, 0x24: -Z)
+static quaternion_t q_c2b_fss1 = {1, 0, 0, 0};
+static quaternion_t q_c2b_fss2 = {0.707106781, -0.707106781, 0, 0};
+static quaternion_t q_c2b_fss3 = {0, 1 ,0 , 0};
+static quaternion_t q_c2b_fss4 = {0.707106781, 0.707106781, 0, 0};
+static quaternion_t q_c2b_fss5 = {0.5, -0.5, -0.5, 0.5};
+
+int adcs_drv_init(void)
+{
+    int i;
+    for(i = 0; i < ADCS_DRV_LAST; i++)
+    {
+        if(osSemaphoreCreate(&drv_sem[i]) != OS_SEMAPHORE_OK)
+        {
+            LOGE(tag, "Unable to create ADCS device %d mutex", i);
+            return ADCS_DRV_ERROR;
+        }
+    }
+
+    // Matrix of calibration of FSS
+    T1[0][0] = cos(cal1[3]); T1[0][1] = sin(cal1[3]);
+    T1[1][0] = -sin(cal1[3]); T1[1][1] = cos(cal1[3]);
+    T2[0][0] = cos(cal2[3]); T2[0][1] = sin(cal2[3]);
+    T2[1][0] = -sin(cal2[3]); T2[1][1] = cos(cal2[3]);
+    T3[0][0] = cos(cal3[3]); T3[0][1] = sin(cal3[3]);
+    T3[1][0] = -sin(cal3[3]); T3[1][1] = cos(cal3[3]);
+    T4[0][0] = cos(cal4[3]); T4[0][1] = sin(cal4[3]);
+    T4[1][0] = -sin(cal4[3]); T4[1][1] = cos(cal4[3]);
+    T5[0][0] = cos(cal5[3]); T5[0][1] = sin(cal5[3]);
+    T5[1][0] = -sin(cal5[3]); T5[1][1] = cos(cal5[3]);
+    return ADCS_DRV_OK;
+}
+
+int adcs_drv_read_gyro(vector3_t *omega)
+{
+#ifdef NANOMIND
+    gs_mpu3300_gyro_t gyro_reading;
+    DRV_LOCK(ADCS_DRV_GYRO);
+    int result = gs_mpu3300_read_gyro(&gyro_reading);
+    DRV_UNLOCK(ADCS_DRV_GYRO);
+    if(result != 0)
+        return ADCS_DRV_ERROR;
+
+    vector3_t bias_sensor_omega_b;
+    _get_sat_vector(&bias_sensor_omega_b, dat_ads_bias_x);
+    omega->v0 = gyro_reading.gyro_x + bias_sensor_omega_b.v[0];
+    omega->v1 = gyro_reading.gyro_y + bias_sensor_omega_b.v[1];
+    omega->v2 = gyro_reading.gyro_z + bias_sensor_omega_b.v[2];
+    return ADCS_DRV_OK;
+#endif
+    return ADCS_DRV_ERROR;
+}
+
+int adcs_drv_read_mag(vector3_t *mag)
+{
+#ifdef NANOMIND
+    gs_hmc5843_data_t hmc_reading;
+    DRV_LOCK(ADCS_DRV_MAG);
+    gs_error_t result = gs_hmc5843_read_single(&hmc_reading);
+    DRV_UNLOCK(ADCS_DRV_MAG);
+    if(result != GS_OK)
+        return ADCS_DRV_ERROR;
+
+    mag->v0 = hmc_reading.x; // nano Tesla
+    mag->v1 = hmc_reading.y; // nT
+    mag->v2 = hmc_reading.z; // nT
+    return ADCS_DRV_OK;
+#endif
+    return ADCS_DRV_ERROR;
+}
+
+int adcs_drv_read_sun(vector3_t *sun_dir)
+{
+    uint16_t sun1 = 300, sun2 = 500, sun3 = 500, sun4 = 500, sun5 = 500;
+    int css_ok = 0, fss_ok = 0;
+    vector3_t ss_unit_b = {0, 0, 0};
+    // FSS
+    uint16_t sun_fss1[4] = {2,2,2,2};
+    uint16_t sun_fss2[4] = {1,1,1,1};
+    uint16_t sun_fss3[4] = {1,1,1,1};
+    uint16_t sun_fss4[4] = {2,2,2,2};
+    uint16_t sun_fss5[4] = {1,1,1,1};
+
+    double selected_face_axis[3] = {0,0,0}; // 0 if positive face, 1 if negative face of each axis
+    vector3_t sun_vec_b_fss = {0, 0, 0};
+    uint32_t sum_all_fss[5];
+    int rc1 = 0; int rc2 = 0; int rc3 = 0; int rc4 = 0; int rc5 = 0;
+
+    DRV_LOCK(ADCS_DRV_SUN);
+    #ifdef NANOMIND
+    gs_a3200_pwr_switch_enable(GS_A3200_PWR_GSSB);
+    gs_a3200_pwr_switch_enable(GS_A3200_PWR_GSSB2);
+    osDelay(30);
+
+    //int rc1 = gs_gssb_istage_get_sun_voltage(0x10, 100, &sun1);
+    //int rc2 = gs_gssb_istage_get_sun_voltage(0x11, 100, &sun2);
+    //int rc3 = gs_gssb_istage_get_sun_voltage(0x12, 100, &sun3);
+    //int rc4 = gs_gssb_istage_get_sun_voltage(0x13, 100, &sun4);
+    //int rc5 = 0;
+
+    if (SCH_DEVICE_ID == 2) {
+        LOGD(tag, "SUCHAI 2 - FSS");
+        // position and orientation of FSS (0x20: +X, 0x21: -Y, 0x22: -X, 0x23: +Y, 0x24: -Z)
+        //rc5 = gs_gssb_istage_get_sun_voltage(0x14, 100, &sun5);
+        int timei2c = 1000;
+        if (gs_gssb_sun_sample_sensor(0x20, timei2c) != GS_OK)
+        {
+            DRV_UNLOCK(ADCS_DRV_SUN);
+            return ADCS_DRV_ERROR;
+        }
+        osDelay(30);
+        int rf1 = gs_gssb_sun_read_sensor_samples(0x20, timei2c, sun_fss1);
+        osDelay(30);
+        if (gs_gssb_sun_sample_sensor(0x21, timei2c) != GS_OK)
+        {
+            DRV_UNLOCK(ADCS_DRV_SUN);
+            return ADCS_DRV_ERROR;
+        }
+        osDelay(30);
+        int rf2 = gs_gssb_sun_read_sensor_samples(0x21, timei2c, sun_fss2);
+        osDelay(30);
+        if (gs_gssb_sun_sample_sensor(0x22, timei2c) != GS_OK)
+        {
+            DRV_UNLOCK(ADCS_DRV_SUN);
+            return ADCS_DRV_ERROR;
+        }
+        osDelay(30);
+        int rf3 = gs_gssb_sun_read_sensor_samples(0x22, timei2c, sun_fss3);
+        osDelay(30);
+        if (gs_gssb_sun_sample_sensor(0x23, timei2c) != GS_OK)
+        {
+            DRV_UNLOCK(ADCS_DRV_SUN);
+            return ADCS_DRV_ERROR;
+        }
+        osDelay(30);
+        int rf4 = gs_gssb_sun_read_sensor_samples(0x23, timei2c, sun_fss4);
+        osDelay(30);
+        if (gs_gssb_sun_sample_sensor(0x24, timei2c) != GS_OK)
+        {
+            DRV_UNLOCK(ADCS_DRV_SUN);
+            return ADCS_DRV_ERROR;
+        }
+        osDelay(30);
+        int rf5 = gs_gssb_sun_read_sensor_samples(0x24, timei2c, sun_fss5);
+        osDelay(200);
+
+        if(rf1 != 0 || rf2 != 0 || rf3 != 0 || rf4 != 0 || rf5 != 0)
+        {
+            LOGE(tag, "Error reading fine sun sensors (%d, %d, %d, %d, %d)", rf1, rf2, rf3, rf4, rf5);
+            //return CMD_ERROR;
+        }else{
+            fss_ok = 1;
+            // face axis selection
+            sum_all_fss[0] = sun_fss1[0] + sun_fss1[1] + sun_fss1[2] + sun_fss1[3];
+            sum_all_fss[1] = sun_fss2[0] + sun_fss2[1] + sun_fss2[2] + sun_fss2[3];
+            sum_all_fss[2] = sun_fss3[0] + sun_fss3[1] + sun_fss3[2] + sun_fss3[3];
+            sum_all_fss[3] = sun_fss4[0] + sun_fss4[1] + sun_fss4[2] + sun_fss4[3];
+            sum_all_fss[4] = sun_fss5[0] + sun_fss5[1] + sun_fss5[2] + sun_fss5[3];
+            // position and orientation of FSS (0x20: +X, 0x21: -Y, 0x22: -X, 0x23: +Y, 0x24: -Z)
+            if (sum_all_fss[0] < sum_all_fss[2]){
+                selected_face_axis[0] = 0;
+            }else{
+                selected_face_axis[0] = 0;
+            }
+            if (sum_all_fss[1] < sum_all_fss[3]){
+                selected_face_axis[1] = 0;
+            }else{
+                selected_face_axis[1] = 1;
+            }
+            selected_face_axis[2] = 1;
+        }
+    }
+    if(rc1 != 0 || rc2 != 0 || rc3 != 0 || rc4 != 0 || rc5 != 0)
+    {
+        LOGE(tag, "Error reading coarse sun sensors (%d, %d, %d, %d, %d)", rc1, rc2, rc3, rc4, rc5);
+        //return CMD_ERROR;
+    }else{css_ok = 1;}
+#endif
+    if (css_ok)
+    {
+        uint16_t Ix = sun3;
+        uint16_t Iy = sun2;
+        uint16_t Iz = sun4;
+
+        uint16_t noise_thr = 10; // [uA]
+
+        if (Ix < noise_thr && Iy < noise_thr && Iz < noise_thr)
+        {
+            // shadow
+            ss_unit_b.v1 = 0, ss_unit_b.v0= 0, ss_unit_b.v2 = 0;
+        }else if (Iz < noise_thr) {
+            // ignore incomplete observations
+            ss_unit_b.v1 = 0, ss_unit_b.v0= 0, ss_unit_b.v2 = 0;
+        }
+        else{
+            ss_unit_b.v0 = -Ix, ss_unit_b.v1 = -Iy, ss_unit_b.v2 = Iz;
+            vec_normalize(&ss_unit_b, NULL);
+        }
+    }
+    if (fss_ok && SCH_DEVICE_ID == 2) {
+        double vec_d_x_1[2];
+        double vec_d_x_2[2];
+        double vec_d_y_1[2];
+        double vec_d_y_2[2];
+        double vec_d_z_2[2];
+
+        // position and orientation of FSS ([0x20: +X], [0x21: -Y], [0x22: -X], [0x23: +Y], [0x24: -Z])
+        // FSS 0x20
+        double num_1 = sun_fss1[0] + sun_fss1[1] - sun_fss1[2] - sun_fss1[3];
+        double num_2 = sun_fss1[0] + sun_fss1[3] - sun_fss1[1] - sun_fss1[2];
+        double den = sun_fss1[0] + sun_fss1[1] + sun_fss1[2] + sun_fss1[3];
+        vec_d_x_1[0] = num_1 / den + cal1[1];
+        vec_d_x_1[1] = num_2 / den + cal1[2];
+
+        // FSS 0x22
+        num_1 = sun_fss3[0] + sun_fss3[1] - sun_fss3[2] - sun_fss3[3];
+        num_2 = sun_fss3[0] + sun_fss3[3] - sun_fss3[1] - sun_fss3[2];
+        den = sun_fss3[0] + sun_fss3[1] + sun_fss3[2] + sun_fss3[3];
+        vec_d_x_2[0] = num_1 / den + cal3[1];
+        vec_d_x_2[1] = num_2 / den + cal3[2];
+
+        // FSS 0x23
+        num_1 = sun_fss4[0] + sun_fss4[1] - sun_fss4[2] - sun_fss4[3];
+        num_2 = sun_fss4[0] + sun_fss4[3] - sun_fss4[1] - sun_fss4[2];
+        den = sun_fss4[0] + sun_fss4[1] + sun_fss4[2] + sun_fss4[3];
+        vec_d_y_1[0] = num_1 / den + cal4[1];
+        vec_d_y_1[1] = num_2 / den + cal4[2];
+
+        // FSS 0x21
+        num_1 = sun_fss2[0] + sun_fss2[1] - sun_fss2[2] - sun_fss2[3];
+        num_2 = sun_fss2[0] + sun_fss2[3] - sun_fss2[1] - sun_fss2[2];
+        den = sun_fss2[0] + sun_fss2[1] + sun_fss2[2] + sun_fss2[3];
+        vec_d_y_2[0] = num_1 / den + cal2[1];
+        vec_d_y_2[1] = num_2 / den + cal2[2];
+
+        // FSS 0x24
+        vec_d_z_2[0] = (sun_fss5[0] + sun_fss5[1] - sun_fss5[2] - sun_fss5[3]) / (sun_fss5[0] + sun_fss5[1] + sun_fss5[2] + sun_fss5[3]) + cal5[1];
+        vec_d_z_2[1] = (sun_fss5[0] + sun_fss5[3] - sun_fss5[1] - sun_fss5[2]) / (sun_fss5[0] + sun_fss5[1] + sun_fss5[2] + sun_fss5[3]) + cal5[2];
+
+
+        double vec_dx_1[2], vec_dy_1[2], vec_dz_2[2], vec_dx_2[2], vec_dy_2[2];
+        _mat_vec_mult((double *) T1, vec_d_x_1, (double *) &vec_dx_1, 2, 2);
+        _mat_vec_mult((double *) T3, vec_d_x_2, (double *) &vec_dx_2, 2, 2);
+        _mat_vec_mult((double *) T4, vec_d_y_1, (double *) &vec_dy_1, 2, 2);
+        _mat_vec_mult((double *) T2, vec_d_y_2, (double *) &vec_dy_2, 2, 2);
+        _mat_vec_mult((double *) T5, vec_d_z_2, (double *) &vec_dz_2, 2, 2);
+
+        double phi_x_1 = atan2(vec_dx_1[0], vec_dx_1[1]); double theta_x_1 = atan(sqrt(vec_dx_1[0] * vec_dx_1[0] + vec_dx_1[1] * vec_dx_1[1]) / cal1[0]);
+        double phi_x_2 = atan2(vec_dx_2[0], vec_dx_2[1]); double theta_x_2 = atan(sqrt(vec_dx_2[0] * vec_dx_2[0] + vec_dx_2[1] * vec_dx_2[1]) / cal3[0]);
+        double phi_y_1 = atan2(vec_dy_1[0], vec_dy_1[1]); double theta_y_1 = atan(sqrt(vec_dy_1[0] * vec_dy_1[0] + vec_dy_1[1] * vec_dy_1[1]) / cal4[0]);
+        double phi_y_2 = atan2(vec_dy_2[0], vec_dy_2[1]); double theta_y_2 = atan(sqrt(vec_dy_2[0] * vec_dy_2[0] + vec_dy_2[1] * vec_dy_2[1]) / cal2[0]);
+        double phi_z_2 = atan2(vec_dz_2[0], vec_dz_2[1]); double theta_z_2 = atan(sqrt(vec_dz_2[0] * vec_dz_2[0] + vec_dx_2[1] * vec_dx_2[1]) / cal5[0]);
+
+        vector3_t sun_vec_cx_1, sun_vec_cy_1, sun_vec_cx_2, sun_vec_cy_2, sun_vec_cz_2;
+        sun_vec_cx_1.v[0] = cos(theta_x_1); sun_vec_cx_1.v[1] = sin(theta_x_1) * cos(phi_x_1); sun_vec_cx_1.v[2] = sin(theta_x_1) * sin(phi_x_1);
+        sun_vec_cx_2.v[0] = cos(theta_x_2); sun_vec_cx_2.v[1] = sin(theta_x_2) * cos(phi_x_2); sun_vec_cx_2.v[2] = sin(theta_x_2) * sin(phi_x_2);
+        sun_vec_cy_1.v[0] = cos(theta_y_1); sun_vec_cy_1.v[1] = sin(theta_y_1) * cos(phi_y_1); sun_vec_cy_1.v[2] = sin(theta_y_1) * sin(phi_y_1);
+        sun_vec_cy_2.v[0] = cos(theta_y_2); sun_vec_cy_2.v[1] = sin(theta_y_2) * cos(phi_y_2); sun_vec_cy_2.v[2] = sin(theta_y_2) * sin(phi_y_2);
+        sun_vec_cz_2.v[0] = cos(theta_z_2); sun_vec_cz_2.v[1] = sin(theta_z_2) * cos(phi_z_2); sun_vec_cz_2.v[2] = sin(theta_z_2) * sin(phi_z_2);
+
+        // position and orientation of FSS ([0x20: +X], [0x21: -Y], [0x22: -X], [0x23: +Y], [0x24: -Z])
+        vector3_t sun_vec_x1_b = {0,0,0};
+        vector3_t sun_vec_y2_b = {0,0,0};
+        vector3_t sun_vec_x2_b = {0,0,0};
+        vector3_t sun_vec_y1_b = {0,0,0};
+        vector3_t sun_vec_z2_b = {0,0,0};
+        quat_frame_conv(&q_c2b_fss1, &sun_vec_cx_1, &sun_vec_x1_b);
+        quat_frame_conv(&q_c2b_fss2, &sun_vec_cy_2, &sun_vec_y2_b);
+        quat_frame_conv(&q_c2b_fss3, &sun_vec_cx_2, &sun_vec_x2_b);
+        quat_frame_conv(&q_c2b_fss4, &sun_vec_cy_1, &sun_vec_y1_b);
+        quat_frame_conv(&q_c2b_fss5, &sun_vec_cz_2, &sun_vec_z2_b);
+
+
+        sun_vec_b_fss.v[0] = sun_vec_x1_b.v[0] + sun_vec_x2_b.v[0] + sun_vec_y1_b.v[0] + sun_vec_y2_b.v[0] + sun_vec_z2_b.v[0];
+        sun_vec_b_fss.v[1] = sun_vec_x1_b.v[1] + sun_vec_x2_b.v[1] + sun_vec_y1_b.v[1] + sun_vec_y2_b.v[1] + sun_vec_z2_b.v[1];
+        sun_vec_b_fss.v[2] = sun_vec_x1_b.v[2] + sun_vec_x2_b.v[2] + sun_vec_y1_b.v[2] + sun_vec_y2_b.v[2] + sun_vec_z2_b.v[2];
+        vec_normalize(&sun_vec_b_fss, NULL);
+    }
+    DRV_UNLOCK(ADCS_DRV_SUN);
+
+    vec_sum(ss_unit_b, sun_vec_b_fss, sun_dir);
+    vec_normalize(sun_dir, NULL);
+    return ADCS_DRV_OK;
+}
+
+int adcs_drv_set_fss_quat(int fss, const quaternion_t *q_c2b)
+{
+    quaternion_t *fss_quat[5] = {&q_c2b_fss1, &q_c2b_fss2, &q_c2b_fss3, &q_c2b_fss4, &q_c2b_fss5};
+    if(fss < 1 || fss > 5)
+        return ADCS_DRV_ERROR;
+    DRV_LOCK(ADCS_DRV_SUN);
+    *fss_quat[fss-1] = *q_c2b;
+    DRV_UNLOCK(ADCS_DRV_SUN);
+    return ADCS_DRV_OK;
+}
+
+int adcs_drv_set_mtq_pwr(int enable)
+{
+    DRV_LOCK(ADCS_DRV_MTQ);
+    if(enable > 0)
+        gs_a3200_pwr_switch_enable(GS_A3200_PWR_PWM);
+    else
+        gs_a3200_pwr_switch_disable(GS_A3200_PWR_PWM);
+    DRV_UNLOCK(ADCS_DRV_MTQ);
+    return ADCS_DRV_OK;
+}
+
+int adcs_drv_set_mtq_duty(int channel, int duty)
+{
+    if(channel < 0 || channel > 2 || duty < -ADCS_DRV_MTQ_MAX_DUTY || duty > ADCS_DRV_MTQ_MAX_DUTY)
+        return ADCS_DRV_ERROR;
+
+    DRV_LOCK(ADCS_DRV_MTQ);
+    gs_a3200_pwm_enable(channel);
+    gs_a3200_pwm_set_duty(channel, duty);
+    DRV_UNLOCK(ADCS_DRV_MTQ);
+    return ADCS_DRV_OK;
+}
+
+int adcs_drv_set_mtq_freq(int channel, float freq, float *actual_freq)
+{
+    /* The pwm cant handle frequencies above 433 Hz or below 0.1 Hz */
+    if(channel < 0 || channel > 2 || freq > 433.0 || freq < 0.1)
+        return ADCS_DRV_ERROR;
+
+    DRV_LOCK(ADCS_DRV_MTQ);
+    float freq_set = gs_a3200_pwm_set_freq(channel, freq);
+    DRV_UNLOCK(ADCS_DRV_MTQ);
+    if(actual_freq != NULL)
+        *actual_freq = freq_set;
+    return ADCS_DRV_OK;
+}
+
+int adcs_drv_set_mtq(const int8_t duty[3])
+{
+    int i, rc = ADCS_DRV_OK;
+    //Check when the power on should be call
+    gs_a3200_pwr_switch_enable(GS_A3200_PWR_GSSB);
+    gs_a3200_pwr_switch_enable(GS_A3200_PWR_GSSB2);
+    adcs_drv_set_mtq_pwr(1);
+    for(i = 0; i < 3; i++)
+    {
+        if(adcs_drv_set_mtq_duty(i, duty[i]) != ADCS_DRV_OK)
+            rc = ADCS_DRV_ERROR;
+    }
+    return rc;
+}
+
+uint16_t adcs_drv_get_rw_speed(int motor_id)
+{
+    DRV_LOCK(ADCS_DRV_RW);
+    uint16_t speed = rwdrv10987_get_speed((uint8_t)motor_id);
+    DRV_UNLOCK(ADCS_DRV_RW);
+    return speed;
+}
+
+float adcs_drv_get_rw_current(int motor_id)
+{
+    DRV_LOCK(ADCS_DRV_RW);
+    float current = rwdrv10987_get_current((uint8_t)motor_id); //[mA]
+    DRV_UNLOCK(ADCS_DRV_RW);
+    return current;
+}
+
+int adcs_drv_set_rw_speed(int motor_id, int speed)
+{
+    uint8_t dir;
+    if(motor_id != RW_MOTOR1_ID && motor_id != RW_MOTOR2_ID && motor_id != RW_MOTOR3_ID)
+        return ADCS_DRV_ERROR;
+    if(speed != 0 && (speed < -ADCS_DRV_RW_MAX_SPEED || speed > ADCS_DRV_RW_MAX_SPEED ||
+                      (speed > -ADCS_DRV_RW_MIN_SPEED && speed < ADCS_DRV_RW_MIN_SPEED)))
+        return ADCS_DRV_ERROR;
+
+    if(speed < 0) {
+        dir = RW_DIR_ANTICLOCKWISE;
+        speed = -speed;
+    }
+    else
+        dir = RW_DIR_CLOCKWISE;
+
+    DRV_LOCK(ADCS_DRV_RW);
+    int rc = (int) rwdrv10987_set_speed((uint8_t) motor_id, (int16_t) speed, dir);
+    DRV_UNLOCK(ADCS_DRV_RW);
+    return rc != 0 ? ADCS_DRV_ERROR : ADCS_DRV_OK;
+}
+
+int adcs_drv_send_attitude(const quaternion_t *q_est, const quaternion_t *q_tgt)
+{
+    csp_packet_t *packet = csp_buffer_get(COM_FRAME_MAX_LEN);
+    if(packet == NULL)
+        return ADCS_DRV_ERROR;
+
+    int len = snprintf(packet->data, COM_FRAME_MAX_LEN,
+                       "adcs_set_attitude %lf %lf %lf %lf %lf %lf %lf %lf",
+                       q_est->q0, q_est->q1, q_est->q2, q_est->q3,
+                       q_tgt->q0, q_tgt->q1, q_tgt->q2, q_tgt->q3);
+    packet->length = len;
+    LOGI(tag, "OBC ATT: (%d) %s", packet->length, packet->data);
+
+    DRV_LOCK(ADCS_DRV_ADCS);
+    int rc = csp_sendto(CSP_PRIO_NORM, ADCS_PORT, SCH_TRX_PORT_CMD,
+                        SCH_TRX_PORT_CMD, CSP_O_NONE, packet, 100);
+    DRV_UNLOCK(ADCS_DRV_ADCS);
+
+    if(rc != 0)
+    {
+        csp_buffer_free((void *)packet);
+        return ADCS_DRV_ERROR;
+    }
+    return ADCS_DRV_OK;
+}
@@ -0,0 +1,234 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/adcsReference.h"
+#include "app/system/taskADCS.h"
+#include "app/system/cmdADCS.h"
+
+static const char *tag = "adcsRef";
+
+/**
+ * Interpolated values of a node, in the adcs_ref_t order. Floats keep the
+ * table small, the measured position error with the interpolation is about
+ * 3.3 m (the float rounding is below 0.5 m of it).
+ */
+enum ref_field {
+    REF_POS = 0,                    ///< Position x, y, z
+    REF_VEL = 3,                    ///< Velocity x, y, z
+    REF_LAT = 6,                    ///< Geodetic latitude
+    REF_LON = 7,                    ///< Longitude, unwrapped when interpolated
+    REF_ALT = 8,                    ///< Altitude
+    REF_MAG = 9,                    ///< Magnetic field x, y, z
+    REF_SUN = 12,                   ///< Sun position x, y, z
+    REF_SHADOW = 15,                ///< Shadow margin, see calc_shadow_margin
+    REF_LAST = 16
+};
+
+typedef struct ref_table {
+    double t0;                      ///< Time of the first node [s]
+    int nodes;                      ///< Valid nodes, 0 if empty
+    int tle_epoch;                  ///< TLE epoch used to fill the table
+    float node[ADCS_REF_NODES][REF_LAST];
+} ref_table_t;
+
+static ref_table_t ref_tables[2];
+static ref_table_t *ref_active = NULL;  ///< Table read by adcs_ref_get, NULL if empty
+static osSemaphore ref_sem;
+
+int adcs_ref_init(void)
+{
+    memset(ref_tables, 0, sizeof(ref_tables));
+    ref_active = NULL;
+    if(osSemaphoreCreate(&ref_sem) != OS_SEMAPHORE_OK)
+    {
+        LOGE(tag, "Unable to create ADCS reference mutex");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Complete the references derived from position and velocity
+ */
+static void ref_set_nadir(adcs_ref_t *ref)
+{
+    vec_cons_mult(-1.0, &ref->pos_i, &ref->nadir_i);
+    vec_normalize(&ref->nadir_i, NULL);
+    double rr = vec_norm(ref->pos_i);
+    vec_outer_product(ref->pos_i, ref->vel_i, &ref->omega_nadir_i);
+    vec_cons_mult(1.0 / (rr * rr), &ref->omega_nadir_i, NULL);
+}
+
+/**
+ * Calculate the environment models of a reference with the position,
+ * velocity and geodetic coordinates already set
+ */
+static void ref_calc_models(adcs_ref_t *ref, double sidereal)
+{
+    double jd = unixt_to_jd((uint32_t)ref->t);
+    double dec_year = jd_to_dec(jd);
+    igrf_cache_calc(dec_year, ref->geod.v0, ref->geod.v1, ref->geod.v2 * 1000, sidereal, &ref->mag_i);
+    calc_sun_pos_i(jd, &ref->sun_pos_i);
+    ref->isdark = calc_shadow_margin(ref->sun_pos_i, ref->pos_i) > 0;
+    ref_set_nadir(ref);
+}
+
+int adcs_ref_calc(double t, adcs_ref_t *ref)
+{
+    if(orbit_prop_calc(t, &ref->pos_i, &ref->vel_i) != 0)
+        return -1;
+
+    double sidereal = gstime(unixt_to_jd((uint32_t)t));
+    ref->t = t;
+    eci_to_geodetic(ref->pos_i, sidereal, &ref->geod);
+    ref_calc_models(ref, sidereal);
+    return 0;
+}
+
+int adcs_ref_fill(double t0, int yield_ms)
+{
+    int i, j, k;
+    adcs_ref_t ref;
+    vector3_t pos[ADCS_REF_BLOCK], vel[ADCS_REF_BLOCK], geod[ADCS_REF_BLOCK];
+    double sidereal[ADCS_REF_BLOCK];
+
+    // The inactive table is only written here, adcs_ref_get reads the active one
+    osSemaphoreTake(&ref_sem, portMAX_DELAY);
+    ref_table_t *table = ref_active == &ref_tables[0] ? &ref_tables[1] : &ref_tables[0];
+    osSemaphoreGiven(&ref_sem);
+
+    table->t0 = t0;
+    table->tle_epoch = dat_get_system_var(dat_ads_tle_epoch);
+    table->nodes = 0;
+    for(k = 0; k < ADCS_REF_NODES; k++)
+    {
+        // Propagate a block of nodes and convert them to geodetic coordinates at once
+        j = k % ADCS_REF_BLOCK;
+        if(j == 0)
+        {
+            int nb = ADCS_REF_NODES - k < ADCS_REF_BLOCK ? ADCS_REF_NODES - k : ADCS_REF_BLOCK;
+            for(i = 0; i < nb; i++)
+            {
+                double t = t0 + (k + i) * ADCS_REF_STEP;
+                if(orbit_prop_calc(t, &pos[i], &vel[i]) != 0)
+                {
+                    LOGW(tag, "Error propagating node %d", k + i);
+                    return -1;
+                }
+                sidereal[i] = gstime(unixt_to_jd((uint32_t)t));
+            }
+            eci_to_geodetic_batch(pos, sidereal, geod, nb);
+        }
+
+        ref.t = t0 + k * ADCS_REF_STEP;
+        ref.pos_i = pos[j];
+        ref.vel_i = vel[j];
+        ref.geod = geod[j];
+        ref_calc_models(&ref, sidereal[j]);
+
+        float *node = table->node[k];
+        for(i = 0; i < 3; i++)
+        {
+            node[REF_POS + i] = (float)ref.pos_i.v[i];
+            node[REF_VEL + i] = (float)ref.vel_i.v[i];
+            node[REF_MAG + i] = (float)ref.mag_i.v[i];
+            node[REF_SUN + i] = (float)ref.sun_pos_i.v[i];
+        }
+        node[REF_LAT] = (float)ref.geod.v0;
+        node[REF_LON] = (float)ref.geod.v1;
+        node[REF_ALT] = (float)ref.geod.v2;
+        node[REF_SHADOW] = (float)calc_shadow_margin(ref.sun_pos_i, ref.pos_i);
+        if(yield_ms > 0)
+            osDelay(yield_ms);
+    }
+    table->nodes = ADCS_REF_NODES;
+
+    osSemaphoreTake(&ref_sem, portMAX_DELAY);
+    ref_active = table;
+    osSemaphoreGiven(&ref_sem);
+
+    LOGI(tag, "Reference table filled from %d to %d", (int)t0, (int)(t0 + (k - 1) * ADCS_REF_STEP));
+    return k;
+}
+
+int adcs_ref_get(double t, adcs_ref_t *ref)
+{
+    int i;
+    double x[REF_LAST];
+
+    osSemaphoreTake(&ref_sem, portMAX_DELAY);
+    ref_table_t *table = ref_active;
+    if(table == NULL || table->nodes < 4)
+    {
+        osSemaphoreGiven(&ref_sem);
+        return -1;
+    }
+
+    // Nodes k-1, k, k+1 and k+2 around t
+    double s = (t - table->t0) / ADCS_REF_STEP;
+    int k = (int)floor(s);
+    if(k < 1 || k > table->nodes - 3)
+    {
+        osSemaphoreGiven(&ref_sem);
+        return -1;
+    }
+    double u = s - k;
+    double w[4] = {
+        -u * (u - 1) * (u - 2) / 6.0,
+        (u + 1) * (u - 1) * (u - 2) / 2.0,
+        -(u + 1) * u * (u - 2) / 2.0,
+        (u + 1) * u * (u - 1) / 6.0
+    };
+
+    const float *n[4] = {table->node[k-1], table->node[k], table->node[k+1], table->node[k+2]};
+    for(i = 0; i < REF_LAST; i++)
+        x[i] = w[0] * n[0][i] + w[1] * n[1][i] + w[2] * n[2][i] + w[3] * n[3][i];
+
+    // Longitude is interpolated as the offsets from node k, wrapped to [-pi, pi)
+    double lon_k = n[1][REF_LON];
+    x[REF_LON] = lon_k;
+    for(i = 0; i < 4; i++)
+        x[REF_LON] += w[i] * (fmod2p(n[i][REF_LON] - lon_k + pi) - pi);
+    osSemaphoreGiven(&ref_sem);
+
+    ref->t = t;
+    for(i = 0; i < 3; i++)
+    {
+        ref->pos_i.v[i] = x[REF_POS + i];
+        ref->vel_i.v[i] = x[REF_VEL + i];
+        ref->mag_i.v[i] = x[REF_MAG + i];
+        ref->sun_pos_i.v[i] = x[REF_SUN + i];
+    }
+    ref->geod.v0 = x[REF_LAT];
+    ref->geod.v1 = fmod2p(x[REF_LON]);
+    ref->geod.v2 = x[REF_ALT];
+    ref->isdark = x[REF_SHADOW] > 0;
+    ref_set_nadir(ref);
+    return 0;
+}
+
+int adcs_ref_expired(double t, int tle_epoch)
+{
+    osSemaphoreTake(&ref_sem, portMAX_DELAY);
+    ref_table_t *table = ref_active;
+    int expired = table == NULL || table->tle_epoch != tle_epoch ||
+                  table->t0 + (table->nodes - 3) * ADCS_REF_STEP - t < ADCS_REF_MARGIN;
+    osSemaphoreGiven(&ref_sem);
+    return expired;
+}
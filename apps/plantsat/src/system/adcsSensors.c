@@ -0,0 +1,71 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/adcsSensors.h"
+
+static const char *tag = "adcsSen";
+
+static adcs_sen_sample_t sen_slots[ADCS_SEN_LAST];
+static osSemaphore sen_sem;
+
+int adcs_sen_init(void)
+{
+    memset(sen_slots, 0, sizeof(sen_slots));
+    if(osSemaphoreCreate(&sen_sem) != OS_SEMAPHORE_OK)
+    {
+        LOGE(tag, "Unable to create ADCS sensors mutex");
+        return -1;
+    }
+    return 0;
+}
+
+void adcs_sen_put(int sensor, const vector3_t *value)
+{
+    if(sensor < 0 || sensor >= ADCS_SEN_LAST)
+        return;
+    osSemaphoreTake(&sen_sem, portMAX_DELAY);
+    adcs_sen_sample_t *slot = &sen_slots[sensor];
+    slot->value = *value;
+    slot->timestamp = dat_get_time();
+    slot->tick = osTaskGetTickCount();
+    slot->seq++;
+    osSemaphoreGiven(&sen_sem);
+}
+
+void adcs_sen_error(int sensor)
+{
+    if(sensor < 0 || sensor >= ADCS_SEN_LAST)
+        return;
+    osSemaphoreTake(&sen_sem, portMAX_DELAY);
+    sen_slots[sensor].errors++;
+    osSemaphoreGiven(&sen_sem);
+}
+
+int adcs_sen_get(int sensor, adcs_sen_sample_t *sample)
+{
+    if(sensor < 0 || sensor >= ADCS_SEN_LAST)
+        return -1;
+    osSemaphoreTake(&sen_sem, portMAX_DELAY);
+    *sample = sen_slots[sensor];
+    osSemaphoreGiven(&sen_sem);
+
+    if(sample->seq == 0)
+        return -1;
+    return (int)(osTaskGetTickCount() - sample->tick);
+}
@@ -0,0 +1,178 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/adcsTiming.h"
+
+#ifdef NANOMIND
+#include <avr32/io.h>
+#define ADCS_TIM_TICKS_PER_US ADCS_TIM_CPU_MHZ
+#else
+#include <time.h>
+#define ADCS_TIM_TICKS_PER_US 1
+#endif
+
+static const char *tag = "adcsTim";
+
+static adcs_tim_hist_t tim_hist[ADCS_TIM_LAST];
+static osSemaphore tim_sem;
+
+static const char *tim_stage_names[ADCS_TIM_LAST] = {"gyro", "mag_sun", "model", "determination",
+                                                     "ekf_predict", "ekf_update", "control"};
+
+/**
+ * Histogram bin of a duration. Bins 0-3 are 0-3 us, then two bins per power
+ * of two: [2^n, 1.5·2^n) and [1.5·2^n, 2^(n+1)).
+ */
+static int tim_bin(uint32_t us)
+{
+    if(us < 4)
+        return (int)us;
+    int msb = 31;
+    while(!(us & (1u << msb)))
+        msb--;
+    int bin = 2 * msb + (int)((us >> (msb - 1)) & 1);
+    return bin < ADCS_TIM_NBINS ? bin : ADCS_TIM_NBINS - 1;
+}
+
+/**
+ * Largest duration of a histogram bin
+ */
+static uint32_t tim_bin_max(int bin)
+{
+    if(bin < 4)
+        return (uint32_t)bin;
+    int msb = bin / 2;
+    return ((uint32_t)(3 + bin % 2) << (msb - 1)) - 1;
+}
+
+/**
+ * Estimate the 99th percentile as the upper limit of the bin that contains
+ * it, but not more than the max. duration
+ */
+static uint32_t tim_p99(const adcs_tim_hist_t *hist)
+{
+    uint32_t total = 0, acc = 0;
+    int i;
+    for(i = 0; i < ADCS_TIM_NBINS; i++)
+        total += hist->bins[i];
+    uint32_t target = total - total / 100;
+    for(i = 0; i < ADCS_TIM_NBINS; i++)
+    {
+        acc += hist->bins[i];
+        if(acc >= target && acc > 0)
+            break;
+    }
+    uint32_t p99 = i < ADCS_TIM_NBINS ? tim_bin_max(i) : hist->max;
+    return p99 < hist->max ? p99 : hist->max;
+}
+
+int adcs_tim_init(void)
+{
+    memset(tim_hist, 0, sizeof(tim_hist));
+    if(osSemaphoreCreate(&tim_sem) != OS_SEMAPHORE_OK)
+    {
+        LOGE(tag, "Unable to create ADCS timing mutex");
+        return -1;
+    }
+    return 0;
+}
+
+uint32_t adcs_tim_now(void)
+{
+#ifdef NANOMIND
+    return (uint32_t)__builtin_mfsr(AVR32_COUNT);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)ts.tv_sec * 1000000u + (uint32_t)(ts.tv_nsec / 1000);
+#endif
+}
+
+void adcs_tim_add(int stage, uint32_t ticks)
+{
+    if(stage < 0 || stage >= ADCS_TIM_LAST)
+        return;
+    uint32_t us = ticks / ADCS_TIM_TICKS_PER_US;
+    int bin = tim_bin(us);
+
+    osSemaphoreTake(&tim_sem, portMAX_DELAY);
+    adcs_tim_hist_t *hist = &tim_hist[stage];
+    if(hist->count == 0 || us < hist->min)
+        hist->min = us;
+    if(us > hist->max)
+        hist->max = us;
+    hist->count++;
+    hist->sum += us;
+    if(hist->bins[bin] < UINT16_MAX)
+        hist->bins[bin]++;
+    osSemaphoreGiven(&tim_sem);
+}
+
+/**
+ * Fill a tim_data_t sample with the statistics of a stage
+ */
+static void tim_get_data(int stage, const adcs_tim_hist_t *hist, tim_data_t *data)
+{
+    data->index = 0;
+    data->timestamp = dat_get_time();
+    data->stage = (uint32_t)stage;
+    data->count = hist->count;
+    data->min = hist->min;
+    data->max = hist->max;
+    data->mean = hist->count ? (uint32_t)(hist->sum / hist->count) : 0;
+    data->p99 = tim_p99(hist);
+}
+
+int adcs_tim_flush(void)
+{
+    tim_data_t data[ADCS_TIM_LAST];
+    int i, n = 0;
+
+    osSemaphoreTake(&tim_sem, portMAX_DELAY);
+    for(i = 0; i < ADCS_TIM_LAST; i++)
+    {
+        if(tim_hist[i].count == 0)
+            continue;
+        tim_get_data(i, &tim_hist[i], &data[n++]);
+        memset(&tim_hist[i], 0, sizeof(adcs_tim_hist_t));
+    }
+    osSemaphoreGiven(&tim_sem);
+
+    // Save outside the mutex, the storage may be slow
+    int saved = 0;
+    for(i = 0; i < n; i++)
+        if(ret_add_payload_sample(&data[i], tim_sensors) == 0)
+            saved++;
+    return saved;
+}
+
+void adcs_tim_print(void)
+{
+    int i;
+    osSemaphoreTake(&tim_sem, portMAX_DELAY);
+    for(i = 0; i < ADCS_TIM_LAST; i++)
+    {
+        tim_data_t data;
+        tim_get_data(i, &tim_hist[i], &data);
+        LOGR(tag, "%-13s count %u, min %u us, max %u us, mean %u us, p99 %u us", tim_stage_names[i],
+             (unsigned int)data.count, (unsigned int)data.min, (unsigned int)data.max,
+             (unsigned int)data.mean, (unsigned int)data.p99);
+    }
+    osSemaphoreGiven(&tim_sem);
+}
@@ -23,37 +23,15 @@
  */
 
 #include "app/system/cmdADCS.h"
+#include "app/system/taskADCS.h"
 
 static const char* tag = "cmdADCS";
 
-#define ADCS_PORT 7
 #define TLE_BUFF_LEN 70
 
-TLE tle;
 static char tle1[TLE_BUFF_LEN]; //"1 42788U 17036Z   20054.20928660  .00001463  00000-0  64143-4 0  9996";
 static char tle2[TLE_BUFF_LEN]; //"2 42788  97.3188 111.6825 0013081  74.6084 285.6598 15.23469130148339";
 
-// Parametric calibration parameters [h x0 y0 rho]
-double cal1[4] = {0.52544,-0.033188,0.022875,-0.0038183}; // uid : 1523358639 - B23 - 0x20
-double cal2[4] = {0.53262,0.0053791,-0.015919,-0.0055018}; // uid : 1523289023 - A28 - 0x21
-double cal3[4] = {0.52578,-0.020189,-0.0097265,-0.0098635}; // uid : 1523358910 - B24 - 0x22
-double cal4[4] = {0.51447,-0.028293,0.0060877,0.0028711}; // uid : 1523359548 - A29 - 0x23
-double cal5[4] = {0.52768,0.031435,-0.023118,-0.0060699}; // uid : 1523357329 - C17 - 0x24
-
-double T1[4][4];
-double T2[4][4];
-double T3[4][4];
-double T4[4][4];
-double T5[4][4];
-
-// position and orientation of FSS (0x20: +X, 0x21: -Y, 0x22: -X, 0x23: +Y, 0x24: -Z)
-
-quaternion_t q_c2b_fss1 = {1, 0, 0, 0};
-quaternion_t q_c2b_fss2 = {0.707106781, -0.707106781, 0, 0};
-quaternion_t q_c2b_fss3 = {0, 1 ,0 , 0};
-quaternion_t q_c2b_fss4 = {0.707106781, 0.707106781, 0, 0};
-quaternion_t q_c2b_fss5 = {0.5, -0.5, -0.5, 0.5};
-
 void cmd_adcs_init(void)
 {
     cmd_add("tle_get", tle_get, "", 0);
@@ -85,17 +63,14 @@ void cmd_adcs_init(void)
     cmd_add("adcs_set_target", adcs_set_target, "%lf %lf %lf %lf %lf %lf", 6);
     cmd_add("adcs_set_to_nadir", adcs_target_nadir, "", 0);
 #endif
-    // Matrix of calibration of FSS
-    T1[0][0] = cos(cal1[3]); T1[0][1] = sin(cal1[3]);
-    T1[1][0] = -sin(cal1[3]); T1[1][1] = cos(cal1[3]);
-    T2[0][0] = cos(cal2[3]); T2[0][1] = sin(cal2[3]);
-    T2[1][0] = -sin(cal2[3]); T2[1][1] = cos(cal2[3]);
-    T3[0][0] = cos(cal3[3]); T3[0][1] = sin(cal3[3]);
-    T3[1][0] = -sin(cal3[3]); T3[1][1] = cos(cal3[3]);
-    T4[0][0] = cos(cal4[3]); T4[0][1] = sin(cal4[3]);
-    T4[1][0] = -sin(cal4[3]); T4[1][1] = cos(cal4[3]);
-    T5[0][0] = cos(cal5[3]); T5[0][1] = sin(cal5[3]);
-    T5[1][0] = -sin(cal5[3]); T5[1][1] = cos(cal5[3]);
+    cmd_add("adcs_tim_print", adcs_tim_print_stats, "", 0);
+    cmd_add("adcs_tim_flush", adcs_tim_flush_stats, "", 0);
+    cmd_add("adcs_igrf_error", adcs_igrf_set_error, "%lf", 1);
+    cmd_add("adcs_igrf_check", adcs_igrf_check, "%lf %lf %lf", 3);
+    adcs_tim_init();
+    adcs_drv_init();
+    igrf_cache_init();
+    orbit_prop_init();
 }
 
 int set_bias_omega(char *fmt, char *params, int nparams){
@@ -119,32 +94,14 @@ int set_quat_fss(char *fmt, char *params, int nparams){
         LOGE(tag, "Error parsing parameters!");
         return CMD_SYNTAX_ERROR;
     }
-    if (selected_quat == 1){
-        q_c2b_fss1.q0 = (double) q0 * 0.0001;
-        q_c2b_fss1.q1 = (double) q1 * 0.0001;
-        q_c2b_fss1.q2 = (double) q2 * 0.0001;
-        q_c2b_fss1.q3 = (double) q3 * 0.0001;
-    }else if (selected_quat == 2){
-        q_c2b_fss2.q0 = (double) q0 * 0.0001;
-        q_c2b_fss2.q1 = (double) q1 * 0.0001;
-        q_c2b_fss2.q2 = (double) q2 * 0.0001;
-        q_c2b_fss2.q3 = (double) q3 * 0.0001;
-    }else if (selected_quat == 3){
-        q_c2b_fss3.q0 = (double) q0 * 0.0001;
-        q_c2b_fss3.q1 = (double) q1 * 0.0001;
-        q_c2b_fss3.q2 = (double) q2 * 0.0001;
-        q_c2b_fss3.q3 = (double) q3 * 0.0001;
-    }else if (selected_quat == 4){
-        q_c2b_fss4.q0 = (double) q0 * 0.0001;
-        q_c2b_fss4.q1 = (double) q1 * 0.0001;
-        q_c2b_fss4.q2 = (double) q2 * 0.0001;
-        q_c2b_fss4.q3 = (double) q3 * 0.0001;
-    }else{
-        q_c2b_fss5.q0 = (double) q0 * 0.0001;
-        q_c2b_fss5.q1 = (double) q1 * 0.0001;
-        q_c2b_fss5.q2 = (double) q2 * 0.0001;
-        q_c2b_fss5.q3 = (double) q3 * 0.0001;
-    };
+    quaternion_t q_c2b;
+    q_c2b.q0 = (double) q0 * 0.0001;
+    q_c2b.q1 = (double) q1 * 0.0001;
+    q_c2b.q2 = (double) q2 * 0.0001;
+    q_c2b.q3 = (double) q3 * 0.0001;
+    if (selected_quat < 1 || selected_quat > 4)
+        selected_quat = 5;
+    adcs_drv_set_fss_quat(selected_quat, &q_c2b);
     return CMD_OK;
 }
 
@@ -330,16 +287,15 @@ int tle_set(char *fmt, char *params, int nparams)
 
 int tle_update(char *fmt, char *params, int nparams)
 {
-    parseLines(&tle, tle1, tle2);
-    //TODO: Check errors
-    if(tle.sgp4Error != 0)
+    double epoch;
+    if(orbit_prop_set_tle(tle1, tle2, &epoch) != 0)
     {
         dat_set_system_var(dat_ads_tle_epoch, 0);
         return CMD_ERROR;
     }
 
-    LOGR(tag, "TLE updated to epoch %.8f (%d)", tle.epoch, (int)(tle.epoch/1000.0));
-    dat_set_system_var(dat_ads_tle_epoch, (int)(tle.epoch/1000.0));
+    LOGR(tag, "TLE updated to epoch %.8f (%d)", epoch, (int)(epoch/1000.0));
+    dat_set_system_var(dat_ads_tle_epoch, (int)(epoch/1000.0));
     //int epoch_time = (int)(tle.epoch/1000.0);
     //uint32_t curr_time = (uint32_t) time(NULL);
     //if (curr_time < epoch_time){
@@ -350,8 +306,8 @@ int tle_update(char *fmt, char *params, int nparams)
 
 int tle_prop(char *fmt, char *params, int nparams)
 {
-    double r[3];  // Sat position in ECI frame
-    double v[3];  // Sat velocity in ECI frame
+    vector3_t r;  // Sat position in ECI frame
+    vector3_t v;  // Sat velocity in ECI frame
     int ts=0;
 
     if(params != NULL && sscanf(params, fmt, &ts) != nparams){
@@ -361,22 +317,17 @@ int tle_prop(char *fmt, char *params, int nparams)
     if(ts == 0) {
         ts = dat_get_time();
     }
-    double ts_mili = 1000.0 * (double) ts;
 
-    double diff = (double)ts - (double)tle.epoch/1000.0;
-    diff /= 60.0;
-
-    getRVForDate(&tle, ts_mili, r, v);
-
-    LOGD(tag, "T : %.8f - %.8f = %.8f", ts_mili/1000.0, tle.epoch/1000.0, diff);
-    LOGD(tag, "R : (%.8f, %.8f, %.8f)", r[0], r[1], r[2]);
-    LOGD(tag, "V : (%.8f, %.8f, %.8f)", v[0], v[1], v[2]);
-    LOGD(tag, "Er: %d", tle.rec.error);
-    if(tle.sgp4Error != 0)
+    // Shared propagator, SGP4 only runs if the states around ts are not cached
+    if(orbit_prop_get((double)ts, &r, &v) != 0)
         return CMD_ERROR;
 
-    value32_t pos[3] = {{.f=(float)r[0]},{.f=(float)r[1]}, {.f=(float)r[2]}};
-    value32_t vel[3] = {{.f=(float)v[0]},{.f=(float)v[1]}, {.f=(float)v[2]}};
+    LOGD(tag, "T : %d", ts);
+    LOGD(tag, "R : (%.8f, %.8f, %.8f)", r.v0, r.v1, r.v2);
+    LOGD(tag, "V : (%.8f, %.8f, %.8f)", v.v0, v.v1, v.v2);
+
+    value32_t pos[3] = {{.f=(float)r.v0},{.f=(float)r.v1}, {.f=(float)r.v2}};
+    value32_t vel[3] = {{.f=(float)v.v0},{.f=(float)v.v1}, {.f=(float)v.v2}};
 
     dat_set_status_var(dat_ads_pos_x, pos[0]);
     dat_set_status_var(dat_ads_pos_y, pos[1]);
@@ -384,21 +335,14 @@ int tle_prop(char *fmt, char *params, int nparams)
     dat_set_status_var(dat_ads_vel_x, vel[0]);
     dat_set_status_var(dat_ads_vel_y, vel[1]);
     dat_set_status_var(dat_ads_vel_z, vel[2]);
-    dat_set_system_var(dat_ads_tle_last, (int)ts);
+    sts_set_system_var(dat_ads_tle_last, (int)ts);
 
     return CMD_OK;
 }
 
 int calc_shadow_zone(vector3_t sun_pos_i, vector3_t sc_pos_i){
     int isDark;
-    double radiusearthkm = 6378.137;
-    double point_product = vec_inner_product(sun_pos_i, sc_pos_i);
-    double r_sun = vec_norm(sun_pos_i);
-    double r_sc = vec_norm(sc_pos_i);
-    double theta = acos(point_product / (r_sc * r_sun));
-    double theta_sun = acos(radiusearthkm / r_sun);
-    double theta_sc = acos(radiusearthkm / r_sc);
-    if (theta_sc + theta_sun < theta){
+    if (calc_shadow_margin(sun_pos_i, sc_pos_i) > 0){
         //Shadow
         isDark = 1;
     }
@@ -408,6 +352,17 @@ int calc_shadow_zone(vector3_t sun_pos_i, vector3_t sc_pos_i){
     return isDark;
 }
 
+double calc_shadow_margin(vector3_t sun_pos_i, vector3_t sc_pos_i){
+    double radiusearthkm = 6378.137;
+    double point_product = vec_inner_product(sun_pos_i, sc_pos_i);
+    double r_sun = vec_norm(sun_pos_i);
+    double r_sc = vec_norm(sc_pos_i);
+    double theta = acos(point_product / (r_sc * r_sun));
+    double theta_sun = acos(radiusearthkm / r_sun);
+    double theta_sc = acos(radiusearthkm / r_sc);
+    return theta - (theta_sc + theta_sun);
+}
+
 int mtt_set_pwm_duty(char* fmt, char* params, int nparams)
 {
     int channel;
@@ -425,9 +380,7 @@ int mtt_set_pwm_duty(char* fmt, char* params, int nparams)
     }
 
     LOGR(tag, "Setting duty %d to Channel %d", duty, channel);
-    gs_a3200_pwm_enable(channel);
-    gs_a3200_pwm_set_duty(channel, duty);
-    return CMD_OK;
+    return adcs_drv_set_mtq_duty(channel, duty) == ADCS_DRV_OK ? CMD_OK : CMD_ERROR;
 }
 
 int mtt_set_pwm_freq(char* fmt, char* params, int nparams)
@@ -445,7 +398,8 @@ int mtt_set_pwm_freq(char* fmt, char* params, int nparams)
         return CMD_SYNTAX_ERROR;
     }
 
-    float actual_freq = gs_a3200_pwm_set_freq(channel, freq);
+    float actual_freq;
+    adcs_drv_set_mtq_freq(channel, freq, &actual_freq);
     LOGR(tag, "PWM %d Freq set to: %.4f", channel, actual_freq);
     return CMD_OK;
 }
@@ -458,278 +412,33 @@ int mtt_set_pwm_pwr(char *fmt, char *params, int nparams)
 
     /* Turn on/off power channel */
     LOGR(tag, "PWM enabled: %d", enable>0 ? 1:0);
-    if(enable > 0)
-        gs_a3200_pwr_switch_enable(GS_A3200_PWR_PWM);
-    else
-        gs_a3200_pwr_switch_disable(GS_A3200_PWR_PWM);
+    adcs_drv_set_mtq_pwr(enable);
     return CMD_OK;
 }
 
 int adcs_get_mag(char* fmt, char* params, int nparams)
 {
-#ifdef NANOMIND
-    gs_error_t result;
-    gs_hmc5843_data_t hmc_reading;
-    result = gs_hmc5843_read_single(&hmc_reading);
-
-    if(result == GS_OK)
-    {
-        vector3_t mag;
-        mag.v0 = hmc_reading.x; // nano Tesla
-        mag.v1 = hmc_reading.y; // nT
-        mag.v2 = hmc_reading.z; // nT
-        _set_sat_vector(&mag, dat_ads_mag_x);
-        return CMD_OK;
-    }
-    return CMD_ERROR;
-#endif
+    vector3_t mag;
+    if(adcs_drv_read_mag(&mag) != ADCS_DRV_OK)
+        return CMD_ERROR;
+    _set_sat_vector(&mag, dat_ads_mag_x);
     return CMD_OK;
 }
 
 int adcs_get_omega(char* fmt, char* params, int nparams)
 {
-#ifdef NANOMIND
-    int result;
-    gs_mpu3300_gyro_t gyro_reading;
-    result = gs_mpu3300_read_gyro(&gyro_reading);
-
-    if(result == 0)
-    {
-        vector3_t bias_sensor_omega_b;
-        _get_sat_vector(&bias_sensor_omega_b, dat_ads_bias_x);
-        vector3_t omega;
-        omega.v0 = gyro_reading.gyro_x + bias_sensor_omega_b.v[0];
-        omega.v1 = gyro_reading.gyro_y + bias_sensor_omega_b.v[0];
-        omega.v2 = gyro_reading.gyro_z + bias_sensor_omega_b.v[0];
-        _set_sat_vector(&omega, dat_ads_omega_x);
-        return CMD_OK;
-    }
-    return CMD_ERROR;
-#endif
+    vector3_t omega;
+    if(adcs_drv_read_gyro(&omega) != ADCS_DRV_OK)
+        return CMD_ERROR;
+    _set_sat_vector(&omega, dat_ads_omega_x);
     return CMD_OK;
 }
 
 int get_obc_sun_vec(char* fmt, char* params, int nparams)
 {
-    uint16_t sun1 = 300, sun2 = 500, sun3 = 500, sun4 = 500, sun5 = 500;
-    int css_ok = 0, fss_ok = 0;
-    vector3_t ss_unit_b = {0, 0, 0};
-    // FSS
-    uint16_t sun_fss1[4] = {2,2,2,2};
-    uint16_t sun_fss2[4] = {1,1,1,1};
-    uint16_t sun_fss3[4] = {1,1,1,1};
-    uint16_t sun_fss4[4] = {2,2,2,2};
-    uint16_t sun_fss5[4] = {1,1,1,1};
-
-    double selected_face_axis[3] = {0,0,0}; // 0 if positive face, 1 if negative face of each axis
-    vector3_t sun_vec_b_fss = {0, 0, 0};
-    uint32_t sum_all_fss[5];
-    int rc1 = 0; int rc2 = 0; int rc3 = 0; int rc4 = 0; int rc5 = 0;
-    #ifdef NANOMIND
-    gs_a3200_pwr_switch_enable(GS_A3200_PWR_GSSB);
-    gs_a3200_pwr_switch_enable(GS_A3200_PWR_GSSB2);
-    osDelay(30);
-
-    //int rc1 = gs_gssb_istage_get_sun_voltage(0x10, 100, &sun1);
-    //int rc2 = gs_gssb_istage_get_sun_voltage(0x11, 100, &sun2);
-    //int rc3 = gs_gssb_istage_get_sun_voltage(0x12, 100, &sun3);
-    //int rc4 = gs_gssb_istage_get_sun_voltage(0x13, 100, &sun4);
-    //int rc5 = 0;
-
-    if (SCH_DEVICE_ID == 2) {
-        printf("SUCHAI 2 - FSS\n");
-        // position and orientation of FSS (0x20: +X, 0x21: -Y, 0x22: -X, 0x23: +Y, 0x24: -Z)
-        //rc5 = gs_gssb_istage_get_sun_voltage(0x14, 100, &sun5);
-        int timei2c = 1000;
-        if (gs_gssb_sun_sample_sensor(0x20, timei2c) != GS_OK)
-            return CMD_ERROR;
-        osDelay(30);
-        //printf("1 \n");
-        int rf1 = gs_gssb_sun_read_sensor_samples(0x20, timei2c, sun_fss1);
-        osDelay(30);
-        if (gs_gssb_sun_sample_sensor(0x21, timei2c) != GS_OK)
-            return CMD_ERROR;
-        osDelay(30);
-        //printf("1 \n");
-        int rf2 = gs_gssb_sun_read_sensor_samples(0x21, timei2c, sun_fss2);
-        osDelay(30);
-        if (gs_gssb_sun_sample_sensor(0x22, timei2c) != GS_OK)
-            return CMD_ERROR;
-        osDelay(30);
-        //printf("1 \n");
-        int rf3 = gs_gssb_sun_read_sensor_samples(0x22, timei2c, sun_fss3);
-        osDelay(30);
-        if (gs_gssb_sun_sample_sensor(0x23, timei2c) != GS_OK)
-            return CMD_ERROR;
-        osDelay(30);
-        //printf("1 \n");
-        int rf4 = gs_gssb_sun_read_sensor_samples(0x23, timei2c, sun_fss4);
-        osDelay(30);
-        if (gs_gssb_sun_sample_sensor(0x24, timei2c) != GS_OK)
-            return CMD_ERROR;
-        osDelay(30);
-        //printf("1 \n");
-        int rf5 = gs_gssb_sun_read_sensor_samples(0x24, timei2c, sun_fss5);
-        osDelay(200);
-
-        if(rf1 != 0 || rf2 != 0 || rf3 != 0 || rf4 != 0 || rf5 != 0)
-        {
-            printf("Error i2c fss \n");
-            LOGE(tag, "Error reading fine sun sensors (%d, %d, %d, %d, %d)", rc1, rc2, rc3, rc4, rc5);
-            //return CMD_ERROR;
-        }else{
-            fss_ok = 1;
-            // face axis selection
-            sum_all_fss[0] = sun_fss1[0] + sun_fss1[1] + sun_fss1[2] + sun_fss1[3];
-            sum_all_fss[1] = sun_fss2[0] + sun_fss2[1] + sun_fss2[2] + sun_fss2[3];
-            sum_all_fss[2] = sun_fss3[0] + sun_fss3[1] + sun_fss3[2] + sun_fss3[3];
-            sum_all_fss[3] = sun_fss4[0] + sun_fss4[1] + sun_fss4[2] + sun_fss4[3];
-            sum_all_fss[4] = sun_fss5[0] + sun_fss5[1] + sun_fss5[2] + sun_fss5[3];
-            // position and orientation of FSS (0x20: +X, 0x21: -Y, 0x22: -X, 0x23: +Y, 0x24: -Z)
-            //printf("Sum all elements: %d, %d, %d, %d, %d \n", sum_all_fss[0], sum_all_fss[1], sum_all_fss[2], sum_all_fss[3],sum_all_fss[4]);
-            if (sum_all_fss[0] < sum_all_fss[2]){
-                //printf("Axis -X \n");
-                selected_face_axis[0] = 0;
-            }else{
-                selected_face_axis[0] = 0;
-                //printf("Axis +X \n");
-            }
-            if (sum_all_fss[1] < sum_all_fss[3]){
-                selected_face_axis[1] = 0;
-                //printf("Axis +Y \n");
-            }else{
-                selected_face_axis[1] = 1;
-                //printf("Axis -Y \n");
-            }
-            selected_face_axis[2] = 1;
-            //printf("Axis -Z \n");
-        }
-    }
-    if(rc1 != 0 || rc2 != 0 || rc3 != 0 || rc4 != 0 || rc5 != 0)
-    {
-        printf("Error i2c FSS \n");
-        LOGE(tag, "Error reading coarse sun sensors (%d, %d, %d, %d, %d)", rc1, rc2, rc3, rc4, rc5);
-        //return CMD_ERROR;
-    }else{css_ok = 1;}
-#endif
-    if (css_ok)
-    {
-        uint16_t Ix = sun3;
-        uint16_t Iy = sun2;
-        uint16_t Iz = sun4;
-
-        uint16_t noise_thr = 10; // [uA]
-
-        if (Ix < noise_thr && Iy < noise_thr && Iz < noise_thr)
-        {
-            // shadow
-            ss_unit_b.v1 = 0, ss_unit_b.v0= 0, ss_unit_b.v2 = 0;
-        }else if (Iz < noise_thr) {
-            // ignore incomplete observations
-            ss_unit_b.v1 = 0, ss_unit_b.v0= 0, ss_unit_b.v2 = 0;
-        }
-        else{
-            ss_unit_b.v0 = -Ix, ss_unit_b.v1 = -Iy, ss_unit_b.v2 = Iz;
-            vec_normalize(&ss_unit_b, NULL);
-        }
-    }
-    if (fss_ok && SCH_DEVICE_ID == 2) {
-        double vec_d_x_1[2];
-        double vec_d_x_2[2];
-        double vec_d_y_1[2];
-        double vec_d_y_2[2];
-        double vec_d_z_2[2];
-
-        // position and orientation of FSS ([0x20: +X], [0x21: -Y], [0x22: -X], [0x23: +Y], [0x24: -Z])
-        // FSS 0x20
-        double num_1 = sun_fss1[0] + sun_fss1[1] - sun_fss1[2] - sun_fss1[3];
-        double num_2 = sun_fss1[0] + sun_fss1[3] - sun_fss1[1] - sun_fss1[2];
-        double den = sun_fss1[0] + sun_fss1[1] + sun_fss1[2] + sun_fss1[3];
-        vec_d_x_1[0] = num_1 / den + cal1[1];
-        vec_d_x_1[1] = num_2 / den + cal1[2];
-
-        // FSS 0x22
-        num_1 = sun_fss3[0] + sun_fss3[1] - sun_fss3[2] - sun_fss3[3];
-        num_2 = sun_fss3[0] + sun_fss3[3] - sun_fss3[1] - sun_fss3[2];
-        den = sun_fss3[0] + sun_fss3[1] + sun_fss3[2] + sun_fss3[3];
-        vec_d_x_2[0] = num_1 / den + cal3[1];
-        vec_d_x_2[1] = num_2 / den + cal3[2];
-
-        // FSS 0x23
-        num_1 = sun_fss4[0] + sun_fss4[1] - sun_fss4[2] - sun_fss4[3];
-        num_2 = sun_fss4[0] + sun_fss4[3] - sun_fss4[1] - sun_fss4[2];
-        den = sun_fss4[0] + sun_fss4[1] + sun_fss4[2] + sun_fss4[3];
-        vec_d_y_1[0] = num_1 / den + cal4[1];
-        vec_d_y_1[1] = num_2 / den + cal4[2];
-
-        // FSS 0x21
-        num_1 = sun_fss2[0] + sun_fss2[1] - sun_fss2[2] - sun_fss2[3];
-        num_2 = sun_fss2[0] + sun_fss2[3] - sun_fss2[1] - sun_fss2[2];
-        den = sun_fss2[0] + sun_fss2[1] + sun_fss2[2] + sun_fss2[3];
-        vec_d_y_2[0] = num_1 / den + cal2[1];
-        vec_d_y_2[1] = num_2 / den + cal2[2];
-
-        // FSS 0x24
-        vec_d_z_2[0] = (sun_fss5[0] + sun_fss5[1] - sun_fss5[2] - sun_fss5[3]) / (sun_fss5[0] + sun_fss5[1] + sun_fss5[2] + sun_fss5[3]) + cal5[1];
-        vec_d_z_2[1] = (sun_fss5[0] + sun_fss5[3] - sun_fss5[1] - sun_fss5[2]) / (sun_fss5[0] + sun_fss5[1] + sun_fss5[2] + sun_fss5[3]) + cal5[2];
-
-        //printf("Vector X d (+x_b): %f, %f \n", vec_d_x_1[0], vec_d_x_1[1]);
-        //printf("Vector X d (-x_b): %f, %f \n", vec_d_x_2[0], vec_d_x_2[1]);
-        //printf("Vector Y d (+y_b): %f, %f \n", vec_d_y_1[0], vec_d_y_1[1]);
-        //printf("Vector Y d (-y_b): %f, %f \n", vec_d_y_2[0], vec_d_y_2[1]);
-        //printf("Vector Z d (-z_b): %f, %f \n", vec_d_z_2[0], vec_d_z_2[1]);
-
-        double vec_dx_1[2], vec_dy_1[2], vec_dz_2[2], vec_dx_2[2], vec_dy_2[2];
-        _mat_vec_mult((double *) T1, vec_d_x_1, (double *) &vec_dx_1, 2, 2);
-        _mat_vec_mult((double *) T3, vec_d_x_2, (double *) &vec_dx_2, 2, 2);
-        _mat_vec_mult((double *) T4, vec_d_y_1, (double *) &vec_dy_1, 2, 2);
-        _mat_vec_mult((double *) T2, vec_d_y_2, (double *) &vec_dy_2, 2, 2);
-        _mat_vec_mult((double *) T5, vec_d_z_2, (double *) &vec_dz_2, 2, 2);
-
-        double phi_x_1 = atan2(vec_dx_1[0], vec_dx_1[1]); double theta_x_1 = atan(sqrt(vec_dx_1[0] * vec_dx_1[0] + vec_dx_1[1] * vec_dx_1[1]) / cal1[0]);
-        double phi_x_2 = atan2(vec_dx_2[0], vec_dx_2[1]); double theta_x_2 = atan(sqrt(vec_dx_2[0] * vec_dx_2[0] + vec_dx_2[1] * vec_dx_2[1]) / cal3[0]);
-        double phi_y_1 = atan2(vec_dy_1[0], vec_dy_1[1]); double theta_y_1 = atan(sqrt(vec_dy_1[0] * vec_dy_1[0] + vec_dy_1[1] * vec_dy_1[1]) / cal4[0]);
-        double phi_y_2 = atan2(vec_dy_2[0], vec_dy_2[1]); double theta_y_2 = atan(sqrt(vec_dy_2[0] * vec_dy_2[0] + vec_dy_2[1] * vec_dy_2[1]) / cal2[0]);
-        double phi_z_2 = atan2(vec_dz_2[0], vec_dz_2[1]); double theta_z_2 = atan(sqrt(vec_dz_2[0] * vec_dz_2[0] + vec_dx_2[1] * vec_dx_2[1]) / cal5[0]);
-
-        vector3_t sun_vec_cx_1, sun_vec_cy_1, sun_vec_cx_2, sun_vec_cy_2, sun_vec_cz_2;
-        sun_vec_cx_1.v[0] = cos(theta_x_1); sun_vec_cx_1.v[1] = sin(theta_x_1) * cos(phi_x_1); sun_vec_cx_1.v[2] = sin(theta_x_1) * sin(phi_x_1);
-        sun_vec_cx_2.v[0] = cos(theta_x_2); sun_vec_cx_2.v[1] = sin(theta_x_2) * cos(phi_x_2); sun_vec_cx_2.v[2] = sin(theta_x_2) * sin(phi_x_2);
-        sun_vec_cy_1.v[0] = cos(theta_y_1); sun_vec_cy_1.v[1] = sin(theta_y_1) * cos(phi_y_1); sun_vec_cy_1.v[2] = sin(theta_y_1) * sin(phi_y_1);
-        sun_vec_cy_2.v[0] = cos(theta_y_2); sun_vec_cy_2.v[1] = sin(theta_y_2) * cos(phi_y_2); sun_vec_cy_2.v[2] = sin(theta_y_2) * sin(phi_y_2);
-        sun_vec_cz_2.v[0] = cos(theta_z_2); sun_vec_cz_2.v[1] = sin(theta_z_2) * cos(phi_z_2); sun_vec_cz_2.v[2] = sin(theta_z_2) * sin(phi_z_2);
-
-        //printf("SUN VECTOR X+AXIS C: %f, %f, %f \n", sun_vec_cx_1.v[0], sun_vec_cx_1.v[1], sun_vec_cx_1.v[2]);
-        //printf("SUN VECTOR Y+AXIS C: %f, %f, %f \n", sun_vec_cy_1.v[0], sun_vec_cy_1.v[1], sun_vec_cy_1.v[2]);
-        //printf("SUN VECTOR X-AXIS C: %f, %f, %f \n", sun_vec_cx_2.v[0], sun_vec_cx_2.v[1], sun_vec_cx_2.v[2]);
-        //printf("SUN VECTOR Y-AXIS C: %f, %f, %f \n", sun_vec_cy_2.v[0], sun_vec_cy_2.v[1], sun_vec_cy_2.v[2]);
-        //printf("SUN VECTOR Z-AXIS C: %f, %f, %f \n", sun_vec_cz_2.v[0], sun_vec_cz_2.v[1], sun_vec_cz_2.v[2]);
-        // position and orientation of FSS ([0x20: +X], [0x21: -Y], [0x22: -X], [0x23: +Y], [0x24: -Z])
-        vector3_t sun_vec_x1_b = {0,0,0};
-        vector3_t sun_vec_y2_b = {0,0,0};
-        vector3_t sun_vec_x2_b = {0,0,0};
-        vector3_t sun_vec_y1_b = {0,0,0};
-        vector3_t sun_vec_z2_b = {0,0,0};
-        quat_frame_conv(&q_c2b_fss1, &sun_vec_cx_1, &sun_vec_x1_b);
-        quat_frame_conv(&q_c2b_fss2, &sun_vec_cy_2, &sun_vec_y2_b);
-        quat_frame_conv(&q_c2b_fss3, &sun_vec_cx_2, &sun_vec_x2_b);
-        quat_frame_conv(&q_c2b_fss4, &sun_vec_cy_1, &sun_vec_y1_b);
-        quat_frame_conv(&q_c2b_fss5, &sun_vec_cz_2, &sun_vec_z2_b);
-
-        //printf("SUN VECTOR X+AXIS BF: %f, %f, %f \n", sun_vec_x1_b.v[0], sun_vec_x1_b.v[1], sun_vec_x1_b.v[2]);
-        //printf("SUN VECTOR Y+AXIS BF: %f, %f, %f \n", sun_vec_y1_b.v[0], sun_vec_y1_b.v[1], sun_vec_y1_b.v[2]);
-        //printf("SUN VECTOR X-AXIS BF: %f, %f, %f \n", sun_vec_x2_b.v[0], sun_vec_x2_b.v[1], sun_vec_x2_b.v[2]);
-        //printf("SUN VECTOR Y-AXIS BF: %f, %f, %f \n", sun_vec_y2_b.v[0], sun_vec_y2_b.v[1], sun_vec_y2_b.v[2]);
-        //printf("SUN VECTOR Z-AXIS BF: %f, %f, %f \n", sun_vec_x2_b.v[0], sun_vec_x2_b.v[1], sun_vec_x2_b.v[2]);
-
-        sun_vec_b_fss.v[0] = sun_vec_x1_b.v[0] + sun_vec_x2_b.v[0] + sun_vec_y1_b.v[0] + sun_vec_y2_b.v[0] + sun_vec_z2_b.v[0];
-        sun_vec_b_fss.v[1] = sun_vec_x1_b.v[1] + sun_vec_x2_b.v[1] + sun_vec_y1_b.v[1] + sun_vec_y2_b.v[1] + sun_vec_z2_b.v[1];
-        sun_vec_b_fss.v[2] = sun_vec_x1_b.v[2] + sun_vec_x2_b.v[2] + sun_vec_y1_b.v[2] + sun_vec_y2_b.v[2] + sun_vec_z2_b.v[2];
-        vec_normalize(&sun_vec_b_fss, NULL);
-    }
     vector3_t sun_vec_b;
-    vec_sum(ss_unit_b, sun_vec_b_fss, &sun_vec_b);
-    vec_normalize(&sun_vec_b, NULL);
+    if(adcs_drv_read_sun(&sun_vec_b) != ADCS_DRV_OK)
+        return CMD_ERROR;
     _set_sat_vector(&sun_vec_b, dat_sun_vec_b_x);
     //LOGI(tag, "Sun direction: (%f, %f, %f) [@bodyframe]", sun_vec_b.v0, sun_vec_b.v1, sun_vec_b.v2);
     return CMD_OK;
@@ -757,20 +466,25 @@ int adcs_detumbling_mag(char* fmt, char* params, int nparams)
 
 int adcs_set_target(char* fmt, char* params, int nparams)
 {
-    double rot;
     vector3_t i_tar;  // Target vector, intertial frame, read as parameter
+    vector3_t omega_tar;  // Target velocity vector, body frame, read as parameter
+
+    if(params == NULL || sscanf(params, fmt, &i_tar.v0, &i_tar.v1, &i_tar.v2, &omega_tar.v0, &omega_tar.v1, &omega_tar.v2) != nparams)
+        return CMD_ERROR;
+    LOGW(tag, fmt, i_tar.v0, i_tar.v1, i_tar.v2, omega_tar.v0, omega_tar.v1, omega_tar.v2);
+    return adcs_point_to(i_tar, omega_tar) == 0 ? CMD_OK : CMD_ERROR;
+}
+
+int adcs_point_to(vector3_t i_tar, vector3_t omega_tar)
+{
+    double rot;
     vector3_t b_tar;
     vector3_t b_dir;  // Face to point to, body frame
     vector3_t b_lambda;
-    vector3_t omega_tar;  // Target velocity vector, body frame, read as parameter
     quaternion_t q_i2b_est;
     quaternion_t q_b2b_now2tar;
     quaternion_t q_i2b_tar; // Target quaternion, inertial to body frame. Calculate
 
-    if(params == NULL || sscanf(params, fmt, &i_tar.v0, &i_tar.v1, &i_tar.v2, &omega_tar.v0, &omega_tar.v1, &omega_tar.v2) != nparams)
-        return CMD_ERROR;
-//  int p = sscanf(params, fmt, &i_tar.v0, &i_tar.v1, &i_tar.v2, &omega_tar.v0, &omega_tar.v1, &omega_tar.v2);
-    LOGW(tag, fmt, i_tar.v0, i_tar.v1, i_tar.v2, omega_tar.v0, omega_tar.v1, omega_tar.v2);
     // Set Z+ [0, 0, 1] as the face to point to
     b_dir.v0 = 0.0; b_dir.v1 = 0.0; b_dir.v2 = 1.0;
     vec_normalize(&b_dir, NULL);
@@ -793,7 +507,7 @@ int adcs_set_target(char* fmt, char* params, int nparams)
     _set_sat_vector(&omega_tar, dat_tgt_omega_x);
 
     LOGI(tag, "TGT QUAT: %lf %lf %lf %lf", q_i2b_tar.q0, q_i2b_tar.q1, q_i2b_tar.q2, q_i2b_tar.q3);
-    return CMD_OK;
+    return 0;
 }
 
 int adcs_send_attitude(char* fmt, char* params, int nparams)
@@ -801,32 +515,12 @@ int adcs_send_attitude(char* fmt, char* params, int nparams)
     quaternion_t q_est, q_tgt;
     _get_sat_quaterion(&q_est, dat_ads_ekf_q0);
     _get_sat_quaterion(&q_tgt, dat_tgt_q0);
-
-    csp_packet_t *packet = csp_buffer_get(COM_FRAME_MAX_LEN);
-    if(packet == NULL)
-        return CMD_ERROR;
-
-    int len = snprintf(packet->data, COM_FRAME_MAX_LEN,
-                       "adcs_set_attitude %lf %lf %lf %lf %lf %lf %lf %lf",
-                       q_est.q0, q_est.q1, q_est.q2, q_est.q3,
-                       q_tgt.q0, q_tgt.q1, q_tgt.q2, q_tgt.q3);
-    packet->length = len;
-    LOGI(tag, "OBC ATT: (%d) %s", packet->length, packet->data);
-
-    int rc = csp_sendto(CSP_PRIO_NORM, ADCS_PORT, SCH_TRX_PORT_CMD,
-                        SCH_TRX_PORT_CMD, CSP_O_NONE, packet, 100);
-
-    if(rc != 0)
-    {
-        csp_buffer_free((void *)packet);
-        return CMD_ERROR;
-    }
-
-    return CMD_OK;
+    return adcs_drv_send_attitude(&q_est, &q_tgt) == ADCS_DRV_OK ? CMD_OK : CMD_ERROR;
 }
 
 int adcs_mag_moment(char* fmt, char* params, int nparams)
 {
+    ADCS_TIM_START(t_ctrl);
     // GLOBALS
     vector3_t max_mag_am2;
     max_mag_am2.v[0] = 0.35;
@@ -872,6 +566,7 @@ int adcs_mag_moment(char* fmt, char* params, int nparams)
     vector3_t control_mag_moment_temp, control_mag_moment;
     vec_outer_product(nT2T_mag_earth_b_est, control_torque, &control_mag_moment_temp);//mc* = Bxt
     vec_cons_mult(inv_b_norm2, &control_mag_moment_temp, &control_mag_moment); //mc =  Bxt / ||B_est||**2
+    ADCS_TIM_STOP(ADCS_TIM_CONTROL, t_ctrl);
 
     LOGI(tag, "CTRL_MAG_MOMENT: %f, %f, %f", control_mag_moment.v0, control_mag_moment.v1, control_mag_moment.v2);
 
@@ -919,27 +614,8 @@ int adcs_mag_moment(char* fmt, char* params, int nparams)
         }
     }
 
-    //Enable MTQ's through PWM commands
-    //Check when the power on cmd should be call
-    gs_a3200_pwr_switch_enable(GS_A3200_PWR_GSSB);
-    gs_a3200_pwr_switch_enable(GS_A3200_PWR_GSSB2);
-    osDelay(20);
-    cmd_t *cmd_set_on_mtt = cmd_get_str("mtt_set_pwr");
-    cmd_add_params_var(cmd_set_on_mtt, 1);
-    cmd_send(cmd_set_on_mtt)
-    osDelay(20);
-    cmd_t *cmd_set_pwm_x = cmd_get_str("mtt_set_duty");
-    cmd_add_params_var(cmd_set_pwm_x, 0, mtq_duty[0]);
-    cmd_send(cmd_set_pwm_x);
-    osDelay(20);
-    cmd_t *cmd_set_pwm_y = cmd_get_str("mtt_set_duty");
-    cmd_add_params_var(cmd_set_pwm_y, 1, mtq_duty[1]);
-    cmd_send(cmd_set_pwm_y);
-    osDelay(20);
-    cmd_t *cmd_set_pwm_z = cmd_get_str("mtt_set_duty");
-    cmd_add_params_var(cmd_set_pwm_z, 2, mtq_duty[2]);
-    cmd_send(cmd_set_pwm_z);
-    osDelay(20);
+    //Enable MTQ's and set the PWM duty
+    adcs_drv_set_mtq(mtq_duty);
     packet->length = len;
     LOGI(tag, "ADCS CMD: (%d) %s", packet->length, packet->data);
 
@@ -948,7 +624,7 @@ int adcs_mag_moment(char* fmt, char* params, int nparams)
     int index_ads = dat_get_system_var(data_map[ctrl_data].sys_index);
     ctrl_data_t data_ads_ctrl = {index_ads, curr_time, control_mag_moment.v0, control_mag_moment.v1,
                                control_mag_moment.v2, mtq_duty[0], mtq_duty[1], mtq_duty[2]};
-    dat_add_payload_sample(&data_ads_ctrl, ctrl_data);
+    evt_add_payload_sample(&data_ads_ctrl, ctrl_data);
 
     int rc = csp_sendto(CSP_PRIO_NORM, ADCS_PORT, SCH_TRX_PORT_CMD,
                         SCH_TRX_PORT_CMD, CSP_O_NONE, packet, 100);
@@ -971,7 +647,11 @@ int adcs_point(char* fmt, char* params, int nparams)
     memset(packet->data, 0, COM_FRAME_MAX_LEN);
 
     vector3_t r;
-    _get_sat_vector(&r, dat_ads_pos_x);
+    if(orbit_prop_get((double)dat_get_time(), &r, NULL) != 0)
+    {
+        csp_buffer_free((void *)packet);
+        return CMD_ERROR;
+    }
 
     int len = snprintf(packet->data, COM_FRAME_MAX_LEN,
                        "adcs_point_to %lf %lf %lf", r.v0, r.v1, r.v2);
@@ -1027,8 +707,15 @@ int adcs_get_quaternion(char* fmt, char* params, int nparams)
 
 int adcs_control_torque(char* fmt, char* params, int nparams)
 {
-    // GLOBALS
     double ctrl_cycle;
+    if(params == NULL || sscanf(params, fmt, &ctrl_cycle) != nparams)
+        return CMD_SYNTAX_ERROR;
+    return adcs_do_control(ctrl_cycle) == 0 ? CMD_OK : CMD_ERROR;
+}
+
+int adcs_do_control(double ctrl_cycle)
+{
+    // GLOBALS
     matrix3_t I_quat;
     mat_set_diag(&I_quat, 0.00, 0.00, 0.00);
     matrix3_t P_quat;
@@ -1036,9 +723,7 @@ int adcs_control_torque(char* fmt, char* params, int nparams)
     matrix3_t P_omega;
     mat_set_diag(&P_omega, 0.003, 0.003, 0.003);
 
-    if(params == NULL || sscanf(params, fmt, &ctrl_cycle) != nparams)
-        return CMD_SYNTAX_ERROR;
-
+    ADCS_TIM_START(t_ctrl);
     // PARAMETERS
     quaternion_t q_i2b_est; // Current quaternion. Read as from ADCS
     quaternion_t q_i2b_tar; // Target quaternion. Read as parameter
@@ -1090,12 +775,13 @@ int adcs_control_torque(char* fmt, char* params, int nparams)
     vector3_t control_torque_tmp, control_torque;
     vec_sum(P, I, &control_torque_tmp);
     vec_sum(P_o, control_torque_tmp, &control_torque);
+    ADCS_TIM_STOP(ADCS_TIM_CONTROL, t_ctrl);
 
     LOGI(tag, "CTRL_TORQUE: %f, %f, %f", control_torque.v0, control_torque.v1, control_torque.v2);
 
     csp_packet_t *packet = csp_buffer_get(COM_FRAME_MAX_LEN);
     if(packet == NULL)
-        return CMD_ERROR;
+        return -1;
 
     int len = snprintf(packet->data, COM_FRAME_MAX_LEN,
                        "adcs_set_torque %.06f %.06f %.06f",
@@ -1109,49 +795,85 @@ int adcs_control_torque(char* fmt, char* params, int nparams)
     if(rc != 0)
     {
         csp_buffer_free((void *)packet);
-        return CMD_ERROR;
+        return -1;
     }
 
-    return CMD_OK;
+    return 0;
 }
 
 int adcs_target_nadir(char* fmt, char* params, int nparams)
 {
+    vector3_t pos_i, vel_i;
+    if(orbit_prop_get((double)dat_get_time(), &pos_i, &vel_i) != 0)
+        return CMD_ERROR;
+
     // Get Nadir vector
     vector3_t i_tar;
-    _get_sat_vector(&i_tar, dat_ads_pos_x);
-    vec_cons_mult(-1.0, &i_tar, NULL);
-    vector3_t v_tar;
-    _get_sat_vector(&v_tar, dat_ads_pos_x);
-    vec_cons_mult(-1.0, &v_tar, NULL);
-
-    vector3_t temp;
-    vec_outer_product(i_tar, v_tar, &temp);
-
-    double rr = vec_norm(i_tar);
-    rr *= rr;
-
+    vec_cons_mult(-1.0, &pos_i, &i_tar);
     vec_normalize(&i_tar, NULL);
-    vec_normalize(&v_tar, NULL);
 
-    // Get required Nadir velocity
+    // Get required Nadir velocity, r x v / |r|^2
     // Target GYRO. ECI frame. For LEO sat -> nadir
+    double rr = vec_norm(pos_i);
     vector3_t omega_i_tar;
-    vec_cons_mult(rr, &temp, &omega_i_tar);
+    vec_outer_product(pos_i, vel_i, &omega_i_tar);
+    vec_cons_mult(1.0 / (rr * rr), &omega_i_tar, NULL);
 
     vector3_t omega_b_tar;
     quaternion_t q_i2b_est;
     _get_sat_quaterion(&q_i2b_est, dat_ads_q0);
     quat_frame_conv(&q_i2b_est, &omega_i_tar, &omega_b_tar);
 
-    char *_fmt = "%lf %lf %lf %lf %lf %lf";
-    char _params[SCH_CMD_MAX_STR_PARAMS];
-    memset(_params, 0, SCH_CMD_MAX_STR_PARAMS);
-    snprintf(_params, SCH_CMD_MAX_STR_PARAMS, _fmt, i_tar.v0, i_tar.v1, i_tar.v2,
-             omega_b_tar.v0, omega_b_tar.v1, omega_b_tar.v2);
-    int ret = adcs_set_target(_fmt, _params, 6);
+    return adcs_point_to(i_tar, omega_b_tar) == 0 ? CMD_OK : CMD_ERROR;
+}
+
+#endif
+
+int adcs_tim_print_stats(char* fmt, char* params, int nparams)
+{
+    adcs_tim_print();
+    return CMD_OK;
+}
+
+int adcs_tim_flush_stats(char* fmt, char* params, int nparams)
+{
+    int saved = adcs_tim_flush();
+    LOGI(tag, "ADCS timing: %d stages saved", saved);
+    return CMD_OK;
+}
 
-    return ret;
+int adcs_igrf_set_error(char* fmt, char* params, int nparams)
+{
+    double max_err;
+    if(params == NULL || sscanf(params, fmt, &max_err) != nparams)
+    {
+        LOGE(tag, "Error parsing parameters!");
+        return CMD_SYNTAX_ERROR;
+    }
+    igrf_cache_set_max_error(max_err);
+    double err;
+    int nmax = igrf_cache_get_degree(&err);
+    LOGI(tag, "IGRF degree: %d, truncation error: %.1f nT", nmax, err);
+    return CMD_OK;
 }
 
-#endif
\ No newline at end of file
+int adcs_igrf_check(char* fmt, char* params, int nparams)
+{
+    double lat, lon, alt;
+    if(params == NULL || sscanf(params, fmt, &lat, &lon, &alt) != nparams)
+    {
+        LOGE(tag, "Error parsing parameters!");
+        return CMD_SYNTAX_ERROR;
+    }
+    double dec_year = jd_to_dec(unixt_to_jd((uint32_t)time(NULL)));
+    vector3_t mag_ref, mag_cache, diff;
+    // Sidereal time 0, so both fields are in the Earth fixed frame
+    IgrfCalc(dec_year, lat * deg2rad, lon * deg2rad, alt * 1000, 0, &mag_ref);
+    int nmax = igrf_cache_calc(dec_year, lat * deg2rad, lon * deg2rad, alt * 1000, 0, &mag_cache);
+    vec_cons_mult(-1.0, &mag_ref, &diff);
+    vec_sum(mag_cache, diff, &diff);
+    LOGR(tag, "IgrfCalc: (%.1f, %.1f, %.1f) nT", mag_ref.v0, mag_ref.v1, mag_ref.v2);
+    LOGR(tag, "Cached (degree %d): (%.1f, %.1f, %.1f) nT", nmax, mag_cache.v0, mag_cache.v1, mag_cache.v2);
+    LOGR(tag, "Difference: %.1f nT", vec_norm(diff));
+    return CMD_OK;
+}
@@ -29,10 +29,22 @@ void cmd_cdh_init(void)
     cmd_add("obc_set_mode", obc_set_mode, "%s", 1);
     cmd_add("obc_cancel_deploy", obc_cancel_deploy, "", 0);
     cmd_add("obc_update_status", obc_update_status, "", 0);
+    cmd_add("obc_sts_flush", obc_sts_flush, "", 0);
+    cmd_add("obc_sts_cache", obc_sts_cache, "%d %d", 2);
+    cmd_add("obc_sts_print", obc_sts_print, "", 0);
     cmd_add("tm_send_msg", tm_send_msg, "%d %s",  2);
     cmd_add("tm_parse_msg", tm_parse_msg, "", 0);
+    cmd_add("tm_send_msgs", tm_send_msgs, "%d %d %d", 3);
+    cmd_add("tm_send_schema", tm_send_schema, "%d", 1);
     cmd_add("tm_send_beacon", tm_send_beacon, "%d", 1);
     cmd_add("tm_parse_beacon", tm_parse_beacon, "", 0);
+    cmd_add("tm_send_pay_delta", tm_send_pay_delta, "%d %d %d", 3);
+    cmd_add("tm_send_pass", tm_send_pass, "%d %d", 2);
+    cmd_add("tm_set_dl_class", tm_set_dl_class, "%d %d %d", 3);
+    cmd_add("tm_set_dl_payload", tm_set_dl_payload, "%d %d", 2);
+    cmd_add("tm_print_dl", tm_print_dl, "", 0);
+
+    dl_sched_init();
 }
 
 int obc_set_mode(char *fmt, char *params, int nparams)
@@ -61,7 +73,7 @@ int obc_set_mode(char *fmt, char *params, int nparams)
     }
 
     LOGR(tag, "Opmode %s (%d) selected!", params, opmode);
-    dat_set_system_var(dat_obc_opmode, opmode);
+    sts_set_system_var(dat_obc_opmode, opmode);
 
     return CMD_OK;
 }
@@ -95,10 +107,30 @@ int obc_update_status(char *fmt, char *params, int nparams)
         return CMD_ERROR;
     }
 
-    rc = dat_set_system_var(dat_obc_temp_1, (t_obc1 + t_obc2) * 10 / 2);
+    rc = sts_set_system_var(dat_obc_temp_1, (t_obc1 + t_obc2) * 10 / 2);
     return rc == 0 ? CMD_OK : CMD_ERROR;
 }
 
+int obc_sts_flush(char *fmt, char *params, int nparams)
+{
+    return sts_flush() >= 0 ? CMD_OK : CMD_ERROR;
+}
+
+int obc_sts_cache(char *fmt, char *params, int nparams)
+{
+    int address, enable;
+    if(params == NULL || sscanf(params, fmt, &address, &enable) != nparams || address < 0)
+        return CMD_SYNTAX_ERROR;
+
+    return sts_set_write_back(address, enable) == 0 ? CMD_OK : CMD_SYNTAX_ERROR;
+}
+
+int obc_sts_print(char *fmt, char *params, int nparams)
+{
+    sts_print();
+    return CMD_OK;
+}
+
 int tm_send_msg(char *fmt, char *params, int nparams) {
     int node;
     char msg[SCH_ST_STR_SIZE];
@@ -119,17 +151,99 @@ int tm_parse_msg(char *fmt, char *params, int nparams) {
     com_frame_t *frame = (com_frame_t *)params;
     char msg[SCH_ST_STR_SIZE];
     strncpy(msg, (char *)frame->data.data8, SCH_ST_STR_SIZE);
+    msg[SCH_ST_STR_SIZE-1] = '\0';
+    int len = (int)strlen(msg);
+    if(len == 0)
+        return CMD_ERROR;
+
+    // Store only the message bytes, see recordStore.h
+    int id = rec_add((uint8_t *)msg, len < REC_MAX_LEN ? len : REC_MAX_LEN, dat_get_time());
+    LOGI(tag, "String message %d is %s", id, msg);
+    return id != -1 ? CMD_OK : CMD_ERROR;
+}
 
-    string_data_t message;
-    message.index = dat_get_system_var(data_map[msg_sensors].sys_index);
-    //message.index = dat_get_system_var(dat_drp_idx_str);
-    message.timestamp = dat_get_time();
-    memset(message.msg, 0, SCH_ST_STR_SIZE);
-    strcpy(message.msg, (char *)frame->data.data8);
+int tm_send_msgs(char *fmt, char *params, int nparams)
+{
+    int node, first, max_frames;
+    if(params == NULL || sscanf(params, fmt, &node, &first, &max_frames) != nparams || max_frames < 0)
+        return CMD_SYNTAX_ERROR;
 
-    int rc = dat_add_payload_sample(&message, msg_sensors);
-    LOGI(tag, "String message is %s", message.msg);
-    return rc != -1 ? CMD_OK : CMD_ERROR;
+    uint32_t id = first < 0 || (uint32_t)first < rec_get_first_id() ? rec_get_first_id() : (uint32_t)first;
+    uint32_t last = rec_get_next_id();
+    uint8_t frame[sizeof(((com_frame_t *)0)->data)];
+    static uint8_t text[TM_MSGS_TEXT_LEN];   // Raw messages of the frame, compression history
+    int nframe = 0, nmsg = 0, nraw = 0, nsent = 0;
+    int rc = CMD_OK;
+
+    while(id < last && (max_frames == 0 || nframe < max_frames) && rc == CMD_OK)
+    {
+        // Pack whole compressed messages until the next one does not fit
+        int used = msg_pack_init_dict(frame, sizeof(frame));
+        int hist = 0;
+        while(id < last && hist + REC_MAX_LEN <= sizeof(text))
+        {
+            uint32_t timestamp;
+            int len = rec_get(id, text + hist, REC_MAX_LEN, &timestamp);
+            if(len < 0)
+            {
+                id++;   // Not retained
+                continue;
+            }
+            int next = msg_pack_add_dict(frame, sizeof(frame), used, id, timestamp, text, hist, len);
+            if(next < 0 && msg_unpack_count(frame, used) == 0)
+            {
+                // Does not fit even alone, send it uncompressed and truncated
+                int max_len = (int)sizeof(frame) - MSG_PACK_HEADER_LEN - MSG_PACK_RECORD_LEN;
+                if(len > max_len)
+                {
+                    LOGW(tag, "Message %u truncated from %d to %d bytes", (unsigned int)id, len, max_len);
+                    len = max_len;
+                }
+                used = msg_pack_init(frame, sizeof(frame));
+                next = msg_pack_add(frame, sizeof(frame), used, id, timestamp, text, len);
+            }
+            if(next < 0 && msg_unpack_count(frame, used) == 0)
+            {
+                LOGE(tag, "Message %u can not be packed, skipped", (unsigned int)id);
+                id++;
+                continue;
+            }
+            if(next < 0)
+                break;
+            used = next;
+            hist += len;
+            nmsg++;
+            id++;
+            if(frame[0] == MSG_PACK_VERSION)
+                break;
+        }
+        if(msg_unpack_count(frame, used) == 0)
+            break;
+        nraw += hist;
+        nsent += used;
+        rc = com_send_telemetry(node, SCH_TRX_PORT_CDH, TM_TYPE_MSG_PACKED, frame, used, 1, nframe++);
+    }
+
+    LOGI(tag, "Sent %d messages in %d frames (%d bytes in %d bytes)", nmsg, nframe, nraw, nsent);
+    return rc;
+}
+
+int tm_send_schema(char *fmt, char *params, int nparams)
+{
+    int node;
+    if(params == NULL || sscanf(params, fmt, &node) != nparams)
+        return CMD_SYNTAX_ERROR;
+
+    uint32_t layout = dat_schema_layout_hash;
+    uint32_t hash = dat_schema_hash(0, DAT_SCHEMA_NPAYLOADS);
+    uint8_t frame[TM_SCHEMA_LEN] = {TM_SCHEMA_VERSION, 0, DAT_SCHEMA_NPAYLOADS,
+                                    (uint8_t)(dat_status_last_address >> 8), (uint8_t)dat_status_last_address,
+                                    (uint8_t)(layout >> 24), (uint8_t)(layout >> 16), (uint8_t)(layout >> 8), (uint8_t)layout,
+                                    (uint8_t)(hash >> 24), (uint8_t)(hash >> 16), (uint8_t)(hash >> 8), (uint8_t)hash};
+
+    LOGI(tag, "Schema: %d payloads, %d status vars, layout 0x%08X, payloads 0x%08X", DAT_SCHEMA_NPAYLOADS,
+         dat_status_last_address, (unsigned int)layout, (unsigned int)hash);
+    return com_send_telemetry(node, SCH_TRX_PORT_CDH, TM_TYPE_SCHEMA, frame, sizeof(frame), 1, 0);
 }
 
 int tm_send_beacon(char *fmt, char *params, int nparams)
@@ -141,9 +255,12 @@ int tm_send_beacon(char *fmt, char *params, int nparams)
     }
 
     status_data_t status;
+    uint8_t beacon[BCN_PACK_MAX_LEN];
     obc_read_status_basic(&status);
-    _hton32_buff((uint32_t *)&status, sizeof(status_data_t)/sizeof(uint32_t));
-    return com_send_telemetry(node, SCH_TRX_PORT_CDH, TM_TYPE_PAYLOAD_STA, &status, sizeof(status_data_t), 1, 0);
+    int len = bcn_pack(&status, beacon, sizeof(beacon));
+    if(len < 0)
+        return CMD_ERROR;
+    return com_send_telemetry(node, SCH_TRX_PORT_CDH, TM_TYPE_BEACON_PACKED, beacon, len, 1, 0);
 }
 
 int tm_parse_beacon(char *fmt, char *params, int nparams)
@@ -153,37 +270,164 @@ int tm_parse_beacon(char *fmt, char *params, int nparams)
 
     com_frame_t *frame = (com_frame_t *)params;
     status_data_t sta_data;
-    memcpy(&sta_data, frame->data.data8, sizeof(status_data_t));
-    _ntoh32_buff((uint32_t *)&sta_data, sizeof(status_data_t)/sizeof(uint32_t));
+    if(frame->type == TM_TYPE_BEACON_PACKED)
+    {
+        int version = bcn_unpack(frame->data.data8, sizeof(frame->data.data8), &sta_data);
+        if(version < 0)
+        {
+            LOGE(tag, "Beacon version %d not supported", frame->data.data8[0]);
+            return CMD_ERROR;
+        }
+        LOGI(tag, "Beacon version %d", version);
+    }
+    else
+    {
+        memcpy(&sta_data, frame->data.data8, sizeof(status_data_t));
+        _ntoh32_buff((uint32_t *)&sta_data, sizeof(status_data_t)/sizeof(uint32_t));
+    }
     dat_print_payload_struct(&sta_data, status_sensors);
 }
 
 int obc_read_status_basic(status_data_t *status)
 {
+    // Same order as status_data_t, after index and timestamp
+    static const dat_status_address_t vars[] = {
+            dat_obc_opmode, dat_rtc_date_time, dat_obc_last_reset, dat_obc_hrs_alive, dat_obc_hrs_wo_reset,
+            dat_obc_reset_counter, dat_obc_executed_cmds, dat_obc_failed_cmds, dat_com_count_tm, dat_com_count_tc,
+            dat_com_last_tc, dat_fpl_last, dat_fpl_queue, dat_ads_tle_epoch, dat_eps_vbatt, dat_eps_cur_sun,
+            dat_eps_cur_sys, dat_obc_temp_1, dat_eps_temp_bat0, dat_drp_mach_action, dat_drp_mach_state,
+            dat_drp_mach_payloads, dat_drp_mach_step
+    };
+    value32_t values[sizeof(vars)/sizeof(vars[0])];
+
+    // Read all the variables in one snapshot
+    sts_snapshot(vars, sizeof(vars)/sizeof(vars[0]), values);
     status->timestamp = dat_get_time();
     status->index = dat_get_system_var(data_map[temp_sensors].sys_index);
-    status->dat_obc_opmode = dat_get_system_var(dat_obc_opmode);
-    status->dat_rtc_date_time = dat_get_system_var(dat_rtc_date_time);
-    status->dat_obc_last_reset = dat_get_system_var(dat_obc_last_reset);
-    status->dat_obc_hrs_alive = dat_get_system_var(dat_obc_hrs_alive);
-    status->dat_obc_hrs_wo_reset = dat_get_system_var(dat_obc_hrs_wo_reset);
-    status->dat_obc_reset_counter = dat_get_system_var(dat_obc_reset_counter);
-    status->dat_obc_executed_cmds = dat_get_system_var(dat_obc_executed_cmds);
-    status->dat_obc_failed_cmds = dat_get_system_var(dat_obc_failed_cmds);
-    status->dat_com_count_tm = dat_get_system_var(dat_com_count_tm);
-    status->dat_com_count_tc = dat_get_system_var(dat_com_count_tc);
-    status->dat_com_last_tc = dat_get_system_var(dat_com_last_tc);
-    status->dat_fpl_last = dat_get_system_var(dat_fpl_last);
-    status->dat_fpl_queue = dat_get_system_var(dat_fpl_queue);
-    status->dat_ads_tle_epoch = dat_get_system_var(dat_ads_tle_epoch);
-    status->dat_eps_vbatt = dat_get_system_var(dat_eps_vbatt);
-    status->dat_eps_cur_sun = dat_get_system_var(dat_eps_cur_sun);
-    status->dat_eps_cur_sys = dat_get_system_var(dat_eps_cur_sys);
-    status->dat_obc_temp_1 = dat_get_system_var(dat_obc_temp_1);
-    status->dat_eps_temp_bat0 = dat_get_system_var(dat_eps_temp_bat0);
-    status->dat_drp_mach_action = dat_get_system_var(dat_drp_mach_action);
-    status->dat_drp_mach_state = dat_get_system_var(dat_drp_mach_state);
-    status->dat_drp_mach_payloads = dat_get_system_var(dat_drp_mach_payloads);
-    status->dat_drp_mach_step = dat_get_system_var(dat_drp_mach_step);
+    memcpy(&status->dat_obc_opmode, values, sizeof(values));
+    return CMD_OK;
+}
+
+int tm_send_pay_delta(char *fmt, char *params, int nparams)
+{
+    int node, payload, n_samples;
+    if(params == NULL || sscanf(params, fmt, &node, &payload, &n_samples) != nparams)
+        return CMD_SYNTAX_ERROR;
+    if(payload < 0 || payload >= last_sensor || n_samples <= 0)
+        return CMD_SYNTAX_ERROR;
+
+    data_map_t *map = &data_map[payload];
+    uint8_t widths[TM_DELTA_MAX_FIELDS];
+    if(tm_delta_get_layout(map, widths, TM_DELTA_MAX_FIELDS) < 0)
+    {
+        LOGE(tag, "Payload %d can not be delta encoded", payload);
+        return CMD_ERROR;
+    }
+
+    // Send from the last acknowledged sample
+    int first = dat_get_system_var(map->sys_ack);
+    if(first < ret_get_first(payload))
+        first = ret_get_first(payload);
+    int last = dat_get_system_var(data_map[payload].sys_index);
+    int total = last - first < n_samples ? last - first : n_samples;
+    if(total <= 0)
+    {
+        LOGW(tag, "No samples to send from payload %d (ack: %d, index: %d)", payload, first, last);
+        return CMD_OK;
+    }
+
+    int nbuff = total < TM_DELTA_MAX_SAMPLES ? total : TM_DELTA_MAX_SAMPLES;
+    uint8_t *samples = (uint8_t *)malloc(nbuff * map->size);
+    if(samples == NULL)
+        return CMD_ERROR;
+
+    uint8_t frame[sizeof(((com_frame_t *)0)->data)];
+    int rc = CMD_OK;
+    int sent = 0;
+    int loaded = 0;
+    int offset = 0;
+    int nframe = 0;
+    int nbytes = 0;
+    int next = first;
+    while(sent < total && rc == CMD_OK)
+    {
+        // Load the next batch of samples when the buffer is consumed, skipping
+        // the samples not retained
+        if(offset >= loaded)
+        {
+            loaded = total - sent < nbuff ? total - sent : nbuff;
+            offset = 0;
+            int i;
+            for(i = 0; i < loaded; i++)
+            {
+                next = ret_get_next(payload, next);
+                if(next >= last || ret_get_payload_sample(samples + i * map->size, payload, next) < 0)
+                    break;
+                next++;
+            }
+            loaded = i;
+            if(loaded == 0)
+            {
+                if(next < last)
+                {
+                    LOGE(tag, "Error reading payload %d sample %d", payload, next);
+                    rc = CMD_ERROR;
+                }
+                break;
+            }
+        }
+
+        int used;
+        int len = tm_delta_encode(map, payload, samples + offset * map->size, loaded - offset,
+                                  frame, sizeof(frame), &used);
+        if(len < 0 || used == 0)
+        {
+            rc = CMD_ERROR;
+            break;
+        }
+
+        rc = com_send_telemetry(node, SCH_TRX_PORT_CDH, TM_TYPE_PAYLOAD_DELTA, frame, len, 1, nframe++);
+        offset += used;
+        sent += used;
+        nbytes += len;
+    }
+
+    free(samples);
+    LOGI(tag, "Sent %d samples of payload %d in %d frames (%d bytes, %d raw)", sent, payload, nframe,
+         nbytes, sent * map->size);
+    return rc;
+}
+
+int tm_send_pass(char *fmt, char *params, int nparams)
+{
+    int node, max_bytes;
+    if(params == NULL || sscanf(params, fmt, &node, &max_bytes) != nparams || max_bytes < 0)
+        return CMD_SYNTAX_ERROR;
+
+    int sent = dl_sched_pass(node, SCH_TRX_PORT_CDH, max_bytes);
+    return sent >= 0 ? CMD_OK : CMD_ERROR;
+}
+
+int tm_set_dl_class(char *fmt, char *params, int nparams)
+{
+    int class, priority, budget;
+    if(params == NULL || sscanf(params, fmt, &class, &priority, &budget) != nparams)
+        return CMD_SYNTAX_ERROR;
+
+    return dl_sched_set_class(class, priority, budget) == 0 ? CMD_OK : CMD_SYNTAX_ERROR;
+}
+
+int tm_set_dl_payload(char *fmt, char *params, int nparams)
+{
+    int payload, class;
+    if(params == NULL || sscanf(params, fmt, &payload, &class) != nparams)
+        return CMD_SYNTAX_ERROR;
+
+    return dl_sched_set_payload(payload, class) == 0 ? CMD_OK : CMD_SYNTAX_ERROR;
+}
+
+int tm_print_dl(char *fmt, char *params, int nparams)
+{
+    dl_sched_print();
     return CMD_OK;
-}
\ No newline at end of file
+}
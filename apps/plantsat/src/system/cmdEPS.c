@@ -60,6 +60,10 @@ int eps_node_set(char *fmt, char *params, int nparams)
 
 int eps_hard_reset(char *fmt, char *params, int nparams)
 {
+    // Do not lose buffered records, payload pages and cached status variables
+    rec_flush();
+    sbuf_flush();
+    sts_flush();
     if(eps_hardreset() > 0)
         return CMD_OK;
 
@@ -197,10 +201,10 @@ int eps_update_status_vars(char *fmt, char *params, int nparams)
     eps_hk_t hk = {};
     if(eps_hk_get(&hk) > 0)
     {
-        dat_set_system_var(dat_eps_vbatt, hk.vbatt);
-        dat_set_system_var(dat_eps_cur_sun, hk.cursun);
-        dat_set_system_var(dat_eps_cur_sys, hk.cursys);
-        dat_set_system_var(dat_eps_temp_bat0, (hk.temp[4]+hk.temp[5])*10/2);
+        sts_set_system_var(dat_eps_vbatt, hk.vbatt);
+        sts_set_system_var(dat_eps_cur_sun, hk.cursun);
+        sts_set_system_var(dat_eps_cur_sys, hk.cursys);
+        sts_set_system_var(dat_eps_temp_bat0, (hk.temp[4]+hk.temp[5])*10/2);
     }
     else
     {
@@ -65,17 +65,17 @@ int rw_get_speed(char *fmt, char *params, int nparams)
     if(motorid > 0 && motorid < 4)
     {
         LOGI(tag, "Getting speed %d", motorid);
-        uint16_t speed = rwdrv10987_get_speed(motorid);
+        uint16_t speed = adcs_drv_get_rw_speed(motorid);
         LOGR(tag, "Sampled speed%d: %d", motorid, speed);
     }
     else
     {
         LOGI(tag, "Getting all speeds");
-        uint16_t speed1 = rwdrv10987_get_speed(RW_MOTOR1_ID);
+        uint16_t speed1 = adcs_drv_get_rw_speed(RW_MOTOR1_ID);
         osDelay(RW_COMM_DELAY_MS);
-        uint16_t speed2 = rwdrv10987_get_speed(RW_MOTOR2_ID);
+        uint16_t speed2 = adcs_drv_get_rw_speed(RW_MOTOR2_ID);
         osDelay(RW_COMM_DELAY_MS);
-        uint16_t speed3 = rwdrv10987_get_speed(RW_MOTOR3_ID);
+        uint16_t speed3 = adcs_drv_get_rw_speed(RW_MOTOR3_ID);
         osDelay(RW_COMM_DELAY_MS);
         LOGR(tag, "Sampled speed1: %d, speed2: %d, speed3: %d", speed1, speed2, speed3);
     }
@@ -93,17 +93,17 @@ int rw_get_current(char *fmt, char *params, int nparams)
     if(motorid > 0 && motorid < 4)
     {
         LOGI(tag, "Sampling current %d", motorid)
-        float current = rwdrv10987_get_current(motorid); //[mA]
+        float current = adcs_drv_get_rw_current(motorid); //[mA]
         LOGR(tag, "Sampled current%d: %f", motorid, current);
     }
     else
     {
         LOGI(tag, "Sampling all currents");
-        float current1 = rwdrv10987_get_current(RW_MOTOR1_ID); //[mA]
+        float current1 = adcs_drv_get_rw_current(RW_MOTOR1_ID); //[mA]
         osDelay(RW_COMM_DELAY_MS);
-        float current2 = rwdrv10987_get_current(RW_MOTOR2_ID); //[mA]
+        float current2 = adcs_drv_get_rw_current(RW_MOTOR2_ID); //[mA]
         osDelay(RW_COMM_DELAY_MS);
-        float current3 = rwdrv10987_get_current(RW_MOTOR3_ID); //[mA]
+        float current3 = adcs_drv_get_rw_current(RW_MOTOR3_ID); //[mA]
         osDelay(RW_COMM_DELAY_MS);
         LOGR(tag, "Sampled current1: %f, current2: %f, current3: %f", current1, current2, current3);
     }
@@ -117,20 +117,20 @@ int rw_get_data(char *fmt, char *params, int nparams)
     data.index = dat_get_system_var(data_map[rw_sensors].sys_index);
     data.timestamp = dat_get_time();
 
-    data.speed1 = rwdrv10987_get_speed(RW_MOTOR1_ID);
+    data.speed1 = adcs_drv_get_rw_speed(RW_MOTOR1_ID);
     osDelay(RW_COMM_DELAY_MS);
-    data.speed2 = rwdrv10987_get_speed(RW_MOTOR2_ID);
+    data.speed2 = adcs_drv_get_rw_speed(RW_MOTOR2_ID);
     osDelay(RW_COMM_DELAY_MS);
-    data.speed3 = rwdrv10987_get_speed(RW_MOTOR3_ID);
+    data.speed3 = adcs_drv_get_rw_speed(RW_MOTOR3_ID);
     osDelay(RW_COMM_DELAY_MS);
-    data.current1 = rwdrv10987_get_current(RW_MOTOR1_ID); //[mA]
+    data.current1 = adcs_drv_get_rw_current(RW_MOTOR1_ID); //[mA]
     osDelay(RW_COMM_DELAY_MS);
-    data.current2 = rwdrv10987_get_current(RW_MOTOR2_ID); //[mA]
+    data.current2 = adcs_drv_get_rw_current(RW_MOTOR2_ID); //[mA]
     osDelay(RW_COMM_DELAY_MS);
-    data.current3 = rwdrv10987_get_current(RW_MOTOR3_ID); //[mA]
+    data.current3 = adcs_drv_get_rw_current(RW_MOTOR3_ID); //[mA]
     osDelay(RW_COMM_DELAY_MS);
 
-    int rc = dat_add_payload_sample(&data, rw_sensors);
+    int rc = evt_add_payload_sample(&data, rw_sensors);
     dat_print_payload_struct(&data, rw_sensors);
     return rc;
 }
@@ -140,7 +140,6 @@ int rw_set_speed(char *fmt, char *params, int nparams)
     LOGI(tag, "Speed command");
     int motor_id;
     int speed;
-    uint8_t dir;
 
     if(params == NULL || sscanf(params, fmt, &motor_id, &speed) != nparams)
         return CMD_SYNTAX_ERROR;
@@ -150,21 +149,14 @@ int rw_set_speed(char *fmt, char *params, int nparams)
         return CMD_SYNTAX_ERROR;
     }
 
-    if(speed < 0) {
-        dir = RW_DIR_ANTICLOCKWISE;
-        speed = -speed;
-    }
-    else
-        dir = RW_DIR_CLOCKWISE;
-
     if(motor_id == -1)
     {
         int rc = 0;
-        rc += (int) rwdrv10987_set_speed(RW_MOTOR1_ID, (int16_t) speed, dir);
+        rc += adcs_drv_set_rw_speed(RW_MOTOR1_ID, speed);
         osDelay(RW_COMM_DELAY_MS);
-        rc += (int) rwdrv10987_set_speed(RW_MOTOR2_ID, (int16_t) speed, dir);
+        rc += adcs_drv_set_rw_speed(RW_MOTOR2_ID, speed);
         osDelay(RW_COMM_DELAY_MS);
-        rc += (int) rwdrv10987_set_speed(RW_MOTOR3_ID, (int16_t) speed, dir);
+        rc += adcs_drv_set_rw_speed(RW_MOTOR3_ID, speed);
         osDelay(RW_COMM_DELAY_MS);
         LOGR(tag, "Setting motor: %d speed: %d (%d)", 1, speed, rc);
         LOGR(tag, "Setting motor: %d speed: %d (%d)", 2, speed, rc);
@@ -173,7 +165,7 @@ int rw_set_speed(char *fmt, char *params, int nparams)
     }
     else if(motor_id == RW_MOTOR1_ID || motor_id == RW_MOTOR2_ID || motor_id == RW_MOTOR3_ID)
     {
-        int rc = (int) rwdrv10987_set_speed((uint8_t) motor_id, (int16_t) speed, dir);
+        int rc = adcs_drv_set_rw_speed(motor_id, speed);
         LOGR(tag, "Setting motor: %d speed: %d (%d)", motor_id, speed, rc);
         return rc != 0 ? CMD_ERROR : CMD_OK;
     }
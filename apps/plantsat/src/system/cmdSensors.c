@@ -35,6 +35,22 @@ void cmd_sensors_init(void)
     cmd_add("sen_get_eps", sensors_get_eps, "", 0);
     cmd_add("sen_get_status", sensors_get_status_basic, "", 0);
     cmd_add("sen_get_adcs_fss", sensors_get_adcs_fss, "", 0);
+    cmd_add("sen_agg_set", sensors_agg_set, "%d %d %d %d", 4);
+    cmd_add("sen_agg_flush", sensors_agg_flush, "", 0);
+    cmd_add("sen_agg_list", sensors_agg_list, "", 0);
+    cmd_add("sen_buff_flush", sensors_buff_flush, "%d", 1);
+    cmd_add("sen_set_retention", sensors_set_retention, "%d %d", 2);
+    cmd_add("sen_evt_set", sensors_evt_set, "%d %d %d %f %d %d", 6);
+    cmd_add("sen_evt_del", sensors_evt_del, "%d %d %d", 3);
+    cmd_add("sen_evt_gate", sensors_evt_gate, "%d %d", 2);
+    cmd_add("sen_evt_list", sensors_evt_list, "", 0);
+    cmd_add("sen_print_retention", sensors_print_retention, "", 0);
+
+    sbuf_init();
+    ret_init();
+    rec_init();
+    agg_init();
+    evt_init();
 }
 
 int sensors_set_state(char *fmt, char *params, int nparams)
@@ -147,7 +163,7 @@ int sensors_get_adcs_basic(char *fmt, char *params, int nparams)
                            gyro_reading.gyro_x, gyro_reading.gyro_y, gyro_reading.gyro_z,
                            hmc_reading.x, hmc_reading.y, hmc_reading.z,
                            sun2, sun3, sun4};
-    int ret = dat_add_payload_sample(&data_ads, ads_sensors);
+    int ret = evt_add_payload_sample(&data_ads, ads_sensors);
     LOGI(tag, "Saving payload %d: ADS (%d). Index: %d, time %d, gyro_x: %.04f, gyro_y: %.04f, gyro_z: %.04f, mag_x: %.04f, mag_y: %.04f, mag_z: %.04f, sun2: %d, sun3, %d, sun4: %d",
          ads_sensors, ret, index_ads, curr_time, gyro_reading.gyro_x, gyro_reading.gyro_y, gyro_reading.gyro_z,
          hmc_reading.x, hmc_reading.y, hmc_reading.z,
@@ -221,7 +237,7 @@ int sensors_get_adcs_fss(char *fmt, char *params, int nparams)
                                sun_fss3[0], sun_fss3[1], sun_fss3[2], sun_fss3[3],
                                sun_fss4[0], sun_fss4[1], sun_fss4[2], sun_fss4[3],
                                sun_fss5[0], sun_fss5[1], sun_fss5[2], sun_fss5[3]};
-    int ret = dat_add_payload_sample(&data_ads_fss, fss_sensors);
+    int ret = evt_add_payload_sample(&data_ads_fss, fss_sensors);
 
     LOGI(tag, "Saving payload %d: ADS FSS (%d). Index: %d, time %d, gyro_x: %.04f, gyro_y: %.04f, gyro_z: %.04f,"
               " FSS_0x20_A: %d, FSS_0x20_B: %d, FSS_0x20_C: %d, FSS_0x20_D: %d,"
@@ -259,7 +275,7 @@ int sensors_get_eps(char *fmt, char *params, int nparams)
 
     int index_eps = dat_get_system_var(data_map[eps_sensors].sys_index);
     eps_data_t data_eps = {index_eps, curr_time, cursun, cursys, vbatt, teps, tbat};
-    rc = dat_add_payload_sample(&data_eps, eps_sensors);
+    rc = evt_add_payload_sample(&data_eps, eps_sensors);
 
     LOGI(tag, "Saving payload %d: EPS (%d). Index: %d, time %d, cursun: %d, cursys: %d, vbatt: %d, teps: %d, tbat: %d ",
          eps_sensors, rc, index_eps, curr_time, cursun, cursys, vbatt, teps, tbat);
@@ -346,7 +362,7 @@ int sensors_get_temperatures(char *fmt, char *params, int nparams)
             //is2_int_temp1, is2_int_temp2, is2_int_temp3, is2_int_temp4, is2_ext_temp1, is2_ext_temp2, is2_ext_temp3, is2_ext_temp4
 
     LOGD(tag, "Save Temperatures");
-    rc = dat_add_payload_sample(&data_temp, temp_sensors);
+    rc = evt_add_payload_sample(&data_temp, temp_sensors);
 
     LOGI(tag, "Saving payload %d: TEMP (%d). Index: %d, time %d, tobc1: %d, teps1: %d, istage1: %d, panel1: %d",
          temp_sensors, rc, index_temp, curr_time, tobc1, hk.temp[0], gtemp1, stemp1);
@@ -357,8 +373,95 @@ int sensors_get_status_basic(char *fmt, char *params, int nparams)
 {
     status_data_t status;
     obc_read_status_basic(&status);
-    int rc = dat_add_payload_sample(&status, status_sensors);
+    int rc = evt_add_payload_sample(&status, status_sensors);
 
     LOGI(tag, "Saving payload %d: STATUS (%d). Index: %d, time %d", status_sensors, rc, status.index, status.timestamp);
     return rc != 0 ? CMD_ERROR : CMD_OK;
 }
+
+int sensors_agg_set(char *fmt, char *params, int nparams)
+{
+    int payload, field, window, keep_raw;
+    if(params == NULL || sscanf(params, fmt, &payload, &field, &window, &keep_raw) != nparams)
+        return CMD_SYNTAX_ERROR;
+
+    int rc = agg_set(payload, field, window, keep_raw);
+    if(rc != 0)
+        LOGE(tag, "Unable to set aggregator for payload %d field %d", payload, field);
+    return rc == 0 ? CMD_OK : CMD_ERROR;
+}
+
+int sensors_agg_flush(char *fmt, char *params, int nparams)
+{
+    int n = agg_flush();
+    LOGI(tag, "Saved %d aggregated samples", n);
+    return CMD_OK;
+}
+
+int sensors_agg_list(char *fmt, char *params, int nparams)
+{
+    agg_print();
+    return CMD_OK;
+}
+
+int sensors_buff_flush(char *fmt, char *params, int nparams)
+{
+    int max_age;
+    if(params == NULL || sscanf(params, fmt, &max_age) != nparams)
+        return CMD_SYNTAX_ERROR;
+
+    // The records block is written to its payload page first
+    int rc = max_age > 0 ? rec_flush_old(max_age) : rec_flush();
+    int pages = max_age > 0 ? sbuf_flush_old(max_age) : sbuf_flush();
+    return rc >= 0 && pages >= 0 ? CMD_OK : CMD_ERROR;
+}
+
+int sensors_set_retention(char *fmt, char *params, int nparams)
+{
+    int payload, policy;
+    if(params == NULL || sscanf(params, fmt, &payload, &policy) != nparams)
+        return CMD_SYNTAX_ERROR;
+
+    return ret_set_policy(payload, policy) == 0 ? CMD_OK : CMD_ERROR;
+}
+
+int sensors_print_retention(char *fmt, char *params, int nparams)
+{
+    ret_print();
+    return CMD_OK;
+}
+
+int sensors_evt_set(char *fmt, char *params, int nparams)
+{
+    int payload, field, type, boost_step, boost_time;
+    float threshold;
+    if(params == NULL ||
+       sscanf(params, fmt, &payload, &field, &type, &threshold, &boost_step, &boost_time) != nparams)
+        return CMD_SYNTAX_ERROR;
+
+    return evt_set(payload, field, type, threshold, boost_step, boost_time) == 0 ? CMD_OK : CMD_ERROR;
+}
+
+int sensors_evt_del(char *fmt, char *params, int nparams)
+{
+    int payload, field, type;
+    if(params == NULL || sscanf(params, fmt, &payload, &field, &type) != nparams)
+        return CMD_SYNTAX_ERROR;
+
+    return evt_del(payload, field, type) == 0 ? CMD_OK : CMD_ERROR;
+}
+
+int sensors_evt_gate(char *fmt, char *params, int nparams)
+{
+    int payload, gate;
+    if(params == NULL || sscanf(params, fmt, &payload, &gate) != nparams)
+        return CMD_SYNTAX_ERROR;
+
+    return evt_set_gate(payload, gate) == 0 ? CMD_OK : CMD_SYNTAX_ERROR;
+}
+
+int sensors_evt_list(char *fmt, char *params, int nparams)
+{
+    evt_print();
+    return CMD_OK;
+}
@@ -0,0 +1,291 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/dataAggregator.h"
+
+static const char *tag = "dataAgg";
+
+static agg_state_t agg_table[AGG_MAX_AGGREGATORS];
+static osSemaphore agg_sem;
+
+/**
+ * Default aggregators: EKF gyro every minute and OBC temperature every
+ * 10 minutes, keeping raw samples.
+ */
+static const int agg_defaults[][4] = {
+        {ekf_sensors, 2, 60, 1},    // gyro_x
+        {ekf_sensors, 3, 60, 1},    // gyro_y
+        {ekf_sensors, 4, 60, 1},    // gyro_z
+        {temp_sensors, 2, 600, 1},  // obc_temp_1
+};
+
+/**
+ * Find the offset and type of a field in a payload struct
+ * @return Field offset in bytes, or -1 if not found or not numeric
+ */
+static int agg_get_field_offset(int payload, int field, char *type)
+{
+    int offset = 0;
+    int i = 0;
+    char *p = data_map[payload].data_order;
+    while((p = strchr(p, '%')) != NULL)
+    {
+        p++;
+        int width = (*p == 'h') ? 2 : 4;
+        if(i == field)
+        {
+            if(*p != 'u' && *p != 'd' && *p != 'i' && *p != 'f' && *p != 'h')
+                return -1;
+            if(offset + width > data_map[payload].size)
+                return -1;
+            *type = *p;
+            return offset;
+        }
+        if(*p == 's')
+            return -1;
+        offset += width;
+        i++;
+    }
+    return -1;
+}
+
+static float agg_get_field_value(uint8_t *data, int offset, char type)
+{
+    uint32_t u;
+    int16_t h;
+    float f;
+    switch(type)
+    {
+        case 'h':
+            memcpy(&h, data + offset, sizeof(h));
+            return (float)h;
+        case 'f':
+            memcpy(&f, data + offset, sizeof(f));
+            return f;
+        case 'u':
+            memcpy(&u, data + offset, sizeof(u));
+            return (float)u;
+        default:
+            memcpy(&u, data + offset, sizeof(u));
+            return (float)(int32_t)u;
+    }
+}
+
+/**
+ * Build a summary from an aggregator and start a new window.
+ * Requires agg_sem to be taken.
+ */
+static void agg_close_window(agg_state_t *agg, uint32_t now, agg_data_t *out)
+{
+    out->timestamp = now;
+    out->payload = (uint32_t)agg->payload;
+    out->field = agg->field;
+    out->window = agg->window;
+    out->count = agg->count;
+    out->min = agg->min;
+    out->max = agg->max;
+    out->mean = (float)agg->mean;
+    out->stddev = agg->count > 1 ? (float)sqrt(agg->m2 / (double)(agg->count - 1)) : 0.0f;
+
+    agg->start = now;
+    agg->count = 0;
+    agg->mean = 0;
+    agg->m2 = 0;
+}
+
+static int agg_save(agg_data_t *summaries, int n)
+{
+    int i, saved = 0;
+    for(i = 0; i < n; i++)
+    {
+        if(ret_add_payload_sample(&summaries[i], agg_sensors) == 0)
+            saved++;
+        LOGD(tag, "Payload %d field %d: n=%d, min=%.4f, max=%.4f, mean=%.4f, std=%.4f", summaries[i].payload,
+             summaries[i].field, summaries[i].count, summaries[i].min, summaries[i].max, summaries[i].mean,
+             summaries[i].stddev);
+    }
+    return saved;
+}
+
+int agg_init(void)
+{
+    int i;
+    for(i = 0; i < AGG_MAX_AGGREGATORS; i++)
+        agg_table[i].payload = -1;
+
+    if(osSemaphoreCreate(&agg_sem) != OS_SEMAPHORE_OK)
+    {
+        LOGE(tag, "Unable to create aggregators mutex");
+        return -1;
+    }
+
+    for(i = 0; i < (int)(sizeof(agg_defaults)/sizeof(agg_defaults[0])); i++)
+        agg_set(agg_defaults[i][0], agg_defaults[i][1], agg_defaults[i][2], agg_defaults[i][3]);
+    return 0;
+}
+
+int agg_set(int payload, int field, int window, int keep_raw)
+{
+    char type;
+    if(payload < 0 || payload >= last_sensor || payload == agg_sensors || window < 0 || window > UINT16_MAX ||
+       agg_get_field_offset(payload, field, &type) < 0)
+        return -1;
+
+    int i, rc = -1;
+    int nsummaries = 0;
+    agg_data_t summary;
+    agg_state_t *free_slot = NULL;
+    osSemaphoreTake(&agg_sem, portMAX_DELAY);
+    for(i = 0; i < AGG_MAX_AGGREGATORS; i++)
+    {
+        agg_state_t *agg = &agg_table[i];
+        if(agg->payload == payload && agg->field == field)
+        {
+            if(window == 0)
+            {
+                // Keep the open window summary before removing the aggregator
+                if(agg->count > 0)
+                {
+                    agg_close_window(agg, (uint32_t)dat_get_time(), &summary);
+                    nsummaries++;
+                }
+                agg->payload = -1;
+            }
+            else
+            {
+                agg->window = (uint16_t)window;
+                agg->keep_raw = (uint8_t)(keep_raw != 0);
+            }
+            rc = 0;
+            break;
+        }
+        if(agg->payload < 0 && free_slot == NULL)
+            free_slot = agg;
+    }
+
+    if(rc != 0 && window > 0 && free_slot != NULL)
+    {
+        memset(free_slot, 0, sizeof(agg_state_t));
+        free_slot->payload = (int16_t)payload;
+        free_slot->field = (uint8_t)field;
+        free_slot->window = (uint16_t)window;
+        free_slot->keep_raw = (uint8_t)(keep_raw != 0);
+        rc = 0;
+    }
+    osSemaphoreGiven(&agg_sem);
+
+    agg_save(&summary, nsummaries);
+    return rc;
+}
+
+int agg_get_field(void *data, int payload, int field, float *value)
+{
+    char type;
+    if(payload < 0 || payload >= last_sensor)
+        return -1;
+    int offset = agg_get_field_offset(payload, field, &type);
+    if(offset < 0)
+        return -1;
+    if(data != NULL && value != NULL)
+        *value = agg_get_field_value((uint8_t *)data, offset, type);
+    return 0;
+}
+
+int agg_feed_payload_sample(void *data, int payload)
+{
+    agg_data_t summaries[AGG_MAX_AGGREGATORS];
+    int nsummaries = 0;
+    int naggs = 0;
+    int keep_raw = 0;
+    uint32_t now = (uint32_t)dat_get_time();
+
+    osSemaphoreTake(&agg_sem, portMAX_DELAY);
+    int i;
+    for(i = 0; i < AGG_MAX_AGGREGATORS; i++)
+    {
+        agg_state_t *agg = &agg_table[i];
+        if(agg->payload != payload)
+            continue;
+
+        naggs++;
+        keep_raw |= agg->keep_raw;
+        char type;
+        int offset = agg_get_field_offset(payload, agg->field, &type);
+        if(offset < 0)
+            continue;
+
+        if(agg->count > 0 && now - agg->start >= agg->window)
+            agg_close_window(agg, now, &summaries[nsummaries++]);
+        if(agg->count == 0)
+            agg->start = now;
+
+        // Welford's online mean and variance
+        float value = agg_get_field_value((uint8_t *)data, offset, type);
+        agg->count++;
+        double delta = value - agg->mean;
+        agg->mean += delta / agg->count;
+        agg->m2 += delta * (value - agg->mean);
+        if(agg->count == 1 || value < agg->min) agg->min = value;
+        if(agg->count == 1 || value > agg->max) agg->max = value;
+    }
+    osSemaphoreGiven(&agg_sem);
+
+    agg_save(summaries, nsummaries);
+    return naggs == 0 || keep_raw;
+}
+
+int agg_add_payload_sample(void *data, int payload)
+{
+    if(!agg_feed_payload_sample(data, payload))
+        return 0;
+    return ret_add_payload_sample(data, payload);
+}
+
+int agg_flush(void)
+{
+    agg_data_t summaries[AGG_MAX_AGGREGATORS];
+    int nsummaries = 0;
+    uint32_t now = (uint32_t)dat_get_time();
+
+    osSemaphoreTake(&agg_sem, portMAX_DELAY);
+    int i;
+    for(i = 0; i < AGG_MAX_AGGREGATORS; i++)
+    {
+        if(agg_table[i].payload >= 0 && agg_table[i].count > 0)
+            agg_close_window(&agg_table[i], now, &summaries[nsummaries++]);
+    }
+    osSemaphoreGiven(&agg_sem);
+
+    return agg_save(summaries, nsummaries);
+}
+
+void agg_print(void)
+{
+    int i;
+    osSemaphoreTake(&agg_sem, portMAX_DELAY);
+    for(i = 0; i < AGG_MAX_AGGREGATORS; i++)
+    {
+        agg_state_t *agg = &agg_table[i];
+        if(agg->payload < 0)
+            continue;
+        LOGR(tag, "%d: payload %d (%s), field %d, window %d s, keep raw %d, samples %d",
+             i, agg->payload, data_map[agg->payload].table, agg->field, agg->window, agg->keep_raw, agg->count);
+    }
+    osSemaphoreGiven(&agg_sem);
+}
@@ -0,0 +1,252 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/downlinkSched.h"
+#include "app/system/cmdCDH.h"
+
+static const char *tag = "dlSched";
+
+#define DL_FRAME_LEN (sizeof(((com_frame_t *)0)->data))
+
+static dl_class_t dl_classes[DL_SCHED_NCLASSES];
+static int8_t dl_pay_class[last_sensor];
+static uint32_t dl_cursor[last_sensor];     ///< Next sample to send in the current pass
+static uint32_t dl_pay_sent[last_sensor];   ///< Samples sent in the last pass
+
+void dl_sched_init(void)
+{
+    // Priority, budget per pass [bytes]
+    dl_sched_set_class(DL_SCHED_CLASS_CRITICAL, 30, 0);
+    dl_sched_set_class(DL_SCHED_CLASS_SUMMARY, 20, 4096);
+    dl_sched_set_class(DL_SCHED_CLASS_ADCS, 10, 8192);
+    dl_sched_set_class(DL_SCHED_CLASS_BULK, 0, 2048);
+
+    int i;
+    for(i = 0; i < last_sensor; i++)
+        dl_pay_class[i] = DL_SCHED_CLASS_BULK;
+    dl_pay_class[status_sensors] = DL_SCHED_CLASS_CRITICAL;
+    dl_pay_class[evt_sensors] = DL_SCHED_CLASS_CRITICAL;
+    dl_pay_class[eps_sensors] = DL_SCHED_CLASS_CRITICAL;
+    dl_pay_class[temp_sensors] = DL_SCHED_CLASS_CRITICAL;
+    dl_pay_class[agg_sensors] = DL_SCHED_CLASS_SUMMARY;
+    dl_pay_class[tim_sensors] = DL_SCHED_CLASS_SUMMARY;
+    dl_pay_class[ads_sensors] = DL_SCHED_CLASS_SUMMARY;
+    dl_pay_class[rw_sensors] = DL_SCHED_CLASS_SUMMARY;
+    dl_pay_class[ekf_sensors] = DL_SCHED_CLASS_ADCS;
+    dl_pay_class[fss_sensors] = DL_SCHED_CLASS_ADCS;
+    dl_pay_class[ctrl_data] = DL_SCHED_CLASS_ADCS;
+    dl_pay_class[stt_sensors] = DL_SCHED_CLASS_ADCS;
+    // Records are sent as packed messages, see tm_send_msgs
+    dl_pay_class[rec_blocks] = -1;
+}
+
+int dl_sched_set_class(int class, int priority, int budget)
+{
+    if(class < 0 || class >= DL_SCHED_NCLASSES || priority < 0 || budget < 0)
+        return -1;
+    dl_classes[class].priority = (uint16_t)priority;
+    dl_classes[class].budget = (uint16_t)(budget > UINT16_MAX ? UINT16_MAX : budget);
+    return 0;
+}
+
+int dl_sched_set_payload(int payload, int class)
+{
+    if(payload < 0 || payload >= last_sensor || class < -1 || class >= DL_SCHED_NCLASSES)
+        return -1;
+    dl_pay_class[payload] = (int8_t)class;
+    return 0;
+}
+
+static inline int dl_pending(int payload)
+{
+    uint32_t last = dat_get_system_var(data_map[payload].sys_index);
+    return last > dl_cursor[payload] ? (int)(last - dl_cursor[payload]) : 0;
+}
+
+static inline int dl_class_has_budget(dl_class_t *cls)
+{
+    return cls->budget == 0 || cls->sent < cls->budget;
+}
+
+/**
+ * Find the next payload with pending samples in a class, round robin
+ * @return Payload id, or -1 if the class has no pending data
+ */
+static int dl_class_next_payload(int class)
+{
+    int i;
+    for(i = 1; i <= last_sensor; i++)
+    {
+        int payload = (dl_classes[class].last_payload + i) % last_sensor;
+        if(dl_pay_class[payload] == class && dl_pending(payload) > 0)
+            return payload;
+    }
+    return -1;
+}
+
+/**
+ * Send one frame of a payload, starting at the pass cursor
+ * @return Number of bytes sent, 0 if nothing was sent, -1 in case of errors
+ */
+static int dl_send_frame(int node, int port, int payload, int nframe)
+{
+    data_map_t *map = &data_map[payload];
+    uint8_t widths[TM_DELTA_MAX_FIELDS];
+    uint8_t frame[DL_FRAME_LEN];
+    int nfields = tm_delta_get_layout(map, widths, TM_DELTA_MAX_FIELDS);
+    int rc;
+
+    // Skip the samples not retained by the payload policy
+    dl_cursor[payload] = ret_get_next(payload, dl_cursor[payload]);
+    int pending = dl_pending(payload);
+    if(pending == 0)
+        return 0;
+
+    if(nfields < 0)
+    {
+        // Not delta encodable, send one raw struct
+        if(map->size > DL_FRAME_LEN || ret_get_payload_sample(frame, payload, dl_cursor[payload]) < 0)
+            return -1;
+        _hton32_buff((uint32_t *)frame, map->size / sizeof(uint32_t));
+        rc = com_send_telemetry(node, port, TM_TYPE_PAYLOAD + payload, frame, map->size, 1, nframe);
+        dl_cursor[payload]++;
+        dl_pay_sent[payload]++;
+        return rc == CMD_OK ? map->size : -1;
+    }
+
+    // Each sample uses at least one byte per field
+    int nload = (int)(DL_FRAME_LEN - TM_DELTA_HEADER_LEN) / nfields;
+    nload = nload < pending ? nload : pending;
+    nload = nload < TM_DELTA_MAX_SAMPLES ? nload : TM_DELTA_MAX_SAMPLES;
+    uint8_t *samples = (uint8_t *)malloc(nload * map->size);
+    if(samples == NULL)
+        return -1;
+
+    int i;
+    int next = dl_cursor[payload];
+    for(i = 0; i < nload; i++)
+    {
+        next = ret_get_next(payload, next);
+        if(next >= (int)(dl_cursor[payload] + pending) ||
+           ret_get_payload_sample(samples + i * map->size, payload, next) < 0)
+            break;
+        next++;
+    }
+
+    int used = 0;
+    uint32_t last_sent = 0;
+    int len = i > 0 ? tm_delta_encode(map, payload, samples, i, frame, sizeof(frame), &used) : -1;
+    if(len >= 0 && used > 0)
+        memcpy(&last_sent, samples + (used - 1) * map->size, sizeof(last_sent));  // Sample index field
+    free(samples);
+    if(len < 0 || used == 0)
+        return -1;
+
+    rc = com_send_telemetry(node, port, TM_TYPE_PAYLOAD_DELTA, frame, len, 1, nframe);
+    dl_cursor[payload] = last_sent + 1;
+    dl_pay_sent[payload] += used;
+    return rc == CMD_OK ? len : -1;
+}
+
+int dl_sched_pass(int node, int port, int max_bytes)
+{
+    int c, p;
+    for(c = 0; c < DL_SCHED_NCLASSES; c++)
+    {
+        dl_classes[c].sent = 0;
+        dl_classes[c].age = 0;
+    }
+    for(p = 0; p < last_sensor; p++)
+    {
+        // Samples older than the first retained one were overwritten
+        int first = ret_get_first(p);
+        int ack = dat_get_system_var(data_map[p].sys_ack);
+        dl_cursor[p] = ack > first ? ack : first;
+        dl_pay_sent[p] = 0;
+    }
+
+    int total = 0;
+    int nframe = 0;
+    while(max_bytes == 0 || total < max_bytes)
+    {
+        // Select the class with the highest aged priority, pending data and budget
+        int best = -1;
+        int best_payload = -1;
+        uint32_t best_prio = 0;
+        int ready[DL_SCHED_NCLASSES];
+        for(c = 0; c < DL_SCHED_NCLASSES; c++)
+        {
+            ready[c] = 0;
+            if(!dl_class_has_budget(&dl_classes[c]))
+                continue;
+            int payload = dl_class_next_payload(c);
+            if(payload < 0)
+                continue;
+            ready[c] = 1;
+            uint32_t prio = dl_classes[c].priority + dl_classes[c].age;
+            if(best < 0 || prio > best_prio)
+            {
+                best = c;
+                best_payload = payload;
+                best_prio = prio;
+            }
+        }
+        if(best < 0)
+            break;
+
+        int len = dl_send_frame(node, port, best_payload, nframe++);
+        if(len < 0)
+        {
+            LOGE(tag, "Error sending payload %d sample %d", best_payload, dl_cursor[best_payload]);
+            // Do not retry this payload in the current pass
+            dl_cursor[best_payload] = dat_get_system_var(data_map[best_payload].sys_index);
+            continue;
+        }
+
+        total += len;
+        dl_classes[best].sent += len;
+        dl_classes[best].last_payload = best_payload;
+        for(c = 0; c < DL_SCHED_NCLASSES; c++)
+        {
+            if(c == best)
+                dl_classes[c].age = 0;
+            else if(ready[c])
+                dl_classes[c].age++;
+        }
+    }
+
+    LOGI(tag, "Pass sent %d bytes in %d frames", total, nframe);
+    return total;
+}
+
+void dl_sched_print(void)
+{
+    int c, p;
+    for(c = 0; c < DL_SCHED_NCLASSES; c++)
+    {
+        LOGR(tag, "Class %d: priority %d, budget %d, sent %d bytes", c, dl_classes[c].priority,
+             dl_classes[c].budget, dl_classes[c].sent);
+        for(p = 0; p < last_sensor; p++)
+        {
+            if(dl_pay_class[p] == c)
+                LOGR(tag, "\t%s (%d): sent %d samples, %d pending", data_map[p].table, p, dl_pay_sent[p],
+                     dl_pending(p));
+        }
+    }
+}
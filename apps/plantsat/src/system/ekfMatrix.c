@@ -0,0 +1,251 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/ekfMatrix.h"
+
+/*
+ * Unrolled sums of E(k), where E is a macro of the inner index k. The terms
+ * are added in the same order as a k loop.
+ */
+#define EKF_SUM3(E) (E(0) + E(1) + E(2))
+#define EKF_SUM7(E) (EKF_SUM3(E) + E(3) + E(4) + E(5) + E(6))
+#define EKF_SUM9(E) (EKF_SUM7(E) + E(7) + E(8))
+#define EKF_SUM10(E) (EKF_SUM9(E) + E(9))
+
+void ekf_mat3_mult(const matrix3_t *a, const matrix3_t *b, matrix3_t *res)
+{
+#define AB(k) (a->m[i][k] * b->m[k][j])
+    int i, j;
+    for(i = 0; i < 3; i++)
+        for(j = 0; j < 3; j++)
+            res->m[i][j] = EKF_SUM3(AB);
+#undef AB
+}
+
+void ekf_mat10_abat(const matrix10_t *a, const matrix10_t *b, matrix10_t *res)
+{
+    double t[10][10];
+    int i, j;
+#define AB(k) (a->m[i][k] * b->m[k][j])
+    for(i = 0; i < 10; i++)
+        for(j = 0; j < 10; j++)
+            t[i][j] = EKF_SUM10(AB);
+#undef AB
+#define TAT(k) (t[i][k] * a->m[j][k])
+    for(i = 0; i < 10; i++)
+        for(j = i; j < 10; j++)
+            res->m[i][j] = res->m[j][i] = EKF_SUM10(TAT);
+#undef TAT
+}
+
+void ekf_mat10_7_abat(const matrix10_7_t *a, const matrix7_t *b, matrix10_t *res)
+{
+    double t[10][7];
+    int i, j;
+#define AB(k) (a->m[i][k] * b->m[k][j])
+    for(i = 0; i < 10; i++)
+        for(j = 0; j < 7; j++)
+            t[i][j] = EKF_SUM7(AB);
+#undef AB
+#define TAT(k) (t[i][k] * a->m[j][k])
+    for(i = 0; i < 10; i++)
+        for(j = i; j < 10; j++)
+            res->m[i][j] = res->m[j][i] = EKF_SUM7(TAT);
+#undef TAT
+}
+
+void ekf_mat7_10_abat(const matrix7_10_t *a, const matrix10_t *b, matrix7_t *res)
+{
+    double t[7][10];
+    int i, j;
+#define AB(k) (a->m[i][k] * b->m[k][j])
+    for(i = 0; i < 7; i++)
+        for(j = 0; j < 10; j++)
+            t[i][j] = EKF_SUM10(AB);
+#undef AB
+#define TAT(k) (t[i][k] * a->m[j][k])
+    for(i = 0; i < 7; i++)
+        for(j = i; j < 7; j++)
+            res->m[i][j] = res->m[j][i] = EKF_SUM10(TAT);
+#undef TAT
+}
+
+void ekf_mat10_mult_7_10_t(const matrix10_t *a, const matrix7_10_t *b, matrix10_7_t *res)
+{
+#define ABT(k) (a->m[i][k] * b->m[j][k])
+    int i, j;
+    for(i = 0; i < 10; i++)
+        for(j = 0; j < 7; j++)
+            res->m[i][j] = EKF_SUM10(ABT);
+#undef ABT
+}
+
+void ekf_mat10_7_mult_7_10(const matrix10_7_t *a, const matrix7_10_t *b, matrix10_t *res)
+{
+#define AB(k) (a->m[i][k] * b->m[k][j])
+    int i, j;
+    for(i = 0; i < 10; i++)
+        for(j = 0; j < 10; j++)
+            res->m[i][j] = EKF_SUM7(AB);
+#undef AB
+}
+
+void ekf_mat10_7_vec_mult(const matrix10_7_t *a, const double *v, double *res)
+{
+#define AV(k) (a->m[i][k] * v[k])
+    int i;
+    for(i = 0; i < 10; i++)
+        res[i] = EKF_SUM7(AV);
+#undef AV
+}
+
+/*
+ * Column range [lo, hi) of the non zero elements of each row of the EKF
+ * jacobians, see ekf_mat10_propagate.
+ */
+static const int ekf_f_lo[10] = {0, 0, 0, 0, 0, 0, 0, 7, 8, 9};
+static const int ekf_f_hi[10] = {3, 3, 3, 7, 7, 7, 7, 8, 9, 10};
+static const int ekf_l_lo[10] = {0, 1, 2, 3, 3, 3, 3, 6, 7, 8};
+static const int ekf_l_hi[10] = {1, 2, 3, 6, 6, 6, 6, 7, 8, 9};
+
+void ekf_mat10_propagate(const matrix10_t *f, const matrix10_9_t *l, const matrix10_t *p,
+                         const matrix9_t *q, matrix10_t *res)
+{
+    double fp[10][10];
+    double lq[10][9];
+    int i, j, k;
+
+    // f·p and l·q, only the non zero columns of each row
+    for(i = 0; i < 10; i++)
+    {
+        for(j = 0; j < 10; j++)
+        {
+            double sum = 0;
+            for(k = ekf_f_lo[i]; k < ekf_f_hi[i]; k++)
+                sum += f->m[i][k] * p->m[k][j];
+            fp[i][j] = sum;
+        }
+        for(j = 0; j < 9; j++)
+        {
+            double sum = 0;
+            for(k = ekf_l_lo[i]; k < ekf_l_hi[i]; k++)
+                sum += l->m[i][k] * q->m[k][j];
+            lq[i][j] = sum;
+        }
+    }
+
+    // Upper triangle of (f·p)·fᵀ + (l·q)·lᵀ, then mirror
+    for(i = 0; i < 10; i++)
+    {
+        for(j = i; j < 10; j++)
+        {
+            double sum = 0;
+            for(k = ekf_f_lo[j]; k < ekf_f_hi[j]; k++)
+                sum += fp[i][k] * f->m[j][k];
+            for(k = ekf_l_lo[j]; k < ekf_l_hi[j]; k++)
+                sum += lq[i][k] * l->m[j][k];
+            res->m[i][j] = res->m[j][i] = sum;
+        }
+    }
+}
+
+int ekf_mat10_scalar_update(matrix10_t *p, double *x, const double *h, double r, double z)
+{
+    double ph[10];
+    int i, j;
+#define PH(k) (p->m[i][k] * h[k])
+    for(i = 0; i < 10; i++)
+        ph[i] = EKF_SUM10(PH);
+#undef PH
+#define HPH(k) (h[k] * ph[k])
+#define HX(k) (h[k] * x[k])
+    double s = EKF_SUM10(HPH) + r;
+    if(!(s > 0))
+        return EKF_LDLT_NOT_PD;
+    // Innovation divided by its variance, so k·(z - h·x) = ph·e
+    double e = (z - EKF_SUM10(HX)) / s;
+#undef HPH
+#undef HX
+
+    for(i = 0; i < 10; i++)
+    {
+        x[i] += ph[i] * e;
+        for(j = i; j < 10; j++)
+            p->m[i][j] = p->m[j][i] = p->m[i][j] - ph[i] * ph[j] / s;
+    }
+    return EKF_LDLT_OK;
+}
+
+int ekf_mat7_ldlt(const matrix7_t *s, matrix7_t *l, double *d)
+{
+    int i, j, k;
+    double d_min = 0, d_max = 0;
+    for(j = 0; j < 7; j++)
+    {
+        // d_j = s_jj - sum(l_jk^2 * d_k)
+        double dj = s->m[j][j];
+        for(k = 0; k < j; k++)
+            dj -= l->m[j][k] * l->m[j][k] * d[k];
+        if(!(dj > 0))
+            return EKF_LDLT_NOT_PD;
+        d[j] = dj;
+        d_min = j == 0 || dj < d_min ? dj : d_min;
+        d_max = dj > d_max ? dj : d_max;
+
+        l->m[j][j] = 1.0;
+        for(i = 0; i < j; i++)
+            l->m[i][j] = 0.0;
+        // l_ij = (s_ij - sum(l_ik * l_jk * d_k)) / d_j
+        for(i = j + 1; i < 7; i++)
+        {
+            double lij = s->m[i][j];
+            for(k = 0; k < j; k++)
+                lij -= l->m[i][k] * l->m[j][k] * d[k];
+            l->m[i][j] = lij / dj;
+        }
+    }
+    return d_min < EKF_LDLT_MIN_RATIO * d_max ? EKF_LDLT_NEAR_SINGULAR : EKF_LDLT_OK;
+}
+
+void ekf_mat7_ldlt_solve_10(const matrix7_t *l, const double *d, const matrix10_7_t *b, matrix10_7_t *res)
+{
+    int r, i, k;
+    // s is symmetric, so each row x of res solves s·xᵀ = bᵀ
+    for(r = 0; r < 10; r++)
+    {
+        double x[7];
+        // Forward substitution, l·y = b
+        for(i = 0; i < 7; i++)
+        {
+            x[i] = b->m[r][i];
+            for(k = 0; k < i; k++)
+                x[i] -= l->m[i][k] * x[k];
+        }
+        // Diagonal, D·z = y
+        for(i = 0; i < 7; i++)
+            x[i] /= d[i];
+        // Backward substitution, lᵀ·x = z
+        for(i = 6; i >= 0; i--)
+        {
+            for(k = i + 1; k < 7; k++)
+                x[i] -= l->m[k][i] * x[k];
+            res->m[r][i] = x[i];
+        }
+    }
+}
@@ -0,0 +1,266 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/eventRules.h"
+
+static const char *tag = "evtRules";
+
+static evt_rule_t evt_table[EVT_MAX_RULES];
+static uint8_t evt_gate[last_sensor];
+static uint32_t evt_boost_until = 0;    ///< Boost end time
+static uint16_t evt_boost_step = 0;     ///< Fastest step of the active boosts
+static osSemaphore evt_sem;
+
+static const char *evt_type_names[EVT_RULE_LAST] = {"above", "below", "rate", "deadband"};
+
+/**
+ * Default rules: fast system current changes sample every second for two
+ * minutes. Low battery voltage is only recorded as an event, sampling faster
+ * would drain the battery further.
+ */
+static const struct {
+    int payload;
+    int field;
+    int type;
+    float threshold;
+    int boost_step;
+    int boost_time;
+} evt_defaults[] = {
+        {eps_sensors, 4, EVT_RULE_BELOW, 7000.0f, 0, 0},      // vbatt [mV]
+        {eps_sensors, 3, EVT_RULE_RATE,  500.0f,  1, 120},    // cursys [mA/s]
+};
+
+/**
+ * Evaluate a rule with a new value. Requires evt_sem to be taken.
+ * @return 1 if an event was generated, 0 otherwise
+ */
+static int evt_eval(evt_rule_t *rule, float value, uint32_t now, evt_data_t *out)
+{
+    int fired = 0;
+    out->type = rule->type;
+    out->value = value;
+    out->ref = rule->threshold;
+
+    switch(rule->type)
+    {
+        case EVT_RULE_ABOVE:
+        case EVT_RULE_BELOW:
+        {
+            int cond = rule->type == EVT_RULE_ABOVE ? value > rule->threshold : value < rule->threshold;
+            // The first sample only fires if the condition holds
+            if(cond != rule->active)
+            {
+                fired = 1;
+                if(!cond)
+                    out->type |= EVT_FLAG_CLEAR;
+            }
+            rule->active = (uint8_t)cond;
+            break;
+        }
+        case EVT_RULE_RATE:
+            if(rule->init && now > rule->last_time)
+            {
+                float rate = (value - rule->last) / (float)(now - rule->last_time);
+                fired = fabsf(rate) > rule->threshold;
+                out->ref = rule->last;
+            }
+            rule->last = value;
+            break;
+        case EVT_RULE_DEADBAND:
+            if(!rule->init || fabsf(value - rule->last) > rule->threshold)
+            {
+                fired = rule->init;
+                out->ref = rule->last;
+                rule->last = value;
+            }
+            break;
+        default:
+            break;
+    }
+
+    rule->init = 1;
+    rule->last_time = now;
+    if(fired)
+    {
+        rule->count++;
+        // A clear event does not boost
+        if(rule->boost_step > 0 && !(out->type & EVT_FLAG_CLEAR))
+        {
+            if(now >= evt_boost_until || rule->boost_step < evt_boost_step)
+                evt_boost_step = rule->boost_step;
+            if(now + rule->boost_time > evt_boost_until)
+                evt_boost_until = now + rule->boost_time;
+        }
+    }
+    return fired;
+}
+
+int evt_init(void)
+{
+    int i;
+    for(i = 0; i < EVT_MAX_RULES; i++)
+        evt_table[i].payload = -1;
+    memset(evt_gate, 0, sizeof(evt_gate));
+
+    if(osSemaphoreCreate(&evt_sem) != OS_SEMAPHORE_OK)
+    {
+        LOGE(tag, "Unable to create event rules mutex");
+        return -1;
+    }
+
+    for(i = 0; i < (int)(sizeof(evt_defaults)/sizeof(evt_defaults[0])); i++)
+        evt_set(evt_defaults[i].payload, evt_defaults[i].field, evt_defaults[i].type, evt_defaults[i].threshold,
+                evt_defaults[i].boost_step, evt_defaults[i].boost_time);
+    return 0;
+}
+
+int evt_set(int payload, int field, int type, float threshold, int boost_step, int boost_time)
+{
+    if(payload < 0 || payload >= last_sensor || payload == evt_sensors || type < 0 || type >= EVT_RULE_LAST ||
+       boost_step < 0 || boost_time < 0 || agg_get_field(NULL, payload, field, NULL) < 0)
+        return -1;
+
+    int i, rc = -1;
+    evt_rule_t *rule = NULL;
+    osSemaphoreTake(&evt_sem, portMAX_DELAY);
+    for(i = 0; i < EVT_MAX_RULES; i++)
+    {
+        evt_rule_t *r = &evt_table[i];
+        if(r->payload == payload && r->field == field && r->type == type)
+        {
+            rule = r;
+            break;
+        }
+        if(r->payload < 0 && rule == NULL)
+            rule = r;
+    }
+
+    if(rule != NULL)
+    {
+        memset(rule, 0, sizeof(evt_rule_t));
+        rule->payload = (int16_t)payload;
+        rule->field = (uint8_t)field;
+        rule->type = (uint8_t)type;
+        rule->threshold = threshold;
+        rule->boost_step = (uint16_t)boost_step;
+        rule->boost_time = (uint16_t)boost_time;
+        rc = 0;
+    }
+    osSemaphoreGiven(&evt_sem);
+    return rc;
+}
+
+int evt_del(int payload, int field, int type)
+{
+    int i, rc = -1;
+    osSemaphoreTake(&evt_sem, portMAX_DELAY);
+    for(i = 0; i < EVT_MAX_RULES; i++)
+    {
+        evt_rule_t *r = &evt_table[i];
+        if(r->payload >= 0 && r->payload == payload && r->field == field && r->type == type)
+        {
+            r->payload = -1;
+            rc = 0;
+        }
+    }
+    osSemaphoreGiven(&evt_sem);
+    return rc;
+}
+
+int evt_set_gate(int payload, int gate)
+{
+    if(payload < 0 || payload >= last_sensor)
+        return -1;
+    evt_gate[payload] = (uint8_t)(gate != 0);
+    return 0;
+}
+
+int evt_add_payload_sample(void *data, int payload)
+{
+    if(payload < 0 || payload >= last_sensor)
+        return -1;
+
+    evt_data_t events[EVT_MAX_RULES];
+    int nevents = 0;
+    uint32_t now = (uint32_t)dat_get_time();
+
+    osSemaphoreTake(&evt_sem, portMAX_DELAY);
+    int i;
+    for(i = 0; i < EVT_MAX_RULES; i++)
+    {
+        evt_rule_t *rule = &evt_table[i];
+        float value;
+        if(rule->payload != payload || agg_get_field(data, payload, rule->field, &value) < 0)
+            continue;
+
+        evt_data_t *event = &events[nevents];
+        if(evt_eval(rule, value, now, event))
+        {
+            event->timestamp = now;
+            event->payload = (uint32_t)payload;
+            event->field = rule->field;
+            nevents++;
+        }
+    }
+    int boosted = now < evt_boost_until;
+    int store = !evt_gate[payload] || nevents > 0 || boosted;
+    osSemaphoreGiven(&evt_sem);
+
+    for(i = 0; i < nevents; i++)
+    {
+        LOGI(tag, "Payload %d field %d %s%s: value %.4f, ref %.4f", payload, events[i].field,
+             evt_type_names[events[i].type & ~EVT_FLAG_CLEAR], events[i].type & EVT_FLAG_CLEAR ? " (clear)" : "",
+             events[i].value, events[i].ref);
+        ret_add_payload_sample(&events[i], evt_sensors);
+    }
+
+    // Aggregators always see the sample, the raw sample may be gated
+    if(!agg_feed_payload_sample(data, payload) || !store)
+        return 0;
+    return ret_add_payload_sample(data, payload);
+}
+
+int evt_get_step(int step)
+{
+    uint32_t now = (uint32_t)dat_get_time();
+    osSemaphoreTake(&evt_sem, portMAX_DELAY);
+    if(now < evt_boost_until && evt_boost_step > 0 && evt_boost_step < step)
+        step = evt_boost_step;
+    osSemaphoreGiven(&evt_sem);
+    return step;
+}
+
+void evt_print(void)
+{
+    int i;
+    uint32_t now = (uint32_t)dat_get_time();
+    osSemaphoreTake(&evt_sem, portMAX_DELAY);
+    for(i = 0; i < EVT_MAX_RULES; i++)
+    {
+        evt_rule_t *r = &evt_table[i];
+        if(r->payload < 0)
+            continue;
+        LOGR(tag, "%d: payload %d (%s), field %d, %s %.4f, boost %d s for %d s, gated %d, events %u",
+             i, r->payload, data_map[r->payload].table, r->field, evt_type_names[r->type], r->threshold,
+             r->boost_step, r->boost_time, evt_gate[r->payload], (unsigned int)r->count);
+    }
+    if(now < evt_boost_until)
+        LOGR(tag, "Boost active: step %d s, %u s left", evt_boost_step, (unsigned int)(evt_boost_until - now));
+    osSemaphoreGiven(&evt_sem);
+}
@@ -58,7 +58,7 @@ void com_receive_cmdh_tm(csp_packet_t *packet) {
         cmd_add_params_raw(cmd_parse_tm, frame, sizeof(com_frame_t));
         cmd_send(cmd_parse_tm);
     }
-    if(frame->type == TM_TYPE_PAYLOAD_STA)
+    if(frame->type == TM_TYPE_PAYLOAD_STA || frame->type == TM_TYPE_BEACON_PACKED)
     {
         cmd_parse_tm = cmd_get_str("tm_parse_beacon");
         cmd_add_params_raw(cmd_parse_tm, frame, sizeof(com_frame_t));
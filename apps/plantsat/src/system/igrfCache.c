@@ -0,0 +1,293 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/igrfCache.h"
+
+static const char *tag = "igrfCache";
+
+#define IGRF_A 6371.2                   ///< Geomagnetic reference radius [km]
+#define IGRF_WGS84_A2 40680631.590769   ///< WGS84 semi-major axis squared [km^2]
+#define IGRF_WGS84_B2 40408299.984087   ///< WGS84 semi-minor axis squared [km^2]
+#define IGRF_MIN_ST 1e-10               ///< Min. sine of the colatitude, avoids the poles singularity
+
+/**
+ * IGRF-13 Schmidt semi-normalized coefficients. Each row is a degree n:
+ * g(n,0), g(n,1), h(n,1), ..., g(n,n), h(n,n)
+ */
+static const double igrf_gh_2020[] = {
+    -29404.8, -1450.9, 4652.5,
+    -2499.6, 2982.0, -2991.6, 1677.0, -734.6,
+    1363.2, -2381.2, -82.1, 1236.2, 241.9, 525.7, -543.4,
+    903.0, 809.5, 281.9, 86.3, -158.4, -309.4, 199.7, 48.0, -349.7,
+    -234.3, 363.2, 47.7, 187.8, 208.3, -140.7, -121.2, -151.2, 32.3, 13.5, 98.9,
+    66.0, 65.5, -19.1, 72.9, 25.1, -121.5, 52.8, -36.2, -64.5, 13.5, 8.9, -64.7, 68.1,
+    80.6, -76.7, -51.5, -8.2, -16.9, 56.5, 2.2, 15.8, 23.5, 6.4, -2.2, -7.2, -27.2, 9.8, -1.8,
+    23.7, 9.7, 8.4, -17.6, -15.3, -0.5, 12.8, -21.1, -11.7, 15.3, 14.9, 13.7, 3.6, -16.5, -6.9, -0.3, 2.8,
+    5.0, 8.4, -23.4, 2.9, 11.0, -1.5, 9.8, -1.1, -5.1, -13.2, -6.3, 1.1, 7.8, 8.8, 0.4, -9.3, -1.4, -11.9, 9.6,
+    -1.9, -6.2, 3.4, -0.1, -0.2, 1.7, 3.6, -0.9, 4.8, 0.7, -8.6, -0.9, -0.1, 1.9, -4.3, 1.4, -3.4, -2.4, -0.1,
+    -3.8, -8.8,
+    3.0, -1.4, 0.0, -2.5, 2.5, 2.3, -0.6, -0.9, -0.4, 0.3, 0.6, -0.7, -0.2, -0.1, -1.7, 1.4, -1.6, -0.6, -3.0,
+    0.2, -2.0, 3.1, -2.6,
+    -2.0, -0.1, -1.2, 0.5, 0.5, 1.3, 1.4, -1.2, -1.8, 0.7, 0.1, 0.3, 0.8, 0.5, -0.2, -0.3, 0.6, -0.5, 0.2,
+    0.1, -0.9, -1.1, 0.0, -0.3, 0.5,
+    0.1, -0.9, -0.9, 0.5, 0.6, 0.7, 1.4, -0.3, -0.4, 0.8, -1.3, 0.0, -0.1, 0.8, 0.3, 0.0, -0.1, 0.4, 0.5,
+    0.1, 0.5, 0.5, 0.5, -0.5, -0.4, -0.4, -0.4,
+};
+
+/**
+ * IGRF-13 secular variation 2020-2025 [nT/year], same order than igrf_gh_2020.
+ * Only up to degree IGRF_CACHE_SV_NMAX, higher degrees are constant.
+ */
+static const double igrf_sv_2020[] = {
+    5.7, 7.4, -25.9,
+    -11.0, -7.0, -30.2, -2.1, -22.4,
+    2.2, -5.9, 6.0, 3.1, -1.1, -12.0, 0.5,
+    -1.2, -1.6, -0.1, -5.9, 6.5, 5.2, 3.6, -5.1, -5.0,
+    -0.3, 0.5, 0.0, -0.6, 2.5, 0.2, -0.6, 1.3, 3.0, 0.9, 0.3,
+    -0.5, -0.3, 0.0, 0.4, -1.6, 1.3, -1.3, -1.4, 0.8, 0.0, 0.0, 0.9, 1.0,
+    -0.1, -0.2, 0.6, 0.0, 0.6, 0.7, -0.8, 0.1, -0.2, -0.5, -1.1, -0.8, 0.1, 0.8, 0.3,
+    0.0, 0.1, -0.2, -0.1, 0.6, 0.4, -0.2, -0.1, 0.5, 0.4, -0.3, 0.3, -0.4, -0.1, 0.5, 0.4, 0.0,
+};
+
+/**
+ * Coefficients of the day, Schmidt normalization applied (to be used with the
+ * Gauss normalized Legendre functions)
+ */
+typedef struct igrf_coeffs {
+    double year;                                      ///< Decimal year of the coefficients
+    int nmax;                                         ///< Degree in use
+    double err;                                       ///< RMS truncation error of nmax [nT]
+    double g[IGRF_CACHE_NMAX+1][IGRF_CACHE_NMAX+1];
+    double h[IGRF_CACHE_NMAX+1][IGRF_CACHE_NMAX+1];
+    double rn[IGRF_CACHE_NMAX+1];                     ///< Lowes-Mauersberger spectrum at IGRF_CACHE_REF_ALT [nT^2]
+} igrf_coeffs_t;
+
+static igrf_coeffs_t igrf_coeffs;
+static double igrf_k[IGRF_CACHE_NMAX+1][IGRF_CACHE_NMAX+1];  ///< Legendre recursion constants
+static double igrf_s[IGRF_CACHE_NMAX+1][IGRF_CACHE_NMAX+1];  ///< Schmidt normalization factors
+static double igrf_p[IGRF_CACHE_NMAX+1][IGRF_CACHE_NMAX+1];  ///< Gauss normalized P(n,m)
+static double igrf_dp[IGRF_CACHE_NMAX+1][IGRF_CACHE_NMAX+1]; ///< dP(n,m)/dtheta
+static double igrf_max_err = 0;                              ///< 0 to use the full degree
+static osSemaphore igrf_sem;
+
+int igrf_cache_init(void)
+{
+    int n, m;
+    memset(&igrf_coeffs, 0, sizeof(igrf_coeffs));
+    memset(igrf_k, 0, sizeof(igrf_k));
+    memset(igrf_s, 0, sizeof(igrf_s));
+
+    igrf_s[0][0] = 1.0;
+    for(n = 1; n <= IGRF_CACHE_NMAX; n++)
+    {
+        igrf_s[n][0] = igrf_s[n-1][0] * (2*n - 1) / (double)n;
+        for(m = 1; m <= n; m++)
+            igrf_s[n][m] = igrf_s[n][m-1] * sqrt((n - m + 1) * (m == 1 ? 2.0 : 1.0) / (n + m));
+        for(m = 0; n > 1 && m <= n - 2; m++)
+            igrf_k[n][m] = ((n-1)*(n-1) - m*m) / (double)((2*n - 1)*(2*n - 3));
+    }
+
+    if(osSemaphoreCreate(&igrf_sem) != OS_SEMAPHORE_OK)
+    {
+        LOGE(tag, "Unable to create IGRF mutex");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Select the lowest degree with a truncation error below igrf_max_err.
+ * Call with the mutex taken.
+ */
+static void igrf_select_degree(void)
+{
+    int nmax = IGRF_CACHE_NMAX;
+    double err2 = 0;
+    if(igrf_max_err > 0)
+    {
+        // Add the spectrum from the highest degree while the error is bounded
+        while(nmax > 1 && err2 + igrf_coeffs.rn[nmax] <= igrf_max_err * igrf_max_err)
+            err2 += igrf_coeffs.rn[nmax--];
+    }
+    igrf_coeffs.nmax = nmax;
+    igrf_coeffs.err = sqrt(err2);
+}
+
+/**
+ * Calculate the coefficients of the day. Call with the mutex taken.
+ */
+static void igrf_update_coeffs(double decyear)
+{
+    int n, m, i = 0;
+    double dt = decyear - IGRF_CACHE_EPOCH;
+    double ar2 = (IGRF_A / (IGRF_A + IGRF_CACHE_REF_ALT)) * (IGRF_A / (IGRF_A + IGRF_CACHE_REF_ALT));
+    double arn = ar2 * ar2;
+
+    for(n = 1; n <= IGRF_CACHE_NMAX; n++)
+    {
+        double sum2 = 0;
+        for(m = 0; m <= n; m++)
+        {
+            double g = igrf_gh_2020[i] + (n <= IGRF_CACHE_SV_NMAX ? igrf_sv_2020[i] * dt : 0);
+            double h = 0;
+            i++;
+            if(m > 0)
+            {
+                h = igrf_gh_2020[i] + (n <= IGRF_CACHE_SV_NMAX ? igrf_sv_2020[i] * dt : 0);
+                i++;
+            }
+            sum2 += g*g + h*h;
+            igrf_coeffs.g[n][m] = igrf_s[n][m] * g;
+            igrf_coeffs.h[n][m] = igrf_s[n][m] * h;
+        }
+        arn *= ar2;
+        igrf_coeffs.rn[n] = (n + 1) * arn * sum2;
+    }
+
+    igrf_coeffs.year = decyear;
+    igrf_select_degree();
+    LOGI(tag, "IGRF coefficients updated (%.3f), degree %d, error %.1f nT", decyear,
+         igrf_coeffs.nmax, igrf_coeffs.err);
+}
+
+/**
+ * Calculate the Gauss normalized associated Legendre functions and their
+ * derivatives with respect to the colatitude. Call with the mutex taken.
+ */
+static void igrf_legendre(int nmax, double ct, double st)
+{
+    int n, m;
+    igrf_p[0][0] = 1.0;
+    igrf_dp[0][0] = 0.0;
+    for(n = 1; n <= nmax; n++)
+    {
+        for(m = 0; m < n; m++)
+        {
+            double p2 = 0, dp2 = 0;
+            if(m <= n - 2)
+            {
+                p2 = igrf_k[n][m] * igrf_p[n-2][m];
+                dp2 = igrf_k[n][m] * igrf_dp[n-2][m];
+            }
+            igrf_p[n][m] = ct * igrf_p[n-1][m] - p2;
+            igrf_dp[n][m] = ct * igrf_dp[n-1][m] - st * igrf_p[n-1][m] - dp2;
+        }
+        igrf_p[n][n] = st * igrf_p[n-1][n-1];
+        igrf_dp[n][n] = st * igrf_dp[n-1][n-1] + ct * igrf_p[n-1][n-1];
+    }
+}
+
+int igrf_cache_calc(double decyear, double lat, double lon, double alt, double sidereal, vector3_t *mag)
+{
+    int n, m;
+    if(mag == NULL)
+        return -1;
+
+    osSemaphoreTake(&igrf_sem, portMAX_DELAY);
+    if(igrf_coeffs.year == 0 || fabs(decyear - igrf_coeffs.year) >= IGRF_CACHE_UPDATE)
+        igrf_update_coeffs(decyear);
+    int nmax = igrf_coeffs.nmax;
+
+    // Geodetic to geocentric coordinates (WGS84)
+    double h = alt / 1000.0;
+    double ctg = sin(lat);
+    double stg = cos(lat);
+    double one = IGRF_WGS84_A2 * stg * stg;
+    double two = IGRF_WGS84_B2 * ctg * ctg;
+    double three = one + two;
+    double rho = sqrt(three);
+    double r = sqrt(h * (h + 2.0 * rho) + (IGRF_WGS84_A2 * one + IGRF_WGS84_B2 * two) / three);
+    double cd = (h + rho) / r;
+    double sd = (IGRF_WGS84_A2 - IGRF_WGS84_B2) / rho * ctg * stg / r;
+
+    // Geocentric colatitude
+    double ct = ctg * cd - stg * sd;
+    double st = stg * cd + ctg * sd;
+    if(st < IGRF_MIN_ST)
+        st = IGRF_MIN_ST;
+    igrf_legendre(nmax, ct, st);
+
+    // cos(m*lon) and sin(m*lon) by recurrence
+    double cm[IGRF_CACHE_NMAX+1], sm[IGRF_CACHE_NMAX+1];
+    double cl = cos(lon), sl = sin(lon);
+    cm[0] = 1.0; sm[0] = 0.0;
+    for(m = 1; m <= nmax; m++)
+    {
+        cm[m] = cm[m-1] * cl - sm[m-1] * sl;
+        sm[m] = sm[m-1] * cl + cm[m-1] * sl;
+    }
+
+    // Field in geocentric spherical coordinates
+    double ar = IGRF_A / r;
+    double arn = ar * ar;
+    double br = 0, bt = 0, bp = 0;
+    for(n = 1; n <= nmax; n++)
+    {
+        double sr = 0, st_ = 0, sp = 0;
+        arn *= ar;
+        for(m = 0; m <= n; m++)
+        {
+            double g = igrf_coeffs.g[n][m];
+            double hh = igrf_coeffs.h[n][m];
+            double t = g * cm[m] + hh * sm[m];
+            sr += t * igrf_p[n][m];
+            st_ += t * igrf_dp[n][m];
+            sp += m * (g * sm[m] - hh * cm[m]) * igrf_p[n][m];
+        }
+        br += (n + 1) * arn * sr;
+        bt -= arn * st_;
+        bp += arn * sp;
+    }
+    bp /= st;
+    osSemaphoreGiven(&igrf_sem);
+
+    // To the inertial frame, the inertial longitude is lon + sidereal
+    double cs = cos(sidereal), ss = sin(sidereal);
+    double cpi = cl * cs - sl * ss;
+    double spi = sl * cs + cl * ss;
+    mag->v0 = br * st * cpi + bt * ct * cpi - bp * spi;
+    mag->v1 = br * st * spi + bt * ct * spi + bp * cpi;
+    mag->v2 = br * ct - bt * st;
+
+    return nmax;
+}
+
+int igrf_cache_set_max_error(double max_err)
+{
+    int nmax = -1;
+    osSemaphoreTake(&igrf_sem, portMAX_DELAY);
+    igrf_max_err = max_err > 0 ? max_err : 0;
+    if(igrf_coeffs.year != 0)
+    {
+        igrf_select_degree();
+        nmax = igrf_coeffs.nmax;
+    }
+    osSemaphoreGiven(&igrf_sem);
+    return nmax;
+}
+
+int igrf_cache_get_degree(double *err)
+{
+    osSemaphoreTake(&igrf_sem, portMAX_DELAY);
+    int nmax = igrf_coeffs.nmax;
+    if(err != NULL)
+        *err = igrf_coeffs.err;
+    osSemaphoreGiven(&igrf_sem);
+    return nmax;
+}
@@ -32,6 +32,8 @@
 #include "app/system/cmdCDH.h"
 #include "app/system/taskHousekeeping.h"
 #include "app/system/taskADCS.h"
+#include "app/system/taskADCSSensors.h"
+#include "app/system/taskADCSReference.h"
 #include "app/system/taskSensors.h"
 
 static char *tag = "app_main";
@@ -177,7 +179,7 @@ int init_deployment_routine(void)
     {
         LOGI(tag, "ANTENNA DEPLOYMENT");
         eps_update_status_vars(NULL, NULL, 0);
-        int vbat_mV = dat_get_system_var(dat_eps_vbatt);
+        int vbat_mV = sts_get_system_var(dat_eps_vbatt);
 
         // Deploy antenna
         LOGI(tag, "Deploying antennas: %d (Battery Voltage: %.04f)", vbat_mV>7000, vbat_mV/1000.0);
@@ -210,6 +212,9 @@ void initAppHook(void *params)
 {
     int rc;
 
+    /** Init status variables snapshots */
+    sts_init();
+
     /** Include app commands */
     cmd_adcs_init();
     cmd_ax100_init();
@@ -244,6 +249,14 @@ void initAppHook(void *params)
     if(t_ok != 0) LOGE(tag, "Task sensors not created!");
 #endif
 #if SCH_ADCS_ENABLED
+    adcs_sen_init();
+    t_ok = osCreateTask(taskADCSSensors, "adcs_sen", 2*SCH_TASK_DEF_STACK, (void *)ADCS_SEN_GROUP_FAST, 2, NULL);
+    if(t_ok != 0) LOGE(tag, "Task ADCS sensors not created!");
+    t_ok = osCreateTask(taskADCSSensors, "adcs_sun", 2*SCH_TASK_DEF_STACK, (void *)ADCS_SEN_GROUP_SUN, 2, NULL);
+    if(t_ok != 0) LOGE(tag, "Task ADCS sun sensors not created!");
+    adcs_ref_init();
+    t_ok = osCreateTask(taskADCSReference, "adcs_ref", 2*SCH_TASK_DEF_STACK, NULL, 1, NULL);
+    if(t_ok != 0) LOGE(tag, "Task ADCS reference not created!");
     t_ok = osCreateTask(taskADCS,"adcs", 3*SCH_TASK_DEF_STACK, NULL, 2, NULL);
     if(t_ok != 0) LOGE(tag, "Task ADCS not created!");
 #endif
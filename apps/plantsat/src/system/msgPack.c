@@ -0,0 +1,155 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/msgPack.h"
+
+static void msg_put32(uint8_t *buff, uint32_t value)
+{
+    buff[0] = (uint8_t)(value >> 24);
+    buff[1] = (uint8_t)(value >> 16);
+    buff[2] = (uint8_t)(value >> 8);
+    buff[3] = (uint8_t)value;
+}
+
+static uint32_t msg_get32(const uint8_t *buff)
+{
+    return ((uint32_t)buff[0] << 24) | ((uint32_t)buff[1] << 16) | ((uint32_t)buff[2] << 8) | buff[3];
+}
+
+int msg_pack_init(uint8_t *buff, int len)
+{
+    if(len < MSG_PACK_HEADER_LEN)
+        return -1;
+    buff[0] = MSG_PACK_VERSION;
+    buff[1] = 0;
+    return MSG_PACK_HEADER_LEN;
+}
+
+int msg_pack_init_dict(uint8_t *buff, int len)
+{
+    if(len < MSG_PACK_HEADER_LEN_DICT)
+        return -1;
+    buff[0] = MSG_PACK_VERSION_DICT;
+    buff[1] = 0;
+    buff[2] = DICT_COMP_ID;
+    return MSG_PACK_HEADER_LEN_DICT;
+}
+
+int msg_pack_add(uint8_t *buff, int len, int used, uint32_t id, uint32_t timestamp, const uint8_t *msg, int msg_len)
+{
+    if(msg_len < 0 || msg_len > MSG_PACK_MAX_MSG || buff[1] == UINT8_MAX)
+        return -1;
+    if(used + MSG_PACK_RECORD_LEN + msg_len > len)
+        return -1;
+
+    msg_put32(buff + used, id);
+    msg_put32(buff + used + 4, timestamp);
+    buff[used + 8] = (uint8_t)msg_len;
+    memcpy(buff + used + MSG_PACK_RECORD_LEN, msg, msg_len);
+    buff[1]++;
+    return used + MSG_PACK_RECORD_LEN + msg_len;
+}
+
+int msg_pack_add_dict(uint8_t *buff, int len, int used, uint32_t id, uint32_t timestamp, const uint8_t *text, int hist, int msg_len)
+{
+    if(buff[0] != MSG_PACK_VERSION_DICT || buff[1] == UINT8_MAX || used + MSG_PACK_RECORD_LEN > len)
+        return -1;
+
+    int max = len - used - MSG_PACK_RECORD_LEN;
+    int clen = dict_compress(text, hist, msg_len, buff + used + MSG_PACK_RECORD_LEN, max < MSG_PACK_MAX_MSG ? max : MSG_PACK_MAX_MSG);
+    if(clen < 0)
+        return -1;
+
+    msg_put32(buff + used, id);
+    msg_put32(buff + used + 4, timestamp);
+    buff[used + 8] = (uint8_t)clen;
+    buff[1]++;
+    return used + MSG_PACK_RECORD_LEN + clen;
+}
+
+int msg_unpack_count(uint8_t *buff, int len)
+{
+    if(len < MSG_PACK_HEADER_LEN)
+        return -1;
+    if(buff[0] == MSG_PACK_VERSION_DICT && (len < MSG_PACK_HEADER_LEN_DICT || buff[2] != DICT_COMP_ID))
+        return -1;
+    if(buff[0] != MSG_PACK_VERSION && buff[0] != MSG_PACK_VERSION_DICT)
+        return -1;
+    return buff[1];
+}
+
+int msg_unpack_next(uint8_t *buff, int len, int *pos, uint32_t *id, uint32_t *timestamp, uint8_t *msg, int max)
+{
+    if(len < MSG_PACK_HEADER_LEN || buff[0] != MSG_PACK_VERSION || max < 1)
+        return -1;
+    if(*pos < MSG_PACK_HEADER_LEN)
+        *pos = MSG_PACK_HEADER_LEN;
+    if(*pos + MSG_PACK_RECORD_LEN > len)
+        return -1;
+
+    uint8_t *record = buff + *pos;
+    int msg_len = record[8];
+    if(*pos + MSG_PACK_RECORD_LEN + msg_len > len)
+        return -1;
+
+    *id = msg_get32(record);
+    *timestamp = msg_get32(record + 4);
+    int n = msg_len < max - 1 ? msg_len : max - 1;
+    memcpy(msg, record + MSG_PACK_RECORD_LEN, n);
+    msg[n] = '\0';
+    *pos += MSG_PACK_RECORD_LEN + msg_len;
+    return n;
+}
+
+int msg_unpack_next_text(uint8_t *buff, int len, int *pos, uint32_t *id, uint32_t *timestamp, uint8_t *text, int *hist, int max)
+{
+    if(msg_unpack_count(buff, len) < 0)
+        return -1;
+    int header = buff[0] == MSG_PACK_VERSION_DICT ? MSG_PACK_HEADER_LEN_DICT : MSG_PACK_HEADER_LEN;
+    if(*pos < header)
+        *pos = header;
+    if(*pos + MSG_PACK_RECORD_LEN > len)
+        return -1;
+
+    uint8_t *record = buff + *pos;
+    int rec_len = record[8];
+    if(*pos + MSG_PACK_RECORD_LEN + rec_len > len)
+        return -1;
+
+    int n;
+    if(buff[0] == MSG_PACK_VERSION_DICT)
+    {
+        n = dict_decompress(record + MSG_PACK_RECORD_LEN, rec_len, text, *hist, max);
+        if(n < 0)
+            return -1;
+    }
+    else
+    {
+        if(*hist + rec_len > max)
+            return -1;
+        memcpy(text + *hist, record + MSG_PACK_RECORD_LEN, rec_len);
+        n = rec_len;
+    }
+
+    *id = msg_get32(record);
+    *timestamp = msg_get32(record + 4);
+    *hist += n;
+    *pos += MSG_PACK_RECORD_LEN + rec_len;
+    return n;
+}
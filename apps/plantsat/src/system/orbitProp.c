@@ -0,0 +1,148 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/orbitProp.h"
+
+static const char *tag = "orbitProp";
+
+/**
+ * Propagated state at a multiple of ORBIT_PROP_STEP
+ */
+typedef struct orbit_state {
+    double t;                       ///< Unix time [s], 0 if empty
+    double r[3];                    ///< Position, ECI frame [km]
+    double v[3];                    ///< Velocity, ECI frame [km/s]
+} orbit_state_t;
+
+static TLE orbit_tle;
+static int orbit_tle_valid = 0;
+static orbit_state_t orbit_states[ORBIT_PROP_NSTATES];
+static osSemaphore orbit_sem;
+
+int orbit_prop_init(void)
+{
+    memset(&orbit_tle, 0, sizeof(orbit_tle));
+    memset(orbit_states, 0, sizeof(orbit_states));
+    orbit_tle_valid = 0;
+    if(osSemaphoreCreate(&orbit_sem) != OS_SEMAPHORE_OK)
+    {
+        LOGE(tag, "Unable to create orbit propagation mutex");
+        return -1;
+    }
+    return 0;
+}
+
+int orbit_prop_set_tle(char *line1, char *line2, double *epoch)
+{
+    osSemaphoreTake(&orbit_sem, portMAX_DELAY);
+    parseLines(&orbit_tle, line1, line2);
+    orbit_tle_valid = orbit_tle.sgp4Error == 0;
+    memset(orbit_states, 0, sizeof(orbit_states));
+    if(epoch != NULL)
+        *epoch = orbit_tle_valid ? orbit_tle.epoch : 0;
+    int valid = orbit_tle_valid;
+    osSemaphoreGiven(&orbit_sem);
+    return valid ? 0 : -1;
+}
+
+/**
+ * Run SGP4 at time t. Call with the mutex taken.
+ */
+static int orbit_sgp4(double t, double r[3], double v[3])
+{
+    if(!orbit_tle_valid)
+        return -1;
+    getRVForDate(&orbit_tle, t * 1000.0, r, v);
+    if(orbit_tle.sgp4Error != 0)
+    {
+        LOGW(tag, "SGP4 error %d at %.0f", orbit_tle.sgp4Error, t);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Get the cached state at the step time t, or propagate it replacing the
+ * state farthest from t. Call with the mutex taken.
+ */
+static orbit_state_t *orbit_get_state(double t)
+{
+    int i, far = 0;
+    for(i = 0; i < ORBIT_PROP_NSTATES; i++)
+    {
+        if(orbit_states[i].t == t)
+            return &orbit_states[i];
+        if(fabs(orbit_states[i].t - t) > fabs(orbit_states[far].t - t))
+            far = i;
+    }
+
+    orbit_state_t *state = &orbit_states[far];
+    if(orbit_sgp4(t, state->r, state->v) != 0)
+    {
+        state->t = 0;
+        return NULL;
+    }
+    state->t = t;
+    return state;
+}
+
+int orbit_prop_get(double t, vector3_t *r, vector3_t *v)
+{
+    int i;
+    double ta = floor(t / ORBIT_PROP_STEP) * ORBIT_PROP_STEP;
+
+    osSemaphoreTake(&orbit_sem, portMAX_DELAY);
+    orbit_state_t *a = orbit_get_state(ta);
+    orbit_state_t *b = a == NULL ? NULL : orbit_get_state(ta + ORBIT_PROP_STEP);
+    if(a == NULL || b == NULL)
+    {
+        osSemaphoreGiven(&orbit_sem);
+        return -1;
+    }
+
+    // Cubic Hermite spline between the states a and b
+    double h = ORBIT_PROP_STEP;
+    double s = (t - ta) / h;
+    double s2 = s * s, s3 = s2 * s;
+    double h00 = 2*s3 - 3*s2 + 1, h10 = s3 - 2*s2 + s, h01 = -2*s3 + 3*s2, h11 = s3 - s2;
+    double d00 = 6*s2 - 6*s, d10 = 3*s2 - 4*s + 1, d01 = -6*s2 + 6*s, d11 = 3*s2 - 2*s;
+    for(i = 0; i < 3; i++)
+    {
+        r->v[i] = h00 * a->r[i] + h10 * h * a->v[i] + h01 * b->r[i] + h11 * h * b->v[i];
+        if(v != NULL)
+            v->v[i] = (d00 * a->r[i] + d01 * b->r[i]) / h + d10 * a->v[i] + d11 * b->v[i];
+    }
+    osSemaphoreGiven(&orbit_sem);
+    return 0;
+}
+
+int orbit_prop_calc(double t, vector3_t *r, vector3_t *v)
+{
+    double _r[3], _v[3];
+    osSemaphoreTake(&orbit_sem, portMAX_DELAY);
+    int rc = orbit_sgp4(t, _r, _v);
+    osSemaphoreGiven(&orbit_sem);
+    if(rc != 0)
+        return -1;
+
+    memcpy(r->v, _r, sizeof(_r));
+    if(v != NULL)
+        memcpy(v->v, _v, sizeof(_v));
+    return 0;
+}
@@ -0,0 +1,269 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/payloadRetention.h"
+
+static const char *tag = "payRetention";
+
+static osSemaphore ret_sem;
+static uint8_t ret_policy[last_sensor];
+static uint32_t ret_dropped[last_sensor];       ///< Samples dropped by RET_POLICY_KEEP_FIRST
+static uint32_t ret_decimated[last_sensor];     ///< Samples moved to the decimated half by RET_POLICY_DECIMATE
+
+static const char *ret_policy_names[RET_POLICY_LAST] = {"ring", "keep_first", "decimate"};
+
+/**
+ * Default policies. High rate data keeps the most recent samples, slow
+ * housekeeping data keeps older data at half rate and messages are never
+ * overwritten.
+ */
+static const uint8_t ret_default_policy[last_sensor] = {
+        RET_POLICY_DECIMATE,    // temp_sensors
+        RET_POLICY_RING,        // ads_sensors
+        RET_POLICY_DECIMATE,    // eps_sensors
+        RET_POLICY_RING,        // status_sensors
+        RET_POLICY_RING,        // stt_sensors
+        RET_POLICY_RING,        // rw_sensors
+        RET_POLICY_RING,        // fss_sensors
+        RET_POLICY_RING,        // ekf_sensors
+        RET_POLICY_RING,        // ctrl_data
+        RET_POLICY_KEEP_FIRST,  // msg_sensors
+        RET_POLICY_RING,        // agg_sensors
+        RET_POLICY_KEEP_FIRST,  // rec_blocks
+        RET_POLICY_RING,        // evt_sensors
+        RET_POLICY_RING,        // tim_sensors
+};
+
+/**
+ * Get the index of the oldest retained sample. Requires ret_sem to be taken.
+ * @param last Payload index, the number of samples added
+ */
+static int _ret_first(int payload, int capacity, int last)
+{
+    if(ret_policy[payload] == RET_POLICY_RING)
+        return last > capacity ? last - capacity : 0;
+
+    if(ret_policy[payload] == RET_POLICY_DECIMATE)
+    {
+        // Even samples evicted from the recent half, the last half capacity ones are kept
+        int half = capacity / 2;
+        int evicted = last > half ? (last - half + 1) / 2 : 0;
+        return evicted > capacity - half ? 2 * (evicted - (capacity - half)) : 0;
+    }
+    return 0;
+}
+
+/**
+ * Get the storage slot of a sample. Requires ret_sem to be taken.
+ * @return Slot, or -1 if the sample is not retained
+ */
+static int _ret_slot(int payload, int capacity, int last, int index)
+{
+    if(index < _ret_first(payload, capacity, last) || index >= last)
+        return -1;
+
+    if(ret_policy[payload] == RET_POLICY_RING)
+        return index % capacity;
+
+    if(ret_policy[payload] == RET_POLICY_DECIMATE)
+    {
+        int half = capacity / 2;
+        if(index >= last - half)
+            return index % half;
+        return index % 2 == 0 ? half + (index / 2) % (capacity - half) : -1;
+    }
+    return index;
+}
+
+int ret_init(void)
+{
+    memcpy(ret_policy, ret_default_policy, sizeof(ret_policy));
+#if !SBUF_OVERWRITE
+    // Stored slots can not be written again
+    memset(ret_policy, RET_POLICY_KEEP_FIRST, sizeof(ret_policy));
+#endif
+    memset(ret_dropped, 0, sizeof(ret_dropped));
+    memset(ret_decimated, 0, sizeof(ret_decimated));
+    if(osSemaphoreCreate(&ret_sem) != OS_SEMAPHORE_OK)
+    {
+        LOGE(tag, "Unable to create retention mutex");
+        return -1;
+    }
+    return 0;
+}
+
+int ret_get_capacity(int payload)
+{
+    if(payload < 0 || payload >= last_sensor)
+        return -1;
+    return sbuf_get_capacity(payload);
+}
+
+int ret_set_policy(int payload, int policy)
+{
+    if(payload < 0 || payload >= last_sensor || policy < 0 || policy >= RET_POLICY_LAST)
+        return -1;
+#if !SBUF_OVERWRITE
+    if(policy != RET_POLICY_KEEP_FIRST)
+    {
+        LOGE(tag, "The storage can not overwrite payload samples, only keep_first is available");
+        return -1;
+    }
+#endif
+
+    // All the policies store sample i at slot i until half the table is used
+    int rc = 0;
+    osSemaphoreTake(&ret_sem, portMAX_DELAY);
+    if(policy != ret_policy[payload] && dat_get_system_var(data_map[payload].sys_index) > ret_get_capacity(payload) / 2)
+    {
+        LOGE(tag, "Payload %d table is half full, delete it before changing its policy", payload);
+        rc = -1;
+    }
+    else
+    {
+        ret_policy[payload] = (uint8_t)policy;
+    }
+    osSemaphoreGiven(&ret_sem);
+    return rc;
+}
+
+int ret_add_payload_sample(void *data, int payload)
+{
+    if(payload < 0 || payload >= last_sensor)
+        return -1;
+
+    int capacity = ret_get_capacity(payload);
+    if(capacity < 2)
+        return dat_add_payload_sample(data, payload);
+
+    data_map_t *map = &data_map[payload];
+    int rc = 0;
+    osSemaphoreTake(&ret_sem, portMAX_DELAY);
+    uint32_t index = (uint32_t)dat_get_system_var(map->sys_index);
+    int slot = (int)index;
+    if(ret_policy[payload] == RET_POLICY_RING)
+    {
+        slot = (int)(index % capacity);
+    }
+    else if(ret_policy[payload] == RET_POLICY_DECIMATE)
+    {
+        // The sample leaving the recent half is kept in the decimated half
+        // if it is even. It is copied before its slot is overwritten.
+        int half = capacity / 2;
+        slot = (int)(index % half);
+        if(index >= (uint32_t)half && (index - half) % 2 == 0)
+        {
+            uint8_t *old = (uint8_t *)malloc(map->size);
+            if(old != NULL && sbuf_get_sample(payload, slot, old) == 0 &&
+               sbuf_set_sample(payload, half + (int)(((index - half) / 2) % (capacity - half)), old) == 0)
+                ret_decimated[payload]++;
+            else
+                LOGW(tag, "Payload %d sample %u not decimated", payload, (unsigned int)(index - half));
+            free(old);
+        }
+    }
+    else if(index >= (uint32_t)capacity)
+    {
+        // Dropped by policy, not a storage error
+        if(ret_dropped[payload]++ == 0)
+            LOGW(tag, "Payload %d table full, dropping new samples", payload);
+        osSemaphoreGiven(&ret_sem);
+        return 0;
+    }
+
+    // All payload structs start with the sample index
+    memcpy(data, &index, sizeof(index));
+    rc = sbuf_set_sample(payload, slot, data);
+    if(rc == 0)
+    {
+        index++;
+        dat_set_system_var(map->sys_index, (int)index);
+
+        // Do not acknowledge less than the oldest sample
+        int first = _ret_first(payload, capacity, (int)index);
+        if(dat_get_system_var(map->sys_ack) < first)
+            dat_set_system_var(map->sys_ack, first);
+    }
+    osSemaphoreGiven(&ret_sem);
+    return rc == 0 ? 0 : -1;
+}
+
+int ret_get_payload_sample(void *data, int payload, int index)
+{
+    if(payload < 0 || payload >= last_sensor || index < 0)
+        return -1;
+
+    int capacity = ret_get_capacity(payload);
+    if(capacity < 2)
+        return dat_get_payload_sample(data, payload, index);
+
+    osSemaphoreTake(&ret_sem, portMAX_DELAY);
+    int rc = -1;
+    int slot = _ret_slot(payload, capacity, dat_get_system_var(data_map[payload].sys_index), index);
+    if(slot >= 0)
+        rc = sbuf_get_sample(payload, slot, data);
+    osSemaphoreGiven(&ret_sem);
+    return rc == 0 ? 0 : -1;
+}
+
+int ret_get_next(int payload, int index)
+{
+    if(payload < 0 || payload >= last_sensor)
+        return -1;
+
+    int capacity = ret_get_capacity(payload);
+    osSemaphoreTake(&ret_sem, portMAX_DELAY);
+    int last = dat_get_system_var(data_map[payload].sys_index);
+    int first = capacity < 2 ? 0 : _ret_first(payload, capacity, last);
+    if(index < first)
+        index = first;
+    if(capacity >= 2 && index < last && _ret_slot(payload, capacity, last, index) < 0)
+        index++;
+    osSemaphoreGiven(&ret_sem);
+    return index;
+}
+
+int ret_get_first(int payload)
+{
+    if(payload < 0 || payload >= last_sensor)
+        return -1;
+
+    int capacity = ret_get_capacity(payload);
+    if(capacity < 2)
+        return 0;
+
+    osSemaphoreTake(&ret_sem, portMAX_DELAY);
+    int first = _ret_first(payload, capacity, dat_get_system_var(data_map[payload].sys_index));
+    osSemaphoreGiven(&ret_sem);
+    return first;
+}
+
+void ret_print(void)
+{
+    int p;
+    osSemaphoreTake(&ret_sem, portMAX_DELAY);
+    LOGR(tag, "payload, policy, index, ack, capacity, dropped, decimated");
+    for(p = 0; p < last_sensor; p++)
+    {
+        LOGR(tag, "%d, %s, %d, %d, %d, %u, %u", p, ret_policy_names[ret_policy[p]],
+             dat_get_system_var(data_map[p].sys_index), dat_get_system_var(data_map[p].sys_ack),
+             ret_get_capacity(p), (unsigned int)ret_dropped[p], (unsigned int)ret_decimated[p]);
+    }
+    osSemaphoreGiven(&ret_sem);
+}
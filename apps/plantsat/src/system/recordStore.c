@@ -0,0 +1,217 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/recordStore.h"
+
+static const char *tag = "recStore";
+
+static osSemaphore rec_sem;
+static rec_block_t rec_open;        ///< Block receiving new records
+static rec_block_t rec_read;        ///< Block read from the storage
+static int rec_read_index = -1;     ///< Payload index of rec_read, -1 if not valid
+
+/**
+ * Store the open block and start a new one. Requires rec_sem to be taken.
+ */
+static int _rec_write_open(void)
+{
+    int rc = 0;
+    if(rec_open.count > 0)
+    {
+        rc = ret_add_payload_sample(&rec_open, rec_blocks);
+        if(rc != 0)
+            LOGE(tag, "Error storing records block (%d records lost)", rec_open.count);
+    }
+
+    rec_open.first += rec_open.count;
+    rec_open.count = 0;
+    rec_open.used = 0;
+    rec_open.timestamp = dat_get_time();
+    return rc;
+}
+
+/**
+ * Read a stored block into rec_read, unless it is already there. Stored
+ * blocks do not change, so the last read block is reused. Requires rec_sem
+ * to be taken.
+ */
+static int _rec_read_block(int index)
+{
+    if(index == rec_read_index)
+        return 0;
+    if(ret_get_payload_sample(&rec_read, rec_blocks, index) != 0)
+    {
+        rec_read_index = -1;
+        return -1;
+    }
+    rec_read_index = index;
+    return 0;
+}
+
+/**
+ * Find a record inside a block
+ * @return Record length (truncated to max), or -1 if not found
+ */
+static int _rec_find(rec_block_t *block, uint32_t id, uint8_t *data, int max, uint32_t *timestamp)
+{
+    if(id < block->first || id >= block->first + block->count)
+        return -1;
+
+    int pos = 0;
+    uint32_t i;
+    for(i = block->first; i < id; i++)
+        pos += REC_HEADER_LEN + block->data[pos + 4];
+    if(pos + REC_HEADER_LEN > block->used)
+        return -1;
+
+    int len = block->data[pos + 4];
+    memcpy(timestamp, block->data + pos, sizeof(uint32_t));
+    len = len < max ? len : max;
+    memcpy(data, block->data + pos + REC_HEADER_LEN, len);
+    return len;
+}
+
+int rec_init(void)
+{
+    memset(&rec_open, 0, sizeof(rec_open));
+    rec_read_index = -1;
+    if(osSemaphoreCreate(&rec_sem) != OS_SEMAPHORE_OK)
+    {
+        LOGE(tag, "Unable to create records store mutex");
+        return -1;
+    }
+
+    // Continue after the last stored record
+    int last = dat_get_system_var(data_map[rec_blocks].sys_index) - 1;
+    if(last >= ret_get_first(rec_blocks) && _rec_read_block(last) == 0)
+        rec_open.first = rec_read.first + rec_read.count;
+    rec_open.timestamp = dat_get_time();
+    LOGD(tag, "Next record id: %u", (unsigned int)rec_open.first);
+    return 0;
+}
+
+int rec_add(const uint8_t *data, int len, uint32_t timestamp)
+{
+    if(data == NULL || len < 1 || len > REC_MAX_LEN)
+        return -1;
+
+    osSemaphoreTake(&rec_sem, portMAX_DELAY);
+    if(rec_open.used + REC_HEADER_LEN + len > REC_BLOCK_DATA_LEN)
+        _rec_write_open();
+
+    if(rec_open.count == 0)
+        rec_open.timestamp = dat_get_time();
+    uint8_t *record = rec_open.data + rec_open.used;
+    memcpy(record, &timestamp, sizeof(timestamp));
+    record[4] = (uint8_t)len;
+    memcpy(record + REC_HEADER_LEN, data, len);
+    rec_open.used += REC_HEADER_LEN + len;
+    int id = (int)(rec_open.first + rec_open.count);
+    rec_open.count++;
+    osSemaphoreGiven(&rec_sem);
+    return id;
+}
+
+int rec_get(uint32_t id, uint8_t *data, int max, uint32_t *timestamp)
+{
+    int rc = -1;
+    osSemaphoreTake(&rec_sem, portMAX_DELAY);
+    if(id >= rec_open.first)
+    {
+        rc = _rec_find(&rec_open, id, data, max, timestamp);
+    }
+    else
+    {
+        int lo = ret_get_first(rec_blocks);
+        int hi = dat_get_system_var(data_map[rec_blocks].sys_index) - 1;
+        int found = -1;
+
+        // Sequential reads use the last read block or the next one
+        if(rec_read_index >= lo && rec_read_index <= hi && id >= rec_read.first)
+        {
+            if(id >= rec_read.first + rec_read.count && rec_read_index < hi)
+                _rec_read_block(rec_read_index + 1);
+            if(rec_read_index >= 0 && id >= rec_read.first && id < rec_read.first + rec_read.count)
+                found = rec_read_index;
+        }
+
+        // Binary search the last block starting before or at id
+        if(found < 0)
+        {
+            while(lo <= hi)
+            {
+                int mid = lo + (hi - lo) / 2;
+                if(_rec_read_block(mid) != 0)
+                    break;
+                if(rec_read.first <= id)
+                {
+                    found = mid;
+                    if(id < rec_read.first + rec_read.count)
+                        break;
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid - 1;
+                }
+            }
+        }
+        if(found >= 0 && _rec_read_block(found) == 0)
+            rc = _rec_find(&rec_read, id, data, max, timestamp);
+    }
+    osSemaphoreGiven(&rec_sem);
+    return rc;
+}
+
+uint32_t rec_get_next_id(void)
+{
+    osSemaphoreTake(&rec_sem, portMAX_DELAY);
+    uint32_t id = rec_open.first + rec_open.count;
+    osSemaphoreGiven(&rec_sem);
+    return id;
+}
+
+uint32_t rec_get_first_id(void)
+{
+    osSemaphoreTake(&rec_sem, portMAX_DELAY);
+    uint32_t id = rec_open.first;
+    int first = ret_get_first(rec_blocks);
+    if(first < dat_get_system_var(data_map[rec_blocks].sys_index) && _rec_read_block(first) == 0)
+        id = rec_read.first;
+    osSemaphoreGiven(&rec_sem);
+    return id;
+}
+
+int rec_flush(void)
+{
+    osSemaphoreTake(&rec_sem, portMAX_DELAY);
+    int rc = _rec_write_open();
+    osSemaphoreGiven(&rec_sem);
+    return rc;
+}
+
+int rec_flush_old(int max_age)
+{
+    int rc = 0;
+    osSemaphoreTake(&rec_sem, portMAX_DELAY);
+    if(rec_open.count > 0 && dat_get_time() - rec_open.timestamp >= (uint32_t)max_age)
+        rc = _rec_write_open();
+    osSemaphoreGiven(&rec_sem);
+    return rc;
+}
@@ -0,0 +1,238 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2021, Carlos Gonzalez Cortes, carlgonz@ug.uchile.cl
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "app/system/repoDataSchema.h"
+
+/*
+ * Single definition of the schema tables declared in repoDataSchema.h
+ */
+
+static char temp_var_string[] = "sat_index timestamp obc_temp_1 obc_temp_2 obc_temp_3 eps_temp1 eps_temp2 eps_temp3 "
+                                  "eps_temp4 bat_temp1 bat_temp2 istage_temp1 istage_temp2 istage_temp3 istage_temp4 "
+                                  "spanel_temp1 spanel_temp2 spanel_temp3 spanel_temp4 dummy";
+
+static char temp_var_types[] = "%u %u %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h";
+
+static char status_var_string[] = "sat_index timestamp dat_obc_opmode rtc_date_time obc_last_reset obc_hrs_alive "
+                                  "obc_hrs_wo_reset obc_reset_counter obc_executed_cmds obc_failed_cmds com_count_tm "
+                                  "com_count_tc com_last_tc fpl_last fpl_queue ads_tle_epoch eps_vbatt eps_cur_sun "
+                                  "eps_cur_sys obc_temp_1 eps_temp_bat0 drp_mach_action drp_mach_state drp_mach_payloads "
+                                  "drp_mach_step";
+
+static char status_var_types[] = "%u %u %u %d %u %u %u %u %u %u %u %u %d %d %u %d %d %u %u %f %d %u %u %u %u";
+
+const dat_sys_var_t dat_status_list[] = {
+        {dat_rtc_date_time,     "rtc_date_time",     'd', DAT_IS_CONFIG, 0},          ///< RTC current unix time
+        {dat_obc_last_reset,    "obc_last_reset",    'u', DAT_IS_STATUS, 0},          ///< Last reset source
+        {dat_obc_opmode,        "obc_opmode",        'd', DAT_IS_CONFIG, DAT_OBC_OPMODE_NORMAL}, ///< General operation mode
+        {dat_obc_hrs_alive,     "obc_hrs_alive",     'u', DAT_IS_STATUS, 0},          ///< Hours since first boot
+        {dat_obc_hrs_wo_reset,  "obc_hrs_wo_reset",  'u', DAT_IS_STATUS, 0},          ///< Hours since last reset
+        {dat_obc_reset_counter, "obc_reset_counter", 'u', DAT_IS_STATUS, 0},          ///< Number of reset since first boot
+        {dat_obc_sw_wdt,        "obc_sw_wdt",        'u', DAT_IS_STATUS, 0},          ///< Software watchdog timer counter
+        {dat_obc_temp_1,        "obc_temp_1",        'f', DAT_IS_STATUS, -1},         ///< Temperature value of the first sensor
+        {dat_obc_executed_cmds, "obc_executed_cmds", 'u', DAT_IS_STATUS, 0},          ///< Execute commands counter
+        {dat_obc_failed_cmds,   "obc_failed_cmds",   'u', DAT_IS_STATUS, 0},          ///< Commands execute with errors counter
+        {dat_dep_deployed,      "dep_deployed",      'u', DAT_IS_STATUS, 0},          ///< Was the satellite deployed?
+        {dat_dep_ant_deployed,  "dep_ant_deployed",  'u', DAT_IS_STATUS, 1},          ///< Was the antenna deployed?
+        {dat_dep_date_time,     "dep_date_time",     'u', DAT_IS_STATUS, 0},          ///< Antenna deployment unix time
+        {dat_com_count_tm,      "com_count_tm",      'u', DAT_IS_STATUS, 0},          ///< Number of Telemetries sent
+        {dat_com_count_tc,      "com_count_tc",      'u', DAT_IS_STATUS, 0},          ///< Number of received Telecommands
+        {dat_com_last_tc,       "com_last_tc",       'd', DAT_IS_STATUS, 0},          ///< Unix time of the last received Telecommand
+        {dat_com_freq,          "com_freq",          'u', DAT_IS_CONFIG, SCH_TX_FREQ},       ///< Communications frequency [Hz]
+        {dat_com_tx_pwr,        "com_tx_pwr",        'u', DAT_IS_CONFIG, SCH_TX_PWR},        ///< TX power (0: 25dBm, 1: 27dBm, 2: 28dBm, 3: 30dBm)
+        {dat_com_baud,          "com_baud",          'u', DAT_IS_CONFIG, SCH_TX_BAUD},       ///< Baudrate [bps]
+        {dat_com_mode,          "com_mode",          'u', DAT_IS_CONFIG, 0},          ///< Framing mode (1: RAW, 2: ASM, 3: HDLC, 4: Viterbi, 5: GOLAY, 6: AX25)
+        {dat_com_bcn_period,    "com_bcn_period",    'u', DAT_IS_CONFIG, SCH_TX_BCN_PERIOD},  ///< Number of seconds between trx beacon packets
+        {dat_obc_bcn_offset,    "obc_bcn_offset",    'u', DAT_IS_CONFIG, SCH_OBC_BCN_OFFSET}, ///< Number of seconds between obc beacon packets
+        {dat_fpl_last,          "fpl_last",          'd', DAT_IS_STATUS, 0},          ///< Last executed flight plan (unix time)
+        {dat_fpl_queue,         "fpl_queue",         'u', DAT_IS_STATUS, 0},          ///< Flight plan queue length
+        {dat_ads_omega_x,       "ads_omega_x",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the x axis
+        {dat_ads_omega_y,       "ads_omega_y",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the y axis
+        {dat_ads_omega_z,       "ads_omega_z",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the z axis
+        {dat_ads_bias_x,       "ads_bias_x",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope bias value along the x axis
+        {dat_ads_bias_y,       "ads_bias_y",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope bias value along the y axis
+        {dat_ads_bias_z,       "ads_bias_z",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope bias value along the z axis
+        {dat_ads_mag_x,         "ads_mag_x",         'f', DAT_IS_STATUS, 0.0},         ///< Magnetometer value along the x axis
+        {dat_ads_mag_y,         "ads_mag_y",         'f', DAT_IS_STATUS, 0.0},         ///< Magnetometer value along the y axis
+        {dat_ads_mag_z,         "ads_mag_z",         'f', DAT_IS_STATUS, 0.0},         ///< Magnetometer value along the z axis
+        {dat_ads_pos_x,         "ads_pos_x",         'f', DAT_IS_STATUS, 0.0},         ///< Satellite orbit position x (ECI)
+        {dat_ads_pos_y,         "ads_pos_y",         'f', DAT_IS_STATUS, 0.0},         ///< Satellite orbit position y (ECI)
+        {dat_ads_pos_z,         "ads_pos_z",         'f', DAT_IS_STATUS, 0.0},         ///< Satellite orbit position z (ECI)
+        {dat_ads_vel_x,         "ads_pos_x",         'f', DAT_IS_STATUS, 0.0},         ///< Satellite orbit Velocity x (ECI)
+        {dat_ads_vel_y,         "ads_pos_y",         'f', DAT_IS_STATUS, 0.0},         ///< Satellite orbit Velocity y (ECI)
+        {dat_ads_vel_z,         "ads_pos_z",         'f', DAT_IS_STATUS, 0.0},         ///< Satellite orbit Velocity z (ECI)
+        {dat_ads_tle_epoch,     "ads_tle_epoch",     'd', DAT_IS_STATUS, 0},          ///< Current TLE epoch, 0 if TLE is invalid
+        {dat_ads_tle_last,      "ads_tle_last",      'u', DAT_IS_STATUS, 0},          ///< Last time position was propagated
+        {dat_ads_q0,            "ads_q0",            'f', DAT_IS_STATUS, 0.0},          ///< Attitude quaternion (Inertial to body)
+        {dat_ads_q1,            "ads_q1",            'f', DAT_IS_STATUS, 0.0},          ///< Attitude quaternion (Inertial to body)
+        {dat_ads_q2,            "ads_q2",            'f', DAT_IS_STATUS, 0.0},          ///< Attitude quaternion (Inertial to body)
+        {dat_ads_q3,            "ads_q3",            'f', DAT_IS_STATUS, 1.0},          ///< Attitude quaternion (Inertial to body)
+        {dat_tgt_omega_x,       "tgt_omega_x",       'f', DAT_IS_CONFIG, 0.0},          ///< Target acceleration value along the x axis
+        {dat_tgt_omega_y,       "tgt_omega_y",       'f', DAT_IS_CONFIG, 0.0},          ///< Target acceleration value along the y axis
+        {dat_tgt_omega_z,       "tgt_omega_z",       'f', DAT_IS_CONFIG, 0.0},          ///< Target acceleration value along the z axis
+        {dat_tgt_q0,            "tgt_q0",            'f', DAT_IS_CONFIG, 0.0},          ///< Target quaternion (Inertial to body)
+        {dat_tgt_q1,            "tgt_q1",            'f', DAT_IS_CONFIG, 0.0},          ///< Target quaternion (Inertial to body)
+        {dat_tgt_q2,            "tgt_q2",            'f', DAT_IS_CONFIG, 0.0},          ///< Target quaternion (Inertial to body)
+        {dat_tgt_q3,            "tgt_q3",            'f', DAT_IS_CONFIG, 1.0},          ///< Target quaternion (Inertial to body)
+        {dat_eps_vbatt,       "eps_vbatt",       'u', DAT_IS_STATUS, 0},          ///< Voltage of the battery [mV]
+        {dat_eps_cur_sun,     "eps_cur_sun",     'u', DAT_IS_STATUS, 0},          ///< Current from boost converters [mA]
+        {dat_eps_cur_sys,     "eps_cur_sys",     'u', DAT_IS_STATUS, 0},          ///< Current from the battery [mA]
+        {dat_eps_temp_bat0,   "eps_temp_bat0",   'd', DAT_IS_STATUS, 0},          ///< Battery temperature sensor
+        {dat_drp_idx_temp,    "drp_idx_temp",    'u', DAT_IS_STATUS, 0},          ///< Temperature data index
+        {dat_drp_idx_ads,     "drp_idx_ads",     'u', DAT_IS_STATUS, 0},          ///< ADS data index
+        {dat_drp_idx_eps,     "drp_idx_eps",     'u', DAT_IS_STATUS, 0},          ///< EPS data index
+        {dat_drp_idx_sta,     "drp_idx_sta",     'u', DAT_IS_STATUS, 0},          ///< Status data index
+        {dat_drp_idx_stt,       "drp_idx_stt",       'u', DAT_IS_STATUS, 0},          ///< STT data index
+        {dat_drp_idx_rw,        "drp_idx_rw",        'u', DAT_IS_STATUS, 0},          ///< RW data index
+        {dat_drp_idx_fss,       "drp_idx_fss",       'u', DAT_IS_STATUS, 0},          ///< ADS fss data index
+        {dat_drp_idx_ekf,       "drp_idx_ekf",       'u', DAT_IS_STATUS, 0},          ///< ADS ekf data index
+        {dat_drp_idx_ctrl, "drp_idx_ctrl", 'u', DAT_IS_STATUS, 0},
+        {dat_drp_ack_temp,      "drp_ack_temp",      'u', DAT_IS_CONFIG, 0},          ///< Temperature data acknowledge
+        {dat_drp_ack_ads,       "drp_ack_ads",       'u', DAT_IS_CONFIG, 0},          ///< ADS data index acknowledge
+        {dat_drp_ack_eps,       "drp_ack_eps",       'u', DAT_IS_CONFIG, 0},          ///< EPS data index acknowledge
+        {dat_drp_ack_sta,       "drp_ack_sta",       'u', DAT_IS_CONFIG, 0},          ///< Status data index acknowledge
+        {dat_drp_ack_stt,       "drp_ack_stt",       'u', DAT_IS_CONFIG, 0},          ///< Stt data index acknowledge
+        {dat_drp_ack_rw,        "drp_ack_rw",        'u', DAT_IS_CONFIG, 0},          ///< RW data acknowledge
+        {dat_drp_ack_fss,       "drp_ack_fss",   'u', DAT_IS_CONFIG, 0},          ///< ADS FSS data index acknowledge
+        {dat_drp_ack_ekf,       "drp_ack_ekf",   'u', DAT_IS_CONFIG, 0},          ///< ADS EKF data index acknowledge
+        {dat_drp_ack_ctrl, "drp_ack_ctrl", 'u', DAT_IS_CONFIG, 0},
+        {dat_drp_mach_action,   "drp_mach_action",   'u', DAT_IS_STATUS, 0},          ///<
+        {dat_drp_mach_state,    "drp_mach_state",    'u', DAT_IS_STATUS, 0},          ///<
+        {dat_drp_mach_left,     "drp_mach_left",     'u', DAT_IS_STATUS, 0},          ///<
+        {dat_drp_mach_step,     "drp_mach_step",     'd', DAT_IS_CONFIG, 0},          ///<
+        {dat_drp_mach_payloads, "drp_mach_payloads", 'u', DAT_IS_CONFIG, 0},           ///<
+        {dat_drp_idx_str,       "drp_idx_str",       'u', DAT_IS_STATUS, 0},          ///< String data index
+        {dat_drp_ack_str,       "drp_ack_str",       'u', DAT_IS_CONFIG, 0},          ///< String data acknowledge
+        {dat_drp_idx_agg,       "drp_idx_agg",       'u', DAT_IS_STATUS, 0},          ///< Aggregated data index
+        {dat_drp_ack_agg,       "drp_ack_agg",       'u', DAT_IS_CONFIG, 0},          ///< Aggregated data acknowledge
+        {dat_drp_idx_rec,       "drp_idx_rec",       'u', DAT_IS_STATUS, 0},          ///< Records blocks index
+        {dat_drp_ack_rec,       "drp_ack_rec",       'u', DAT_IS_CONFIG, 0},          ///< Records blocks acknowledge
+        {dat_drp_idx_evt,       "drp_idx_evt",       'u', DAT_IS_STATUS, 0},          ///< Events data index
+        {dat_drp_ack_evt,       "drp_ack_evt",       'u', DAT_IS_CONFIG, 0},          ///< Events data acknowledge
+        {dat_drp_idx_tim,       "drp_idx_tim",       'u', DAT_IS_STATUS, 0},          ///< ADCS timing data index
+        {dat_drp_ack_tim,       "drp_ack_tim",       'u', DAT_IS_CONFIG, 0},          ///< ADCS timing data acknowledge
+        {dat_calc_attitude,     "calc_attitude",     'd', DAT_IS_STATUS, 0},
+        {dat_activate_ekf, "activate_ekf", 'u', DAT_IS_STATUS, 0},
+        {dat_activate_ctrl, "activate_ctrl", 'u', DAT_IS_STATUS, 0},
+        {dat_time_to_attitude,  "time_to_attitude",  'u', DAT_IS_STATUS, 10},
+        {dat_inertia_xx,        "inertia_xx",        'f', DAT_IS_STATUS, 0.0},
+        {dat_inertia_yy,        "inertia_yy",        'f', DAT_IS_STATUS, 0.0},
+        {dat_inertia_zz,        "inertia_zz",        'f', DAT_IS_STATUS, 0.0},
+        {dat_inertia_xy,        "inertia_xy",        'f', DAT_IS_STATUS, 0.0},
+        {dat_inertia_xz,        "inertia_xz",        'f', DAT_IS_STATUS, 0.0},
+        {dat_inertia_yz,        "inertia_yz",        'f', DAT_IS_STATUS, 0.0},
+        {dat_inv_inertia_xx,        "inertia_xx",        'f', DAT_IS_STATUS, 0.0},
+        {dat_inv_inertia_yy,        "inertia_yy",        'f', DAT_IS_STATUS, 0.0},
+        {dat_inv_inertia_zz,        "inertia_zz",        'f', DAT_IS_STATUS, 0.0},
+        {dat_inv_inertia_xy,        "inertia_xy",        'f', DAT_IS_STATUS, 0.0},
+        {dat_inv_inertia_xz,        "inertia_xz",        'f', DAT_IS_STATUS, 0.0},
+        {dat_inv_inertia_yz,        "inertia_yz",        'f', DAT_IS_STATUS, 0.0},
+        {dat_inertia_rw,            "inertia_rw", 'f', DAT_IS_STATUS, 0.0},
+        {dat_ads_ekf_q0,            "ads_ekf_q0",            'f', DAT_IS_STATUS, 0.0},          ///< Attitude quaternion (Inertial to body)
+        {dat_ads_ekf_q1,            "ads_ekf_q1",            'f', DAT_IS_STATUS, 0.0},          ///< Attitude quaternion (Inertial to body)
+        {dat_ads_ekf_q2,            "ads_ekf_q2",            'f', DAT_IS_STATUS, 0.0},          ///< Attitude quaternion (Inertial to body)
+        {dat_ads_ekf_q3,            "ads_ekf_q3",            'f', DAT_IS_STATUS, 1.0},          ///< Attitude quaternion (Inertial to body)
+        {dat_ads_ekf_omega_x,       "ads_ekf_omega_x",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the x axis
+        {dat_ads_ekf_omega_y,       "ads_ekf_omega_y",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the y axis
+        {dat_ads_ekf_omega_z,       "ads_ekf_omega_z",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the z axis
+        {dat_ads_ekf_bias_x,       "ads_ekf_bias_x",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the x axis
+        {dat_ads_ekf_bias_y,       "ads_ekf_bias_y",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the y axis
+        {dat_ads_ekf_bias_z,       "ads_ekf_bias_z",       'f', DAT_IS_STATUS, 0.0},         ///< Gyroscope acceleration value along the z axis
+        //{dat_css_1,             "css_1",             'u', DAT_IS_STATUS, 0},                     ///< Coarse sun sensor value
+        {dat_css_2,             "css_2",             'u', DAT_IS_STATUS, 0},                       ///< Coarse sun sensor value
+        {dat_css_3,             "css_3",             'u', DAT_IS_STATUS, 0},                       ///< Coarse sun sensor value
+        {dat_css_4,             "css_4",             'u', DAT_IS_STATUS, 0},                       ///< Coarse sun sensor value
+        //{dat_css_5,             "css_5",             'u', DAT_IS_STATUS, 0},                       ///< Coarse sun sensor value
+        {dat_sun_vec_b_x,       "sun_vec_b_x",       'f', DAT_IS_STATUS, 0.0},                       ///< Coarse sun sensor value
+        {dat_sun_vec_b_y,       "sun_vec_b_y",       'f', DAT_IS_STATUS, 0.0},                       ///< Coarse sun sensor value
+        {dat_sun_vec_b_z,       "sun_vec_b_z",       'f', DAT_IS_STATUS, 0.0},                   ///< Coarse sun sensor value
+        {dat_time_delay_gyro, "ads_time_delay_gyro", 'u', DAT_IS_STATUS, 100},
+        {dat_time_delay_quat, "ads_time_delay_quat", 'u', DAT_IS_STATUS, 3000},
+        {dat_mtq_x_axis, "mtq_x_axis", 'f', DAT_IS_STATUS, 0.0},
+        {dat_mtq_y_axis, "mtq_y_axis", 'f', DAT_IS_STATUS, 0.0},
+        {dat_mtq_z_axis, "mtq_z_axis", 'f', DAT_IS_STATUS, 0.0},
+        {dat_ads_ekf_s_near_sing, "ads_ekf_s_near_sing", 'u', DAT_IS_STATUS, 0},         ///< EKF steps with a near singular innovation covariance
+        {dat_ads_ekf_s_not_pd,    "ads_ekf_s_not_pd",    'u', DAT_IS_STATUS, 0}          ///< EKF steps skipped, innovation covariance not positive definite
+};
+
+data_map_t data_map[last_sensor] = {
+        {"dat_temp_data",    (uint16_t) (sizeof(temp_data_t)),    dat_drp_idx_temp, dat_drp_ack_temp, temp_var_types,                     temp_var_string},
+        {"dat_ads_data",     (uint16_t) (sizeof(ads_data_t)),     dat_drp_idx_ads,  dat_drp_ack_ads,  "%u %u %f %f %f %f %f %f %d %d %d", "sat_index timestamp acc_x acc_y acc_z mag_x mag_y mag_z sun2 sun3 sun4"},
+        {"dat_eps_data",     (uint16_t) (sizeof(eps_data_t)),     dat_drp_idx_eps,  dat_drp_ack_eps,  "%u %u %u %u %u %d %d",             "sat_index timestamp cursun cursys vbatt temp_eps temp_bat"},
+        {"dat_sta_data",     (uint16_t) (sizeof(status_data_t)),  dat_drp_idx_sta,  dat_drp_ack_sta,  status_var_types,                   status_var_string},
+        {"dat_stt_data",     (uint16_t) (sizeof(stt_data_t)),     dat_drp_idx_stt,  dat_drp_ack_stt,  "%u %u %f %f %f %d %f",             "sat_index timestamp ra dec roll time exec_time"},
+        {"dat_rw_data",      (uint16_t) (sizeof(temp_data_t)),    dat_drp_idx_rw,   dat_drp_ack_rw,   "%u %u %f %f %f %d %d %d",          "sat_index timestamp current1 current2 current3 speed1 speed2 speed3"},
+        {"dat_fss_data", (uint16_t) (sizeof(fss_data_t)), dat_drp_idx_fss, dat_drp_ack_fss,
+         "%u %u %f %f %f %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h %h",
+         "sat_index timestamp acc_x acc_y acc_z fss1_a fss1_b fss1_c fss1_d fss2_a fss2_b fss2_c fss2_d fss3_a fss3_b fss3_c fss3_d fss4_a fss4_b fss4_c fss4_d fss5_a fss5_b fss5_c fss5_d"},
+        {"dat_ekf_data",     (uint16_t) (sizeof(ekf_data_t)),     dat_drp_idx_ekf,  dat_drp_ack_ekf,
+         "%u %u %f %f %f %f %f %f %f %f %f %f",
+         "sat_index timestamp gyro_x gyro_y gyro_z mag_x mag_y mag_z q0 q1 q2 q3"},
+        {"dat_ctrl_data", (uint16_t) (sizeof(ctrl_data_t)), dat_drp_idx_ctrl, dat_drp_ack_ctrl, "%u %u %f %f %f %f %f %f",
+         "sat_index timestamp ctrl_x ctrl_y ctrl_z ctrl_hw_x, ctrl_hw_y, ctrl_hw_z"},
+         {"dat_msg_data",      (uint16_t) (sizeof(string_data_t)), dat_drp_idx_str,  dat_drp_ack_str,  "%u %u %s",                         "sat_index timestamp string_data"},
+        {"dat_agg_data",     (uint16_t) (sizeof(agg_data_t)),     dat_drp_idx_agg,  dat_drp_ack_agg,  "%u %u %u %u %u %u %f %f %f %f",
+         "sat_index timestamp payload field window count min max mean stddev"},
+        {"dat_rec_data",     (uint16_t) (sizeof(rec_block_t)),    dat_drp_idx_rec,  dat_drp_ack_rec,  REC_BLOCK_DATA_ORDER,
+         REC_BLOCK_VAR_NAMES},
+        {"dat_evt_data",     (uint16_t) (sizeof(evt_data_t)),     dat_drp_idx_evt,  dat_drp_ack_evt,  "%u %u %u %u %u %f %f",
+         "sat_index timestamp payload field type value ref"},
+        {"dat_tim_data",     (uint16_t) (sizeof(tim_data_t)),     dat_drp_idx_tim,  dat_drp_ack_tim,  "%u %u %u %u %u %u %u %u",
+         "sat_index timestamp stage count min max mean p99"}
+};
+
+const int dat_status_last_var = sizeof(dat_status_list) / sizeof(dat_status_list[0]);
+
+const uint32_t dat_schema_layout_hash = DAT_SCHEMA_LAYOUT_HASH;
+
+/*
+ * Build time checks, a negative array size fails the compilation:
+ * the status list does not have more variables than the status enum, and all
+ * the flight payloads are hashed in DAT_SCHEMA_LAYOUT_HASH.
+ */
+typedef char dat_schema_check_status[sizeof(dat_status_list) / sizeof(dat_status_list[0]) <= dat_status_last_address ? 1 : -1];
+typedef char dat_schema_check_layout[DAT_SCHEMA_NPAYLOADS == DAT_SCHEMA_LAYOUT_NSIZES ? 1 : -1];
+
+static uint32_t dat_schema_hash_bytes(uint32_t hash, const uint8_t *buff, int len)
+{
+    int i;
+    for(i = 0; i < len; i++)
+        hash = DAT_SCHEMA_HASH_ADD(hash, buff[i]);
+    return hash;
+}
+
+uint32_t dat_schema_hash(int first, int n)
+{
+    if(first < 0 || n <= 0 || first + n > last_sensor)
+        return 0;
+
+    int i;
+    uint32_t hash = DAT_SCHEMA_HASH_ADD(DAT_SCHEMA_HASH_INIT, n);
+    for(i = first; i < first + n; i++)
+    {
+        uint8_t size[2] = {(uint8_t)(data_map[i].size >> 8), (uint8_t)data_map[i].size};
+        hash = dat_schema_hash_bytes(hash, size, sizeof(size));
+        // Include the terminator to separate the fields strings
+        hash = dat_schema_hash_bytes(hash, (const uint8_t *)data_map[i].data_order, (int)strlen(data_map[i].data_order) + 1);
+    }
+    return hash;
+}
@@ -0,0 +1,239 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/sampleBuffer.h"
+
+#if SBUF_PAGED
+static const char *tag = "sampleBuff";
+
+/**
+ * A payload table page in RAM
+ */
+typedef struct sbuf_page {
+    int32_t page;                   ///< Page number, -1 if not valid
+    uint8_t dirty;                  ///< The page has unwritten samples
+    uint32_t timestamp;             ///< Time of the oldest unwritten sample
+    uint8_t data[SCH_ST_BUFF_SIZE];
+} sbuf_page_t;
+
+static osSemaphore sbuf_sem;
+static sbuf_page_t sbuf_open[last_sensor];  ///< Page receiving new samples, per payload
+static sbuf_page_t sbuf_read;               ///< Last page read from the storage
+static int sbuf_read_payload = -1;          ///< Payload of sbuf_read
+
+/**
+ * Samples per page of a payload, 0 or 1 if the payload is not paged
+ */
+static inline int sbuf_per_page(int payload)
+{
+    return SCH_ST_BUFF_SIZE / data_map[payload].size;
+}
+
+/**
+ * Payload data map with the page size, to store a page as one sample
+ */
+static inline data_map_t sbuf_page_map(int payload)
+{
+    data_map_t map = data_map[payload];
+    map.size = SCH_ST_BUFF_SIZE;
+    return map;
+}
+
+/**
+ * Write a payload open page. Requires sbuf_sem to be taken.
+ */
+static int _sbuf_write(int payload)
+{
+    sbuf_page_t *open = &sbuf_open[payload];
+    if(!open->dirty)
+        return 0;
+
+    data_map_t map = sbuf_page_map(payload);
+    if(storage_payload_set_data(payload, open->page, open->data, &map) != 0)
+    {
+        LOGE(tag, "Error writing payload %d page %d", payload, (int)open->page);
+        return -1;
+    }
+    open->dirty = 0;
+
+    // The stored page changed
+    if(sbuf_read_payload == payload && sbuf_read.page == open->page)
+        sbuf_read_payload = -1;
+    return 1;
+}
+
+/**
+ * Make page the payload open page, writing the previous one. Samples already
+ * stored in the page are loaded first. Requires sbuf_sem to be taken.
+ */
+static int _sbuf_open(int payload, int page, int loaded)
+{
+    sbuf_page_t *open = &sbuf_open[payload];
+    if(open->page == page)
+        return 0;
+    if(_sbuf_write(payload) < 0)
+        return -1;
+
+    memset(open->data, 0xFF, sizeof(open->data));
+    if(loaded)
+    {
+        data_map_t map = sbuf_page_map(payload);
+        if(storage_payload_get_data(payload, page, open->data, &map) != 0)
+        {
+            open->page = -1;
+            return -1;
+        }
+    }
+    open->page = page;
+    open->dirty = 0;
+    return 0;
+}
+#endif
+
+int sbuf_init(void)
+{
+#if SBUF_PAGED
+    int p;
+    for(p = 0; p < last_sensor; p++)
+    {
+        sbuf_open[p].page = -1;
+        sbuf_open[p].dirty = 0;
+    }
+    sbuf_read_payload = -1;
+    if(osSemaphoreCreate(&sbuf_sem) != OS_SEMAPHORE_OK)
+    {
+        LOGE(tag, "Unable to create sample buffer mutex");
+        return -1;
+    }
+#endif
+    return 0;
+}
+
+int sbuf_get_capacity(int payload)
+{
+    if(payload < 0 || payload >= last_sensor)
+        return -1;
+#if SBUF_PAGED
+    int per_page = sbuf_per_page(payload);
+    if(per_page > 1)
+        return (SCH_SIZE_PER_SECTION / SCH_ST_BUFF_SIZE) * SCH_SECTIONS_PER_PAYLOAD * per_page;
+#endif
+#if SBUF_BOUNDED
+    return (int)(((uint32_t)SCH_SIZE_PER_SECTION * SCH_SECTIONS_PER_PAYLOAD) / data_map[payload].size);
+#else
+    return 0;
+#endif
+}
+
+int sbuf_set_sample(int payload, int slot, void *data)
+{
+    if(payload < 0 || payload >= last_sensor || slot < 0)
+        return -1;
+#if SBUF_PAGED
+    int per_page = sbuf_per_page(payload);
+    if(per_page > 1)
+    {
+        int rc = -1;
+        int size = data_map[payload].size;
+        osSemaphoreTake(&sbuf_sem, portMAX_DELAY);
+        // A page not started at its first slot already has stored samples
+        if(_sbuf_open(payload, slot / per_page, slot % per_page != 0) == 0)
+        {
+            sbuf_page_t *open = &sbuf_open[payload];
+            memcpy(open->data + (slot % per_page) * size, data, size);
+            if(!open->dirty)
+                open->timestamp = (uint32_t)dat_get_time();
+            open->dirty = 1;
+            rc = 0;
+            if(slot % per_page == per_page - 1)
+                rc = _sbuf_write(payload) < 0 ? -1 : 0;
+        }
+        osSemaphoreGiven(&sbuf_sem);
+        return rc;
+    }
+#endif
+    return storage_payload_set_data(payload, slot, data, &data_map[payload]) == 0 ? 0 : -1;
+}
+
+int sbuf_get_sample(int payload, int slot, void *data)
+{
+    if(payload < 0 || payload >= last_sensor || slot < 0)
+        return -1;
+#if SBUF_PAGED
+    int per_page = sbuf_per_page(payload);
+    if(per_page > 1)
+    {
+        int rc = 0;
+        int size = data_map[payload].size;
+        int page = slot / per_page;
+        osSemaphoreTake(&sbuf_sem, portMAX_DELAY);
+        uint8_t *src;
+        if(sbuf_open[payload].page == page)
+        {
+            src = sbuf_open[payload].data;
+        }
+        else
+        {
+            if(sbuf_read_payload != payload || sbuf_read.page != page)
+            {
+                data_map_t map = sbuf_page_map(payload);
+                sbuf_read_payload = -1;
+                rc = storage_payload_get_data(payload, page, sbuf_read.data, &map) == 0 ? 0 : -1;
+                if(rc == 0)
+                {
+                    sbuf_read_payload = payload;
+                    sbuf_read.page = page;
+                }
+            }
+            src = sbuf_read.data;
+        }
+        if(rc == 0)
+            memcpy(data, src + (slot % per_page) * size, size);
+        osSemaphoreGiven(&sbuf_sem);
+        return rc;
+    }
+#endif
+    return storage_payload_get_data(payload, slot, data, &data_map[payload]) == 0 ? 0 : -1;
+}
+
+int sbuf_flush_old(int max_age)
+{
+    int written = 0;
+#if SBUF_PAGED
+    int p;
+    uint32_t now = (uint32_t)dat_get_time();
+    osSemaphoreTake(&sbuf_sem, portMAX_DELAY);
+    for(p = 0; p < last_sensor; p++)
+    {
+        if(!sbuf_open[p].dirty || now - sbuf_open[p].timestamp < (uint32_t)max_age)
+            continue;
+        if(_sbuf_write(p) < 0)
+            written = -1;
+        else if(written >= 0)
+            written++;
+    }
+    osSemaphoreGiven(&sbuf_sem);
+#endif
+    return written;
+}
+
+int sbuf_flush(void)
+{
+    return sbuf_flush_old(0);
+}
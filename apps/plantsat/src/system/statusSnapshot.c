@@ -0,0 +1,350 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/statusSnapshot.h"
+
+static const char *tag = "stsSnapshot";
+
+/**
+ * Status variables that can be cached. High rate status variables only
+ * written by this app, whose last value can be recovered after a reset
+ * without issues. At most 32 variables.
+ */
+static const dat_status_address_t sts_write_back_list[] = {
+        dat_obc_temp_1,
+        dat_eps_vbatt,
+        dat_eps_cur_sun,
+        dat_eps_cur_sys,
+        dat_eps_temp_bat0,
+        dat_drp_mach_action,
+        dat_drp_mach_state,
+        dat_drp_mach_left,
+        dat_ads_tle_last,
+};
+
+#define STS_NWRITE_BACK ((int)(sizeof(sts_write_back_list)/sizeof(sts_write_back_list[0])))
+#define STS_IMAGE_MAGIC 0x53545331u ///< "STS1"
+
+/**
+ * Cache image, the cached values and their dirty flags. Two images are kept
+ * and each change is written to the inactive one, so a reset in the middle
+ * of a change leaves the other image valid.
+ */
+typedef struct sts_image {
+    uint32_t magic;                 ///< STS_IMAGE_MAGIC
+    uint32_t seq;                   ///< Incremented on each change, the newest valid image is used
+    uint32_t dirty;                 ///< Slots not written to the storage yet
+    value32_t value[STS_NWRITE_BACK];
+    uint32_t hash;                  ///< Hash of the previous fields
+} sts_image_t;
+
+static osSemaphore sts_sem;         ///< Protects the images and the enabled slots
+static osSemaphore sts_flush_sem;   ///< Serializes flushes
+static sts_image_t sts_images[2] STS_RETAINED;
+static int sts_active = 0;          ///< Current image
+static uint32_t sts_enabled = 0;    ///< Slots served from the cache
+static int8_t sts_slot[dat_status_last_address];   ///< Slot of each variable, -1 if it can not be cached
+static int sts_flush_req = 0;       ///< A critical variable was written
+static uint32_t sts_nflush = 0;     ///< Number of variables written by flushes
+static uint32_t sts_nwrites = 0;    ///< Number of writes to write-back variables
+
+static uint32_t _sts_hash(sts_image_t *image)
+{
+    const uint8_t *buff = (const uint8_t *)image;
+    uint32_t hash = DAT_SCHEMA_HASH_INIT;
+    int i;
+    for(i = 0; i < (int)offsetof(sts_image_t, hash); i++)
+        hash = DAT_SCHEMA_HASH_ADD(hash, buff[i]);
+    return hash;
+}
+
+static int _sts_valid(sts_image_t *image)
+{
+    return image->magic == STS_IMAGE_MAGIC && image->hash == _sts_hash(image);
+}
+
+/**
+ * Change a slot value and dirty flag in the inactive image and make it the
+ * current one. Call with sts_sem taken.
+ */
+static void _sts_commit(int slot, value32_t value, int dirty)
+{
+    sts_image_t *next = &sts_images[!sts_active];
+    memcpy(next, &sts_images[sts_active], sizeof(sts_image_t));
+    next->value[slot] = value;
+    if(dirty)
+        next->dirty |= 1UL << slot;
+    else
+        next->dirty &= ~(1UL << slot);
+    next->seq++;
+    next->hash = _sts_hash(next);
+    sts_active = !sts_active;
+}
+
+/**
+ * Read a variable from the cache. Call with sts_sem taken.
+ * @return 1 if the variable is served from the cache, 0 otherwise
+ */
+static int _sts_get_cached(dat_status_address_t address, value32_t *value)
+{
+    int slot = sts_slot[address];
+    if(slot < 0 || !(sts_enabled & (1UL << slot)))
+        return 0;
+    *value = sts_images[sts_active].value[slot];
+    return 1;
+}
+
+int sts_init(void)
+{
+    int i;
+    if(osSemaphoreCreate(&sts_sem) != OS_SEMAPHORE_OK || osSemaphoreCreate(&sts_flush_sem) != OS_SEMAPHORE_OK)
+    {
+        LOGE(tag, "Unable to create status snapshot mutex");
+        return -1;
+    }
+
+    memset(sts_slot, -1, sizeof(sts_slot));
+    for(i = 0; i < STS_NWRITE_BACK; i++)
+        sts_slot[sts_write_back_list[i]] = (int8_t)i;
+
+    // Recover the values not written before the last reset from the newest
+    // valid image, the clean values are read from the storage.
+    int valid0 = _sts_valid(&sts_images[0]);
+    int valid1 = _sts_valid(&sts_images[1]);
+    sts_active = valid1 && (!valid0 || sts_images[1].seq - sts_images[0].seq < 0x80000000u) ? 1 : 0;
+    sts_image_t *image = &sts_images[sts_active];
+    if(!valid0 && !valid1)
+    {
+        memset(image, 0, sizeof(sts_image_t));
+        image->magic = STS_IMAGE_MAGIC;
+    }
+    int ndirty = 0;
+    for(i = 0; i < STS_NWRITE_BACK; i++)
+    {
+        if(image->dirty & (1UL << i))
+            ndirty++;
+        else
+            image->value[i] = dat_get_status_var(sts_write_back_list[i]);
+    }
+    image->hash = _sts_hash(image);
+    if(ndirty > 0)
+        LOGI(tag, "Recovered %d cached status variables", ndirty);
+
+    sts_enabled = 0;
+#if SCH_STS_FLUSH_PERIOD > 0
+    sts_enabled = (uint32_t)((1ULL << STS_NWRITE_BACK) - 1);
+#endif
+    // Recovered values are served from the cache until they are written
+    sts_enabled |= image->dirty;
+    return 0;
+}
+
+int sts_set_status_var(dat_status_address_t address, value32_t value)
+{
+    if(address >= dat_status_last_address)
+        return -1;
+
+    osSemaphoreTake(&sts_sem, portMAX_DELAY);
+    int slot = sts_slot[address];
+    if(slot >= 0 && (sts_enabled & (1UL << slot)))
+    {
+        if(sts_images[sts_active].value[slot].u != value.u)
+            _sts_commit(slot, value, 1);
+        sts_nwrites++;
+        osSemaphoreGiven(&sts_sem);
+        return 0;
+    }
+
+    // A write-through variable is critical, so the pending cached values are
+    // written in the next housekeeping cycle.
+    sts_flush_req = 1;
+    osSemaphoreGiven(&sts_sem);
+    return dat_set_status_var(address, value);
+}
+
+int sts_set_system_var(dat_status_address_t address, int value)
+{
+    value32_t v;
+    v.i = value;
+    return sts_set_status_var(address, v);
+}
+
+value32_t sts_get_status_var(dat_status_address_t address)
+{
+    value32_t value;
+    value.u = 0;
+    if(address >= dat_status_last_address)
+        return value;
+
+    osSemaphoreTake(&sts_sem, portMAX_DELAY);
+    int cached = _sts_get_cached(address, &value);
+    osSemaphoreGiven(&sts_sem);
+    if(!cached)
+        value = dat_get_status_var(address);
+    return value;
+}
+
+int sts_get_system_var(dat_status_address_t address)
+{
+    return sts_get_status_var(address).i;
+}
+
+int sts_set_write_back(dat_status_address_t address, int enable)
+{
+    if(address >= dat_status_last_address || sts_slot[address] < 0)
+        return -1;
+
+    int slot = sts_slot[address];
+    uint32_t mask = 1UL << slot;
+    int flush = 0;
+    osSemaphoreTake(&sts_sem, portMAX_DELAY);
+    if(enable && !(sts_enabled & mask))
+    {
+        _sts_commit(slot, dat_get_status_var(address), 0);
+        sts_enabled |= mask;
+    }
+    else if(!enable && (sts_enabled & mask))
+    {
+        // Keep serving from the cache until the pending value is written
+        flush = (sts_images[sts_active].dirty & mask) != 0;
+        if(!flush)
+            sts_enabled &= ~mask;
+    }
+    osSemaphoreGiven(&sts_sem);
+
+    if(flush)
+    {
+        sts_flush();
+        osSemaphoreTake(&sts_sem, portMAX_DELAY);
+        if(!(sts_images[sts_active].dirty & mask))
+            sts_enabled &= ~mask;
+        osSemaphoreGiven(&sts_sem);
+    }
+    return 0;
+}
+
+int sts_flush(void)
+{
+    value32_t values[STS_NWRITE_BACK];
+    uint32_t dirty, written = 0;
+    int i, n = 0, nerr = 0;
+
+    osSemaphoreTake(&sts_flush_sem, portMAX_DELAY);
+
+    // Copy the dirty values, so writers are not blocked while the storage is
+    // being written.
+    osSemaphoreTake(&sts_sem, portMAX_DELAY);
+    sts_flush_req = 0;
+    dirty = sts_images[sts_active].dirty;
+    memcpy(values, sts_images[sts_active].value, sizeof(values));
+    osSemaphoreGiven(&sts_sem);
+
+    for(i = 0; i < STS_NWRITE_BACK; i++)
+    {
+        if(!(dirty & (1UL << i)))
+            continue;
+        n++;
+        if(dat_set_status_var(sts_write_back_list[i], values[i]) == 0)
+            written |= 1UL << i;
+        else
+            nerr++;
+    }
+
+    // Values are clean once written, failed ones are retried in the next
+    // flush. A value changed meanwhile stays dirty.
+    osSemaphoreTake(&sts_sem, portMAX_DELAY);
+    for(i = 0; i < STS_NWRITE_BACK; i++)
+    {
+        if((written & (1UL << i)) && sts_images[sts_active].value[i].u == values[i].u)
+            _sts_commit(i, values[i], 0);
+    }
+    osSemaphoreGiven(&sts_sem);
+
+    sts_nflush += n - nerr;
+    osSemaphoreGiven(&sts_flush_sem);
+
+    if(nerr > 0)
+    {
+        LOGE(tag, "Unable to flush %d status variables", nerr);
+        return -1;
+    }
+    if(n > 0)
+        LOGD(tag, "Flushed %d status variables", n);
+    return n;
+}
+
+int sts_flush_requested(void)
+{
+    osSemaphoreTake(&sts_sem, portMAX_DELAY);
+    int req = sts_flush_req && sts_images[sts_active].dirty != 0;
+    osSemaphoreGiven(&sts_sem);
+    return req;
+}
+
+void sts_print(void)
+{
+    int i, ncached = 0, ndirty = 0;
+    osSemaphoreTake(&sts_sem, portMAX_DELAY);
+    for(i = 0; i < dat_status_last_var; i++)
+    {
+        int slot = sts_slot[dat_status_list[i].address];
+        if(slot < 0 || !(sts_enabled & (1UL << slot)))
+            continue;
+        int dirty = (sts_images[sts_active].dirty & (1UL << slot)) != 0;
+        ncached++;
+        ndirty += dirty;
+        LOGR(tag, "%s%s", dat_status_list[i].name, dirty ? " *" : "");
+    }
+    LOGR(tag, "Cached: %d, dirty: %d, writes: %u, flushed: %u", ncached, ndirty,
+         (unsigned int)sts_nwrites, (unsigned int)sts_nflush);
+    osSemaphoreGiven(&sts_sem);
+}
+
+int sts_snapshot(const dat_status_address_t *vars, int n, value32_t *values)
+{
+    int i;
+    if(vars == NULL)
+        n = dat_status_last_var;
+    if(n <= 0 || n > dat_status_last_address || values == NULL)
+        return -1;
+
+    // Copy the cached variables and mark the ones to read from the storage
+    uint8_t stored[(dat_status_last_address + 7) / 8];
+    memset(stored, 0, sizeof(stored));
+    osSemaphoreTake(&sts_sem, portMAX_DELAY);
+    for(i = 0; i < n; i++)
+    {
+        int address = vars == NULL ? dat_status_list[i].address : vars[i];
+        values[i].u = 0;
+        if(address < dat_status_last_address && !_sts_get_cached(address, &values[i]))
+            stored[i / 8] |= 1 << (i % 8);
+    }
+    osSemaphoreGiven(&sts_sem);
+
+    // One pass over the status table, without the snapshot lock so writers
+    // are not blocked, and without taking the repository lock per variable
+    for(i = 0; i < n; i++)
+    {
+        int address = vars == NULL ? dat_status_list[i].address : vars[i];
+        if((stored[i / 8] & (1 << (i % 8))) &&
+           storage_status_get_value_idx(address, &values[i], DAT_TABLE_STATUS) != 0)
+            values[i] = dat_get_status_var(address);
+    }
+    return n;
+}
@@ -87,8 +87,8 @@ void taskADCS(void *param)
     vector3_t current_mag_i;
     int isDark;
     vector3_t  sun_pos_i;
-    vector3_t sun_dir_b;
-    vector3_t current_mag_b;
+    vector3_t sun_dir_b = {0.0, 0.0, 0.0};
+    vector3_t current_mag_b = {0.0, 0.0, 0.0};
     quaternion_t current_q_det = {0.0, 0.0 ,0.0 ,1.0};
     quaternion_t current_q_est_i2b = {0.0, 0.0 ,0.0 ,1.0};
     vector3_t current_omega_b_est = {1.0, -1.0,  -1.0};
@@ -103,6 +103,10 @@ void taskADCS(void *param)
     double pitch_rate = -10.0;
     double roll_rate = 5.0;
     int if_sun_info = 0;
+    int ekf_ready = 0;              // EKF state initialized since it was activated
+    int new_q_det = 0;              // current_q_det comes from new sensor reads
+    uint32_t mag_seq = 0;           // Sequence of the last sensor samples used
+    uint32_t sun_seq = 0;
     while(1)
     {
         if (dat_get_system_var(dat_calc_attitude)) {
@@ -118,14 +122,10 @@ void taskADCS(void *param)
                 //                                  SENSORS
                 // 10 Hz for gyro update
                 // Update gyro sensor
-
-#ifdef NANOMIND
-                cmd_t *cmd_get_omega = cmd_get_str("get_obc_omega");
-                cmd_add_params_str(cmd_get_omega, NULL);
-                cmd_send(cmd_get_omega);
-                osDelay(30);
-                _get_sat_vector(&current_omega_b, dat_ads_omega_x);
-#endif
+                // Freshest sample from taskADCSSensors, do not wait for a read
+                adcs_sen_sample_t sen_sample;
+                if(adcs_sen_get(ADCS_SEN_GYRO, &sen_sample) >= 0)
+                    current_omega_b = sen_sample.value;
                 LOGI(tag, "Angular velocity: (%f, %f, %f) [@bodyframe]", current_omega_b.v0, current_omega_b.v1,
                      current_omega_b.v2)
                 double dt = (double) elapsed_msec * 0.001;
@@ -135,31 +135,33 @@ void taskADCS(void *param)
                     // 2 Hz update for Css, mtm, and fss
                     //                                  MODELS
 
+                    ADCS_TIM_START(t_model);
                     calc_adcs_model_parameters(elapsed_msec, &sat_pos_i, &geod_vect,
                                                &current_mag_i, &isDark, &sun_pos_i);
+                    ADCS_TIM_STOP(ADCS_TIM_MODEL, t_model);
 
                     //                                  SENSORS
                     // Update magnetic from sensors - Body frame
                     //current_mag_b = test_transform_ypr(current_mag_i, yaw_rate * elapsed_msec * 0.001,
                     //                                             pitch_rate * elapsed_msec * 0.001,
                     //                                             roll_rate * elapsed_msec * 0.001);
-#ifdef NANOMIND
-                    cmd_t *cmd_get_mag = cmd_get_str("get_obc_mag");
-                    cmd_add_params_str(cmd_get_mag, NULL);
-                    cmd_send(cmd_get_mag);
-                    osDelay(50);
-                    _get_sat_vector(&current_mag_b, dat_ads_mag_x);
-#endif
+                    if(adcs_sen_get(ADCS_SEN_MAG, &sen_sample) >= 0)
+                    {
+                        current_mag_b = sen_sample.value;
+                        new_q_det |= sen_sample.seq != mag_seq;
+                        mag_seq = sen_sample.seq;
+                    }
                     LOGI(tag, "Magnetic field: (%f, %f, %f) [@bodyframe]", current_mag_b.v0, current_mag_b.v1,
                          current_mag_b.v2);
 
                     // Update sun information from sensors - Body frame
-                    cmd_t *cmd_get_sun_b = cmd_get_str("get_obc_sun_vec");
-                    cmd_send(cmd_get_sun_b);
-                    osDelay(1500);
-
                     // = test_transform_ypr(sun_pos_i, yaw_rate * dt, pitch_rate * dt, roll_rate * dt);
-                    _get_sat_vector(&sun_dir_b, dat_sun_vec_b_x);
+                    if(adcs_sen_get(ADCS_SEN_SUN, &sen_sample) >= 0)
+                    {
+                        sun_dir_b = sen_sample.value;
+                        new_q_det |= sen_sample.seq != sun_seq;
+                        sun_seq = sen_sample.seq;
+                    }
 
                     LOGI(tag, "Sun direction: (%f, %f, %f) [@bodyframe]", sun_dir_b.v0, sun_dir_b.v1, sun_dir_b.v2);
 
@@ -174,37 +176,40 @@ void taskADCS(void *param)
                     printf("Vale: %d \n", if_sun_info);
                     if (if_sun_info) {
                         printf("Calculating quaternion ...");
+                        ADCS_TIM_START(t_det);
                         determine_quaternion_triadekf(isDark, current_mag_b, current_mag_i, sun_dir_b,
                                                       sun_pos_from_sc_i, &current_q_det);
+                        ADCS_TIM_STOP(ADCS_TIM_DETERMINATION, t_det);
                         LOGI(tag, "Quaternion i2b determined: (%f, %f, %f, %f)", current_q_det.q0, current_q_det.q1,
                              current_q_det.q2, current_q_det.q3);
                         _set_sat_quaterion(&current_q_det, dat_ads_q0);
                         //_set_sat_quaterion(&current_q_est_i2b, dat_ads_ekf_q0);
-                        osDelay(30);
                     }
                     else{
                         printf("Calculating quaternion ...");
+                        ADCS_TIM_START(t_det);
                         determine_quaternion_by_mtt(current_mag_b, current_mag_i, &current_q_det);
+                        ADCS_TIM_STOP(ADCS_TIM_DETERMINATION, t_det);
                         LOGI(tag, "Quaternion i2b determined: (%f, %f, %f, %f)", current_q_det.q0, current_q_det.q1,
                             current_q_det.q2, current_q_det.q3);
                         _set_sat_quaterion(&current_q_det, dat_ads_q0);
                         //_set_sat_quaterion(&current_q_est_i2b, dat_ads_ekf_q0);
-                        osDelay(30);
                     }
                 }
-                /**
                 if (act_ekf) {
-                    if (elapsed_msec == 0) {
+                    if (!ekf_ready) {
                         first_adcs_data(current_omega_b, current_q_det);
+                        ekf_ready = 1;
                     } else {
-                        _get_sat_quaterion(&current_q_det, dat_ads_q0);
-                        estimate_omega_quat_with_triadekf(current_q_det, current_omega_b, delay_ms, &current_q_est_i2b,
-                                                          &current_omega_b_est);
+                        // Gyro rows every td_gyro, quaternion rows only if it
+                        // was determined from new sensor samples
+                        estimate_omega_quat_with_triadekf_seq(current_q_det, current_omega_b, new_q_det, td_gyro,
+                                                              &current_q_est_i2b, &current_omega_b_est);
                         _set_sat_quaterion(&current_q_est_i2b, dat_ads_ekf_q0);
-                        _set_sat_quaterion(&current_q_det, dat_ads_q0);
                         _set_sat_vector(&current_omega_b_est, dat_ads_ekf_omega_x);
                     }
                 } else {
+                    ekf_ready = 0;
                     current_omega_b_est.v[0] = 0;
                     current_omega_b_est.v[1] = 0;
                     current_omega_b_est.v[2] = 0;
@@ -212,7 +217,8 @@ void taskADCS(void *param)
                     current_q_est_i2b.q[1] = 0;
                     current_q_est_i2b.q[2] = 0;
                     current_q_est_i2b.q[3] = 1;
-                }**/
+                }
+                new_q_det = 0;
 
                 /* Save ADCS data */
                 int curr_time = dat_get_time();
@@ -222,7 +228,7 @@ void taskADCS(void *param)
                                            current_mag_b.v1, current_mag_b.v2,current_q_det.q0,
                                            current_q_det.q1, current_q_det.q2,
                                            current_q_det.q3};
-                dat_add_payload_sample(&data_ads_ekf, ekf_sensors);
+                evt_add_payload_sample(&data_ads_ekf, ekf_sensors);
             }
 
             /* 1 second actions */
@@ -236,32 +242,33 @@ void taskADCS(void *param)
                     // Set target attitude
                     //cmd_t *cmd_point = cmd_get_str("sim_adcs_set_target");
                     //cmd_add_params_var(cmd_point, 1.0, 1.0, 1.0, 0.01, 0.01, 0.01);
+                    // Called directly, not through the commands queue
                     int mode;
                     mode = dat_get_system_var(dat_obc_opmode);
-                    cmd_t *cmd_point;
                     if (mode == DAT_OBC_OPMODE_REF_POINT) {
-                        cmd_point = cmd_get_str("adcs_set_target");
-                        cmd_add_params_var(cmd_point, 1.0, 1.0, 1.0, 0.01, 0.01, 0.01);
+                        vector3_t i_tar = {1.0, 1.0, 1.0};
+                        vector3_t omega_tar = {0.01, 0.01, 0.01};
+                        adcs_point_to(i_tar, omega_tar);
                     } else if (mode == DAT_OBC_OPMODE_NAD_POINT) {
-                        cmd_point = cmd_get_str("adcs_set_to_nadir");
+                        adcs_target_nadir(NULL, NULL, 0);
                     } else if (mode == DAT_OBC_OPMODE_DETUMB_MAG) {
-                        cmd_point = cmd_get_str("adcs_detumbling_mag");
+                        adcs_detumbling_mag(NULL, NULL, 0);
                     }
-                    cmd_send(cmd_point);
                     // Do control loop
-                    cmd_t *cmd_ctrl;
                     if (mode == DAT_OBC_OPMODE_DETUMB_MAG) {
-                        cmd_ctrl = cmd_get_str("adcs_mag_moment");
+                        adcs_mag_moment(NULL, NULL, 0);
                     } else {
-                        cmd_ctrl = cmd_get_str("adcs_do_control");
-                        cmd_add_params_var(cmd_ctrl, _adcs_ctrl_period * 1000);
+                        adcs_do_control(_adcs_ctrl_period * 1000.0);
                     }
-                    cmd_send(cmd_ctrl);
                     // Send telemetry to ADCS subsystem
-                    cmd_t *cmd_att = cmd_get_str("adcs_send_attitude");
-                    cmd_send(cmd_att);
+                    adcs_send_attitude(NULL, NULL, 0);
                 }
             }
+#if SCH_ADCS_TIMING_ENABLED
+            /* 5 minutes actions */
+            if((elapsed_msec % _05min_check) == 0)
+                adcs_tim_flush();
+#endif
             /* 1 hours actions */
             if((elapsed_msec % _1hour_check) == 0)
             {
@@ -296,12 +303,26 @@ void calc_adcs_model_parameters(unsigned int elapsed_msec, vector3_t * sat_pos_i
     double dec_year = jd_to_dec(current_jd);
     LOGI(tag, "Julian date: %f, Dec year: %f", current_jd, dec_year);
 
-    // update position from TLE
-    cmd_t *cmd_tle_prop = cmd_get_str("tle_prop");
-    cmd_add_params_str(cmd_tle_prop, "0");
-    cmd_send(cmd_tle_prop);
-    osDelay(50);
-    _get_sat_vector(sat_pos_i, dat_ads_pos_x);
+    // Orbit-ahead references from taskADCSReference, the models are only evaluated if the table is not ready
+    adcs_ref_t ref;
+    if(adcs_ref_get((double)curr_time, &ref) == 0)
+    {
+        *sat_pos_i = ref.pos_i;
+        *geod_vect = ref.geod;
+        *current_mag_i = ref.mag_i;
+        *sun_pos_i = ref.sun_pos_i;
+        *isdark = ref.isdark;
+        LOGI(tag, "Satellite position [km] : (%.8f, %.8f, %.8f), Is dark?: %i (reference table)",
+             sat_pos_i->v[0], sat_pos_i->v[1], sat_pos_i->v[2], isdark[0]);
+        return;
+    }
+
+    // update position from the shared propagator, keep the last models if the TLE is not valid
+    if(orbit_prop_get((double)curr_time, sat_pos_i, NULL) != 0)
+    {
+        LOGW(tag, "Unable to propagate the orbit, models not updated");
+        return;
+    }
     LOGI(tag, "Satellite position [km] : (%.8f, %.8f, %.8f)", sat_pos_i->v[0], sat_pos_i->v[1], sat_pos_i->v[2]);
 
     // Update geodetic coordinate
@@ -357,7 +378,7 @@ void eskf_predict_state(double* P, double dt)
 }
 
 void calc_magnetic_model(double decyear, double latrad, double lonrad, double altm, double current_sideral_, vector3_t * mag) {
-    IgrfCalc(decyear, latrad, lonrad, altm * 1000, current_sideral_, mag);
+    igrf_cache_calc(decyear, latrad, lonrad, altm * 1000, current_sideral_, mag);
 }
 
 void calc_sun_pos_i(double jd, vector3_t * sun_dir) {
@@ -430,34 +451,41 @@ double jd_to_dec(double jd)
 int eci_to_geodetic(vector3_t sat_pos, double current_side, vector3_t * lat_lon_alt) {
     double radiusearthkm = 6378.137;     // km
     double f = 1.0 / 298.257223563;
-
-    double r, e2, phi, c;
-    double theta;
-
-    theta = atan2(sat_pos.v1, sat_pos.v0);
-
-
-    double lon_rad_ = fmod2p(theta - current_side); /* radians */
-    r = sqrt(sat_pos.v0 * sat_pos.v0 + sat_pos.v1 * sat_pos.v1);
-    e2 = f*(2 - f);
-    double lat_rad_ = atan2(sat_pos.v2, r); /* radians */
-    do
-    {
-        phi = lat_rad_;
-        c = 1 / sqrt(1 - e2*sin(phi)*sin(phi));
-        lat_rad_ = atan2(sat_pos.v2 + radiusearthkm*c*e2*sin(phi), r);
-
-    } while (fabs(lat_rad_ - phi) >= 1E-10);
-    double alt_m_ = r / cos(lat_rad_) - radiusearthkm*c; /* kilometers */
-
-    if (lat_rad_ > pi/2.0)
-        lat_rad_ -= twopi;
+    double e2 = f*(2 - f);
+    double e4 = e2*e2;
+
+    double lon_rad_ = fmod2p(atan2(sat_pos.v1, sat_pos.v0) - current_side); /* radians */
+
+    // Vermeille (2004) closed form, exact outside the evolute (~43 km around the Earth center)
+    double rho2 = sat_pos.v0 * sat_pos.v0 + sat_pos.v1 * sat_pos.v1;
+    double z2 = sat_pos.v2 * sat_pos.v2;
+    double p = rho2 / (radiusearthkm * radiusearthkm);
+    double q = (1 - e2) * z2 / (radiusearthkm * radiusearthkm);
+    double r = (p + q - e4) / 6.0;
+    double s = e4 * p * q / (4.0 * r * r * r);
+    double t = cbrt(1.0 + s + sqrt(s * (2.0 + s)));
+    double u = r * (1.0 + t + 1.0 / t);
+    double v = sqrt(u * u + e4 * q);
+    double w = e2 * (u + v - q) / (2.0 * v);
+    double k = sqrt(u + v + w * w) - w;
+    double d = k * sqrt(rho2) / (k + e2);
+    double dz = sqrt(d * d + z2);
+
+    double lat_rad_ = 2.0 * atan2(sat_pos.v2, d + dz); /* radians */
+    double alt_m_ = (k + e2 - 1.0) / k * dz; /* kilometers */
 
     lat_lon_alt->v0 = lat_rad_;
     lat_lon_alt->v1 = lon_rad_;
     lat_lon_alt->v2 = alt_m_;
+    return 0;
 }
 
+int eci_to_geodetic_batch(const vector3_t * sat_pos, const double * current_side, vector3_t * lat_lon_alt, int n) {
+    int i;
+    for(i = 0; i < n; i++)
+        eci_to_geodetic(sat_pos[i], current_side == NULL ? 0.0 : current_side[i], &lat_lon_alt[i]);
+    return n;
+}
 
 double unixt_to_jd(uint32_t unix_time) {
     return ( unix_time / 86400.0 ) + 2440587.5;
@@ -0,0 +1,49 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/taskADCSReference.h"
+
+static const char *tag = "taskADCSRef";
+
+void taskADCSReference(void *param)
+{
+    LOGI(tag, "Started");
+
+    portTick delay_ms = ADCS_REF_CHECK_MS;
+    portTick xLastWakeTime = osTaskGetTickCount();
+
+    while(1)
+    {
+        osTaskDelayUntil(&xLastWakeTime, delay_ms); //Suspend task
+
+        int tle_epoch = dat_get_system_var(dat_ads_tle_epoch);
+        if(!dat_get_system_var(dat_calc_attitude) || tle_epoch == 0)
+            continue;
+
+        double now = (double)time(NULL);
+        if(!adcs_ref_expired(now, tle_epoch))
+            continue;
+
+        // Start one node before now, so the current time can be interpolated
+        double t0 = floor(now / ADCS_REF_STEP) * ADCS_REF_STEP - ADCS_REF_STEP;
+        int nodes = adcs_ref_fill(t0, ADCS_REF_YIELD_MS);
+        if(nodes < 0)
+            LOGW(tag, "Unable to fill the ADCS reference table");
+    }
+}
@@ -0,0 +1,98 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/taskADCSSensors.h"
+
+static const char *tag = "taskADCSSen";
+
+/**
+ * Sensor read, the driver is called directly (not through the commands queue)
+ * so the read has finished when it returns
+ */
+typedef struct sen_reader {
+    int sensor;                     ///< Sensor slot, adcs_sen_id_t
+    int group;                      ///< Task that reads the sensor, adcs_sen_group_t
+    int period_var;                 ///< Status variable with the read period [ms]
+    int value_var;                  ///< First status variable of the measurement vector
+    int tim_stage;                  ///< Timing stage, adcs_tim_stage_t
+    int (*read)(vector3_t *value);  ///< Driver read function, returns ADCS_DRV_OK
+} sen_reader_t;
+
+static const sen_reader_t sen_readers[] = {
+#ifdef NANOMIND
+    {ADCS_SEN_GYRO, ADCS_SEN_GROUP_FAST, dat_time_delay_gyro, dat_ads_omega_x, ADCS_TIM_GYRO,    adcs_drv_read_gyro},
+    {ADCS_SEN_MAG,  ADCS_SEN_GROUP_FAST, dat_time_delay_quat, dat_ads_mag_x,   ADCS_TIM_MAG_SUN, adcs_drv_read_mag},
+#endif
+    {ADCS_SEN_SUN,  ADCS_SEN_GROUP_SUN,  dat_time_delay_quat, dat_sun_vec_b_x, ADCS_TIM_MAG_SUN, adcs_drv_read_sun},
+};
+
+#define SEN_NREADERS ((int)(sizeof(sen_readers) / sizeof(sen_readers[0])))
+
+void taskADCSSensors(void *param)
+{
+    int group = (int)(intptr_t)param;
+    LOGI(tag, "Started, group %d", group);
+
+    portTick delay_ms = ADCS_SEN_TICK_MS;
+    portTick last_read[SEN_NREADERS];
+    int i, active = 0;
+    portTick xLastWakeTime = osTaskGetTickCount();
+
+    while(1)
+    {
+        if(!dat_get_system_var(dat_calc_attitude))
+        {
+            active = 0;
+            osDelay(1000);
+            xLastWakeTime = osTaskGetTickCount();
+            continue;
+        }
+
+        portTick now = osTaskGetTickCount();
+        for(i = 0; i < SEN_NREADERS; i++)
+        {
+            const sen_reader_t *reader = &sen_readers[i];
+            if(reader->group != group)
+                continue;
+            // Read all sensors as soon as the attitude calculation starts
+            int period = dat_get_system_var(reader->period_var);
+            if(active && (portTick)(now - last_read[i]) < (portTick)period)
+                continue;
+            last_read[i] = now;
+
+            vector3_t value;
+            ADCS_TIM_START(t_read);
+            int rc = reader->read(&value);
+            ADCS_TIM_STOP(reader->tim_stage, t_read);
+            if(rc == ADCS_DRV_OK)
+            {
+                adcs_sen_put(reader->sensor, &value);
+                _set_sat_vector(&value, reader->value_var);
+            }
+            else
+            {
+                adcs_sen_error(reader->sensor);
+                LOGW(tag, "Error reading ADCS sensor %d", reader->sensor);
+            }
+        }
+        active = 1;
+
+        osTaskDelayUntil(&xLastWakeTime, delay_ms); //Suspend task
+    }
+}
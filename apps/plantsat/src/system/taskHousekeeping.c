@@ -73,7 +73,7 @@ void taskHousekeeping(void *param)
         }
 
         /* 10 sec actions */
-        // Update position
+        // Update position status vars (telemetry), served from the shared propagator cache
         if ((elapsed_sec % _10sec_check) == 0)
         {
             // Check if the TLE epoch is valid
@@ -84,7 +84,21 @@ void taskHousekeeping(void *param)
                 cmd_tle_prop = cmd_build_from_str("tle_prop 0");
                 cmd_send(cmd_tle_prop);
             }
+
+            // Write the open records block and payload pages if they are old
+            cmd_t *cmd_flush = cmd_get_str("sen_buff_flush");
+            cmd_add_params_var(cmd_flush, SCH_ST_BUFF_MAX_AGE);
+            cmd_send(cmd_flush);
+        }
+
+#if SCH_STS_FLUSH_PERIOD > 0
+        // Write cached status variables, also after a critical variable changed
+        if((elapsed_sec % SCH_STS_FLUSH_PERIOD) == 0 || sts_flush_requested())
+        {
+            cmd_t *cmd_sts_flush = cmd_get_str("obc_sts_flush");
+            cmd_send(cmd_sts_flush);
         }
+#endif
 
         /* 1 minute actions */
         // Update status vars
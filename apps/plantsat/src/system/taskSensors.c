@@ -34,11 +34,11 @@ void taskSensors(void *param)
     char *get_cmds[] = {"sen_get_temp", "sen_get_adcs", "sen_get_eps", "sen_get_status", "sen_get_adcs_fss"};
 
 
-    int action = dat_get_system_var(dat_drp_mach_action);
-    int state = dat_get_system_var(dat_drp_mach_state);
+    int action = sts_get_system_var(dat_drp_mach_action);
+    int state = sts_get_system_var(dat_drp_mach_state);
     int step = dat_get_system_var(dat_drp_mach_step);
     int active_payloads = dat_get_system_var(dat_drp_mach_payloads);
-    int samples_left = dat_get_system_var(dat_drp_mach_left);
+    int samples_left = sts_get_system_var(dat_drp_mach_left);
 
     if( action < 0 || state < 0  || active_payloads < 0 || step < 0) {
         status_machine = (dat_stmachine_t) {ST_PAUSE, ACT_START, 0, 5, -1, nsensors};
@@ -87,8 +87,8 @@ void taskSensors(void *param)
                 status_machine.action = ACT_STAND_BY;
                 osSemaphoreGiven(&repo_machine_sem);
             }
-            // Check for step
-            else if (elapsed_sec % status_machine.step == 0) {
+            // Check for step, faster while an event boost is active
+            else if (elapsed_sec % evt_get_step(status_machine.step) == 0) {
                 LOGV(tag, "SAMPLING...");
 
                 for(i=0; i<nsensors; i++)
@@ -114,11 +114,11 @@ void taskSensors(void *param)
         active_payloads = (int) status_machine.active_payloads;
         samples_left = (int) status_machine.samples_left;
 
-        dat_set_system_var(dat_drp_mach_action, action);
-        dat_set_system_var(dat_drp_mach_state, state);
+        sts_set_system_var(dat_drp_mach_action, action);
+        sts_set_system_var(dat_drp_mach_state, state);
         dat_set_system_var(dat_drp_mach_step, step);
         dat_set_system_var(dat_drp_mach_payloads, active_payloads);
-        dat_set_system_var(dat_drp_mach_left, samples_left);
+        sts_set_system_var(dat_drp_mach_left, samples_left);
         elapsed_sec += 1;
     }
 }
@@ -0,0 +1,271 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/tmDelta.h"
+
+static inline uint32_t zigzag_enc(int32_t v)
+{
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t zigzag_dec(uint32_t v)
+{
+    return (int32_t)((v >> 1) ^ (~(v & 1) + 1));
+}
+
+/**
+ * Write a varint, return the number of bytes written or 0 if it does not fit
+ */
+static int varint_write(uint32_t v, uint8_t *buff, int len)
+{
+    int n = 0;
+    do
+    {
+        if(n >= len)
+            return 0;
+        uint8_t b = v & 0x7F;
+        v >>= 7;
+        buff[n++] = v ? (b | 0x80) : b;
+    } while(v);
+    return n;
+}
+
+/**
+ * Read a varint, return the number of bytes read or 0 if malformed
+ */
+static int varint_read(uint8_t *buff, int len, uint32_t *v)
+{
+    int n = 0;
+    uint32_t res = 0;
+    while(n < len && n < 5)
+    {
+        uint8_t b = buff[n];
+        res |= (uint32_t)(b & 0x7F) << (7 * n);
+        n++;
+        if(!(b & 0x80))
+        {
+            *v = res;
+            return n;
+        }
+    }
+    return 0;
+}
+
+static inline int32_t field_read(uint8_t *p, uint8_t width)
+{
+    if(width == 2)
+    {
+        int16_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    int32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void field_write(uint8_t *p, uint8_t width, int32_t v)
+{
+    if(width == 2)
+    {
+        int16_t v16 = (int16_t)v;
+        memcpy(p, &v16, sizeof(v16));
+        return;
+    }
+    memcpy(p, &v, sizeof(v));
+}
+
+/**
+ * Write a raw field of width bytes, little endian
+ */
+static inline void raw_write(uint8_t *buff, uint8_t width, int32_t v)
+{
+    int b;
+    for(b = 0; b < width; b++)
+        buff[b] = (uint8_t)((uint32_t)v >> (8 * b));
+}
+
+/**
+ * Read a raw field of width bytes, little endian. 2 bytes fields are sign
+ * extended as field_read does.
+ */
+static inline int32_t raw_read(uint8_t *buff, uint8_t width)
+{
+    uint32_t v = 0;
+    int b;
+    for(b = 0; b < width; b++)
+        v |= (uint32_t)buff[b] << (8 * b);
+    if(width == 2)
+        return (int16_t)v;
+    return (int32_t)v;
+}
+
+int tm_delta_get_layout(data_map_t *map, uint8_t *widths, int max_fields)
+{
+    int nfields = 0;
+    int size = 0;
+    char *p = map->data_order;
+
+    while((p = strchr(p, '%')) != NULL)
+    {
+        p++;
+        if(nfields >= max_fields)
+            return -1;
+        switch(*p)
+        {
+            case 'u':
+            case 'd':
+            case 'i':
+            case 'f':
+                widths[nfields] = 4;
+                break;
+            case 'h':
+                widths[nfields] = 2;
+                break;
+            default:
+                // Strings and other types are not supported
+                return -1;
+        }
+        size += widths[nfields];
+        nfields++;
+    }
+
+    if(nfields == 0 || size > map->size)
+        return -1;
+    return nfields;
+}
+
+int tm_delta_encode(data_map_t *map, int payload, uint8_t *samples, int nsamples,
+                    uint8_t *frame, int frame_len, int *used)
+{
+    uint8_t widths[TM_DELTA_MAX_FIELDS];
+    int32_t prev[TM_DELTA_MAX_FIELDS];
+    uint8_t sample_enc[TM_DELTA_MAX_FIELDS * 5];
+    int nfields = tm_delta_get_layout(map, widths, TM_DELTA_MAX_FIELDS);
+    *used = 0;
+    if(nfields < 0 || frame_len <= TM_DELTA_HEADER_LEN)
+        return -1;
+
+    if(nsamples > TM_DELTA_MAX_SAMPLES)
+        nsamples = TM_DELTA_MAX_SAMPLES;
+
+    int len = 0;
+    int i, f;
+    uint8_t *data = frame + TM_DELTA_HEADER_LEN;
+    int data_len = frame_len - TM_DELTA_HEADER_LEN;
+    for(i = 0; i < nsamples; i++)
+    {
+        // Encode one sample apart, so it is added only if it fits entirely
+        uint8_t *p = samples + i * map->size;
+        int n = 0;
+        int32_t curr[TM_DELTA_MAX_FIELDS];
+        for(f = 0; f < nfields; f++)
+        {
+            curr[f] = field_read(p, widths[f]);
+            if(i == 0)
+            {
+                // The first sample is written raw, the next ones as deltas
+                raw_write(sample_enc + n, widths[f], curr[f]);
+                n += widths[f];
+            }
+            else
+            {
+                n += varint_write(zigzag_enc((int32_t)((uint32_t)curr[f] - (uint32_t)prev[f])), sample_enc + n, 5);
+            }
+            p += widths[f];
+        }
+
+        if(len + n > data_len)
+            break;
+        memcpy(data + len, sample_enc, n);
+        memcpy(prev, curr, nfields * sizeof(int32_t));
+        len += n;
+    }
+
+    frame[0] = TM_DELTA_VERSION;
+    frame[1] = (uint8_t)payload;
+    frame[2] = (uint8_t)i;
+    frame[3] = (uint8_t)nfields;
+    frame[4] = (uint8_t)(map->size >> 8);
+    frame[5] = (uint8_t)(map->size & 0xFF);
+    frame[6] = (uint8_t)(len >> 8);
+    frame[7] = (uint8_t)(len & 0xFF);
+
+    *used = i;
+    return len + TM_DELTA_HEADER_LEN;
+}
+
+int tm_delta_get_header(uint8_t *frame, int *payload, int *nsamples)
+{
+    if(frame[0] != TM_DELTA_VERSION)
+        return -1;
+    *payload = frame[1];
+    *nsamples = frame[2];
+    return 0;
+}
+
+int tm_delta_decode(data_map_t *map, uint8_t *frame, int frame_len, uint8_t *samples, int max_samples)
+{
+    uint8_t widths[TM_DELTA_MAX_FIELDS];
+    int32_t prev[TM_DELTA_MAX_FIELDS];
+    int nfields = tm_delta_get_layout(map, widths, TM_DELTA_MAX_FIELDS);
+    if(nfields < 0 || frame_len < TM_DELTA_HEADER_LEN || frame[0] != TM_DELTA_VERSION)
+        return -1;
+
+    // The frame must match our payload layout
+    int nsamples = frame[2];
+    int size = (frame[4] << 8) | frame[5];
+    int len = (frame[6] << 8) | frame[7];
+    if(frame[3] != nfields || size != map->size || len > frame_len - TM_DELTA_HEADER_LEN)
+        return -1;
+    if(nsamples > max_samples)
+        nsamples = max_samples;
+
+    uint8_t *data = frame + TM_DELTA_HEADER_LEN;
+    int pos = 0;
+    int i, f;
+    for(i = 0; i < nsamples; i++)
+    {
+        uint8_t *p = samples + i * map->size;
+        memset(p, 0, map->size);
+        for(f = 0; f < nfields; f++)
+        {
+            if(i == 0)
+            {
+                if(len - pos < widths[f])
+                    return i;
+                prev[f] = raw_read(data + pos, widths[f]);
+                pos += widths[f];
+            }
+            else
+            {
+                uint32_t v;
+                int n = varint_read(data + pos, len - pos, &v);
+                if(n == 0)
+                    return i;
+                pos += n;
+                prev[f] = (int32_t)((uint32_t)prev[f] + (uint32_t)zigzag_dec(v));
+            }
+            field_write(p, widths[f], prev[f]);
+            p += widths[f];
+        }
+    }
+
+    return i;
+}
@@ -75,6 +75,11 @@ typedef enum dat_status_address_enum {
     /// Memory: Current send acknowledge data
     dat_drp_ack_temp,             ///< Temperature data acknowledge
 
+    /// Host: Host metrics variables
+    dat_obc_host_period,          ///< Seconds between host metrics samples (0: disabled)
+    dat_drp_host,                 ///< Host metrics data index
+    dat_drp_ack_host,             ///< Host metrics data acknowledge
+
     /// Add a new status variables address here
     //dat_custom,                 ///< Variable description
 
@@ -147,6 +152,9 @@ static const dat_sys_var_t dat_status_list[] = {
         {dat_obc_opmode,        "obc_opmode",        'd', DAT_IS_CONFIG, -1},          ///< General operation mode
         {dat_rtc_date_time,     "rtc_date_time",     'd', DAT_IS_CONFIG, -1},          ///< RTC current unix time
         {dat_drp_ack_temp,      "drp_ack_temp",      'u', DAT_IS_CONFIG, 0},          ///< Temperature data acknowledge
+        {dat_obc_host_period,   "obc_host_period",   'u', DAT_IS_CONFIG, 60},         ///< Seconds between host metrics samples
+        {dat_drp_host,          "drp_host",          'u', DAT_IS_STATUS, 0},          ///< Host metrics data index
+        {dat_drp_ack_host,      "drp_ack_host",      'u', DAT_IS_CONFIG, 0},          ///< Host metrics data acknowledge
 };
 ///< The dat_status_last_var constant serves for looping through all status variables
 static const int dat_status_last_var = sizeof(dat_status_list) / sizeof(dat_status_list[0]);
@@ -169,6 +177,7 @@ static const int dat_status_last_var = sizeof(dat_status_list) / sizeof(dat_stat
 
 typedef enum payload_id {
     temp_sensors=0,         ///< Temperature sensors
+    host_sensors,           ///< Linux host metrics
     last_sensor             ///< Dummy element, the amount of payload variables
 } payload_id_t;
 
@@ -181,6 +190,29 @@ typedef struct __attribute__((__packed__)) temp_data {
     float obc_temp_1;
 } temp_data_t;
 
+/**
+ * Struct for storing Linux host metrics.
+ */
+typedef struct __attribute__((__packed__)) host_data {
+    uint32_t index;
+    uint32_t timestamp;
+    float obc_temp_1;           ///< Board temperature [C]
+    float cpu_load;             ///< System CPU usage since last sample [%]
+    float load_avg_1;           ///< One minute load average
+    uint32_t mem_total;         ///< Total memory [kB]
+    uint32_t mem_avail;         ///< Available memory [kB]
+    uint32_t disk_total;        ///< Storage partition size [kB]
+    uint32_t disk_free;         ///< Storage partition free space [kB]
+    float proc_cpu;             ///< This process CPU usage since last sample [%]
+    uint32_t nthreads;          ///< This process number of threads
+    uint32_t thr1_tid;          ///< Busiest thread id
+    float thr1_cpu;             ///< Busiest thread CPU usage [%]
+    uint32_t thr2_tid;
+    float thr2_cpu;
+    uint32_t thr3_tid;
+    float thr3_cpu;
+} host_data_t;
+
 
 /**
  * Struct for storing data collected by status variables.
@@ -193,6 +225,8 @@ typedef struct __attribute__((__packed__)) sta_data {
 
 static data_map_t data_map[] = {
 {"temp_data",      (uint16_t) (sizeof(temp_data_t)),dat_drp_temp,dat_drp_ack_temp, "%u %u %f",                   "sat_index timestamp obc_temp_1"},
+{"host_data",      (uint16_t) (sizeof(host_data_t)),dat_drp_host,dat_drp_ack_host, "%u %u %f %f %f %u %u %u %u %f %u %u %f %u %f %u %f",
+                   "sat_index timestamp obc_temp_1 cpu_load load_avg_1 mem_total mem_avail disk_total disk_free proc_cpu nthreads thr1_tid thr1_cpu thr2_tid thr2_cpu thr3_tid thr3_cpu"},
 };
 
 /** The repository's name */
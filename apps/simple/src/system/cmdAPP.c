@@ -25,25 +25,20 @@ void cmd_app_init(void)
 {
     cmd_add("obc_get_sensors", obc_get_sensors, "", 0);
     cmd_add("obc_update_status", obc_update_status, "", 0);
+    cmd_add("obc_get_host", obc_get_host, "", 0);
 }
 
 int obc_get_sensors(char *fmt, char *params, int nparams)
 {
 #ifdef LINUX
     int curr_time =  (int)time(NULL);
-    float systemp, millideg;
-    FILE *thermal;
-    int n;
+    float systemp;
 
     LOGD(tag, "Reading obc data in Linux \n timestamp: %d", curr_time);
     // Reading temp
-    thermal = fopen("/sys/class/thermal/thermal_zone0/temp","r");
-    n = fscanf(thermal,"%f",&millideg);
-    fclose(thermal);
-    if(n!= 1)
+    if(sys_metrics_read_temp(&systemp) != 0)
         return CMD_ERROR;
     // Save temp
-    systemp = millideg / 1000;
     int index_temp = dat_get_system_var(data_map[temp_sensors].sys_index);
     struct temp_data data_temp = {index_temp, curr_time, systemp};
     LOGR(tag, "Temp1: %.1f", data_temp.obc_temp_1);
@@ -58,20 +53,14 @@ int obc_update_status(char *fmt, char *params, int nparams)
 {
 #ifdef LINUX
     int curr_time =  (int)time(NULL);
-    float systemp, millideg;
-    FILE *thermal;
-    int n;
+    float systemp;
 
     LOGD(tag, "Reading obc data in Linux \n timestamp: %d", curr_time);
     // Reading temp
-    thermal = fopen("/sys/class/thermal/thermal_zone0/temp","r");
-    n = fscanf(thermal,"%f",&millideg);
-    fclose(thermal);
-    if(n!= 1)
+    if(sys_metrics_read_temp(&systemp) != 0)
         return CMD_ERROR;
 
     // Save temp
-    systemp = millideg / 1000;
     /* Set sensors status variables (fix type) */
     value32_t temp_1;
     temp_1.f = systemp;
@@ -83,3 +72,24 @@ int obc_update_status(char *fmt, char *params, int nparams)
     return CMD_ERROR;
 #endif
 }
+
+int obc_get_host(char *fmt, char *params, int nparams)
+{
+#ifdef LINUX
+    host_data_t data_host;
+    if(sys_metrics_sample(&data_host) != 0)
+        return CMD_ERROR;
+
+    data_host.index = dat_get_system_var(data_map[host_sensors].sys_index);
+    data_host.timestamp = (int)time(NULL);
+    int rc = dat_add_payload_sample(&data_host, host_sensors);
+
+    LOGR(tag, "CPU: %.1f%%, Load: %.2f, Mem: %u/%u kB, Disk: %u/%u kB, Proc: %.1f%% (%u threads), Top: %u (%.1f%%)",
+         data_host.cpu_load, data_host.load_avg_1, data_host.mem_avail, data_host.mem_total,
+         data_host.disk_free, data_host.disk_total, data_host.proc_cpu, data_host.nthreads,
+         data_host.thr1_tid, data_host.thr1_cpu);
+    return rc != 0 ? CMD_ERROR : CMD_OK;
+#else
+    return CMD_ERROR;
+#endif
+}
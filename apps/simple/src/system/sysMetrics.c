@@ -0,0 +1,341 @@
+/*                                 SUCHAI
+ *                      NANOSATELLITE FLIGHT SOFTWARE
+ *
+ *      Copyright 2026, agent, agent@local
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "app/system/sysMetrics.h"
+
+static const char *tag = "sysMetrics";
+
+#ifdef LINUX
+/**
+ * A thread of this process and its last cpu time
+ */
+typedef struct sys_thread {
+    int tid;                    ///< Thread id, 0 if the entry is free
+    int fd;                     ///< Open /proc/self/task/<tid>/stat
+    unsigned long ticks;        ///< utime + stime at the last sample
+    float cpu;                  ///< CPU usage since the last sample [%]
+    int seen;                   ///< Found in the current sample
+} sys_thread_t;
+
+static int fd_thermal = -1;
+static int fd_stat = -1;
+static int fd_meminfo = -1;
+static int fd_loadavg = -1;
+static int fd_self_stat = -1;
+static int fd_disk = -1;
+static DIR *dir_tasks = NULL;
+static sys_thread_t threads[SYS_METRICS_MAX_THREADS];
+
+static unsigned long long last_cpu_busy = 0;
+static unsigned long long last_cpu_total = 0;
+static unsigned long last_proc_ticks = 0;
+static double last_time = 0;
+static long clk_tck = 100;
+
+/**
+ * Read a whole (small) file from offset 0 as a null terminated string
+ */
+static int sys_metrics_pread(int fd, char *buff, size_t len)
+{
+    if(fd < 0)
+        return -1;
+    ssize_t n = pread(fd, buff, len - 1, 0);
+    if(n < 0)
+        return -1;
+    buff[n] = '\0';
+    return (int)n;
+}
+
+/**
+ * Parse utime + stime and number of threads from a /proc/<pid>/stat buffer
+ */
+static int sys_metrics_parse_stat(char *buff, unsigned long *ticks, long *nthreads)
+{
+    // The command name may contain spaces, fields start after the last ')'
+    char *p = strrchr(buff, ')');
+    if(p == NULL)
+        return -1;
+
+    unsigned long utime, stime;
+    long nth;
+    int n = sscanf(p + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu %*d %*d %*d %*d %ld",
+                   &utime, &stime, &nth);
+    if(n != 3)
+        return -1;
+    *ticks = utime + stime;
+    if(nthreads != NULL)
+        *nthreads = nth;
+    return 0;
+}
+
+static double sys_metrics_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Update the threads table with the cpu usage of each thread
+ */
+static void sys_metrics_update_threads(double elapsed)
+{
+    int i;
+    char buff[512];
+    struct dirent *entry;
+
+    if(dir_tasks == NULL)
+        return;
+
+    for(i = 0; i < SYS_METRICS_MAX_THREADS; i++)
+        threads[i].seen = 0;
+
+    rewinddir(dir_tasks);
+    while((entry = readdir(dir_tasks)) != NULL)
+    {
+        int tid = atoi(entry->d_name);
+        if(tid <= 0)
+            continue;
+
+        sys_thread_t *thr = NULL;
+        sys_thread_t *free_thr = NULL;
+        for(i = 0; i < SYS_METRICS_MAX_THREADS; i++)
+        {
+            if(threads[i].tid == tid) { thr = &threads[i]; break; }
+            if(threads[i].tid == 0 && free_thr == NULL) free_thr = &threads[i];
+        }
+
+        // New thread, open its stat file once
+        int is_new = thr == NULL;
+        if(is_new)
+        {
+            if(free_thr == NULL)
+                continue;
+            snprintf(buff, sizeof(buff), "/proc/self/task/%d/stat", tid);
+            int fd = open(buff, O_RDONLY);
+            if(fd < 0)
+                continue;
+            thr = free_thr;
+            thr->tid = tid;
+            thr->fd = fd;
+            thr->ticks = 0;
+            thr->cpu = 0;
+        }
+
+        unsigned long ticks;
+        if(sys_metrics_pread(thr->fd, buff, sizeof(buff)) < 0 ||
+           sys_metrics_parse_stat(buff, &ticks, NULL) != 0)
+            continue;
+
+        if(!is_new && elapsed > 0)
+            thr->cpu = (float)(100.0 * (double)(ticks - thr->ticks) / (elapsed * (double)clk_tck));
+        thr->ticks = ticks;
+        thr->seen = 1;
+    }
+
+    // Release threads that finished
+    for(i = 0; i < SYS_METRICS_MAX_THREADS; i++)
+    {
+        if(threads[i].tid != 0 && !threads[i].seen)
+        {
+            close(threads[i].fd);
+            memset(&threads[i], 0, sizeof(sys_thread_t));
+        }
+    }
+}
+#endif
+
+int sys_metrics_open(void)
+{
+#ifdef LINUX
+    if(fd_stat >= 0)
+        return 0;
+
+    clk_tck = sysconf(_SC_CLK_TCK);
+    memset(threads, 0, sizeof(threads));
+
+    fd_thermal = open(SYS_METRICS_THERMAL_FILE, O_RDONLY);
+    fd_stat = open("/proc/stat", O_RDONLY);
+    fd_meminfo = open("/proc/meminfo", O_RDONLY);
+    fd_loadavg = open("/proc/loadavg", O_RDONLY);
+    fd_self_stat = open("/proc/self/stat", O_RDONLY);
+    fd_disk = open(SYS_METRICS_DISK_PATH, O_RDONLY | O_DIRECTORY);
+    dir_tasks = opendir("/proc/self/task");
+
+    if(fd_thermal < 0)
+        LOGW(tag, "Unable to open %s", SYS_METRICS_THERMAL_FILE);
+    if(fd_stat < 0 || fd_meminfo < 0 || fd_self_stat < 0)
+    {
+        LOGE(tag, "Unable to open /proc files");
+        sys_metrics_close();
+        return -1;
+    }
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+void sys_metrics_close(void)
+{
+#ifdef LINUX
+    int i;
+    int *fds[] = {&fd_thermal, &fd_stat, &fd_meminfo, &fd_loadavg, &fd_self_stat, &fd_disk};
+    for(i = 0; i < (int)(sizeof(fds)/sizeof(fds[0])); i++)
+    {
+        if(*fds[i] >= 0) close(*fds[i]);
+        *fds[i] = -1;
+    }
+
+    for(i = 0; i < SYS_METRICS_MAX_THREADS; i++)
+    {
+        if(threads[i].tid != 0) close(threads[i].fd);
+        memset(&threads[i], 0, sizeof(sys_thread_t));
+    }
+
+    if(dir_tasks != NULL) closedir(dir_tasks);
+    dir_tasks = NULL;
+    last_cpu_total = 0;
+    last_time = 0;
+#endif
+}
+
+int sys_metrics_read_temp(float *temp)
+{
+#ifdef LINUX
+    char buff[32];
+    if(sys_metrics_open() != 0 || sys_metrics_pread(fd_thermal, buff, sizeof(buff)) < 0)
+        return -1;
+    *temp = (float)atoi(buff) / 1000.0f;
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+int sys_metrics_sample(host_data_t *data)
+{
+#ifdef LINUX
+    char buff[512];
+    char *p;
+    int i, j;
+
+    if(sys_metrics_open() != 0)
+        return -1;
+
+    double now = sys_metrics_now();
+    double elapsed = last_time > 0 ? now - last_time : 0;
+    last_time = now;
+
+    /* Temperature */
+    float temp;
+    data->obc_temp_1 = sys_metrics_read_temp(&temp) == 0 ? temp : -1;
+
+    /* System CPU usage (first line of /proc/stat) */
+    unsigned long long user, nice, sys, idle, iowait, irq, softirq, steal;
+    data->cpu_load = 0;
+    if(sys_metrics_pread(fd_stat, buff, sizeof(buff)) < 0 ||
+       sscanf(buff, "cpu %llu %llu %llu %llu %llu %llu %llu %llu",
+              &user, &nice, &sys, &idle, &iowait, &irq, &softirq, &steal) != 8)
+    {
+        LOGE(tag, "Error reading /proc/stat");
+        return -1;
+    }
+    unsigned long long total = user + nice + sys + idle + iowait + irq + softirq + steal;
+    unsigned long long busy = total - idle - iowait;
+    if(last_cpu_total > 0 && total > last_cpu_total)
+        data->cpu_load = (float)(100.0 * (double)(busy - last_cpu_busy) / (double)(total - last_cpu_total));
+    last_cpu_busy = busy;
+    last_cpu_total = total;
+
+    /* Load average */
+    float load_avg_1 = 0;
+    if(sys_metrics_pread(fd_loadavg, buff, sizeof(buff)) > 0)
+        sscanf(buff, "%f", &load_avg_1);
+    data->load_avg_1 = load_avg_1;
+
+    /* Memory */
+    unsigned int mem_total = 0, mem_avail = 0;
+    if(sys_metrics_pread(fd_meminfo, buff, sizeof(buff)) > 0)
+    {
+        if((p = strstr(buff, "MemTotal:")) != NULL)
+            sscanf(p, "MemTotal: %u", &mem_total);
+        if((p = strstr(buff, "MemAvailable:")) != NULL)
+            sscanf(p, "MemAvailable: %u", &mem_avail);
+    }
+    data->mem_total = mem_total;
+    data->mem_avail = mem_avail;
+
+    /* Disk */
+    struct statvfs vfs;
+    data->disk_total = 0;
+    data->disk_free = 0;
+    if(fd_disk >= 0 && fstatvfs(fd_disk, &vfs) == 0)
+    {
+        data->disk_total = (uint32_t)((unsigned long long)vfs.f_blocks * vfs.f_frsize / 1024);
+        data->disk_free = (uint32_t)((unsigned long long)vfs.f_bavail * vfs.f_frsize / 1024);
+    }
+
+    /* Process CPU usage */
+    unsigned long proc_ticks = 0;
+    long nthreads = 0;
+    data->proc_cpu = 0;
+    if(sys_metrics_pread(fd_self_stat, buff, sizeof(buff)) > 0 &&
+       sys_metrics_parse_stat(buff, &proc_ticks, &nthreads) == 0)
+    {
+        if(elapsed > 0)
+            data->proc_cpu = (float)(100.0 * (double)(proc_ticks - last_proc_ticks) / (elapsed * (double)clk_tck));
+        last_proc_ticks = proc_ticks;
+    }
+    data->nthreads = (uint32_t)nthreads;
+
+    /* Per-thread CPU usage, report the busiest threads */
+    sys_metrics_update_threads(elapsed);
+    uint32_t top_tid[SYS_METRICS_TOP_THREADS] = {0};
+    float top_cpu[SYS_METRICS_TOP_THREADS] = {0};
+    for(i = 0; i < SYS_METRICS_MAX_THREADS; i++)
+    {
+        if(threads[i].tid == 0)
+            continue;
+        for(j = 0; j < SYS_METRICS_TOP_THREADS; j++)
+        {
+            if(top_tid[j] == 0 || threads[i].cpu > top_cpu[j])
+            {
+                // Shift down and insert
+                int k;
+                for(k = SYS_METRICS_TOP_THREADS - 1; k > j; k--)
+                {
+                    top_tid[k] = top_tid[k-1];
+                    top_cpu[k] = top_cpu[k-1];
+                }
+                top_tid[j] = (uint32_t)threads[i].tid;
+                top_cpu[j] = threads[i].cpu;
+                break;
+            }
+        }
+    }
+    data->thr1_tid = top_tid[0]; data->thr1_cpu = top_cpu[0];
+    data->thr2_tid = top_tid[1]; data->thr2_cpu = top_cpu[1];
+    data->thr3_tid = top_tid[2]; data->thr3_cpu = top_cpu[2];
+
+    return 0;
+#else
+    return -1;
+#endif
+}
@@ -60,6 +60,14 @@ void taskHousekeeping(void *param)
             cmd_send(cmd_update);
         }
 
+        /* Host metrics, period set by dat_obc_host_period */
+        int host_period = dat_get_system_var(dat_obc_host_period);
+        if(host_period > 0 && (elapsed_sec % host_period) == 0)
+        {
+            cmd_t *cmd_host = cmd_get_str("obc_get_host");
+            cmd_send(cmd_host);
+        }
+
         /* 1 hours actions */
         if((elapsed_sec % _1hour_check) == 0)
         {